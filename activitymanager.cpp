@@ -0,0 +1,113 @@
+/**
+ * @file activitymanager.cpp
+ * @brief Definitions for activitymanager.
+ * @details Implements logic declared in the corresponding header for activitymanager.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "activitymanager.h"
+#include <QEvent>
+#include <utility>
+
+ActivityManager &ActivityManager::instance()
+{
+    static ActivityManager manager;
+    return manager;
+}
+
+void ActivityManager::watch(QWidget *view)
+{
+    if (!view)
+        return;
+
+    views.removeIf([](const Watched &w) { return w.view.isNull(); });
+    for (const Watched &w : std::as_const(views)) {
+        if (w.view == view)
+            return;
+    }
+
+    Watched entry;
+    entry.view = view;
+    entry.window = view->window();
+    entry.active = isActive(view);
+    views.append(entry);
+
+    view->installEventFilter(this);
+    if (entry.window != view)
+        entry.window->installEventFilter(this);
+}
+
+bool ActivityManager::isActive(const QWidget *view) const
+{
+    if (!view)
+        return false;
+    const QWidget *top = view->window();
+    if (top->isMinimized())
+        return false;
+    if (view->isVisible())
+        return true;
+
+    // Widgets start out hidden until their window is shown, so only an
+    // explicit hide() counts: a hidden tab, or a window closed to the tray.
+    // Views of a window that was never shown (headless use) stay live.
+    for (const QWidget *w = view; w; w = w->parentWidget()) {
+        if (w->isHidden() && w->testAttribute(Qt::WA_WState_ExplicitShowHide))
+            return false;
+        if (w == top)
+            break;
+    }
+    return true;
+}
+
+int ActivityManager::activeViewCount() const
+{
+    int count = 0;
+    for (const Watched &w : views) {
+        if (w.view && isActive(w.view))
+            ++count;
+    }
+    return count;
+}
+
+bool ActivityManager::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+    case QEvent::ParentChange:
+        for (int i = 0; i < views.size(); ++i) {
+            if (views[i].view == watched || views[i].window == watched)
+                update(i);
+        }
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void ActivityManager::update(int index)
+{
+    QWidget *view = views[index].view;
+    if (!view)
+        return;
+
+    QWidget *top = view->window();
+    if (views[index].window != top) {
+        views[index].window = top;
+        if (top != view)
+            top->installEventFilter(this);
+    }
+
+    const bool active = isActive(view);
+    const bool changed = views[index].active != active;
+    views[index].active = active;
+
+    emit visibilityChanged(view);
+    if (changed)
+        emit activeChanged(view, active);
+}
@@ -0,0 +1,135 @@
+/**
+ * @file activitymanager.h
+ * @brief Declarations for activitymanager.
+ * @details Defines the central tracker that tells views whether they are on screen and worth refreshing.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef ACTIVITYMANAGER_H
+#define ACTIVITYMANAGER_H
+
+#include <QObject>
+#include <QList>
+#include <QPointer>
+#include <QWidget>
+
+/**
+ * @brief ActivityManager Manager that tracks view visibility.
+ * @details Views register with watch(). The manager filters show, hide,
+ * window state and parent change events of each view and its top-level
+ * window, and reports when a view becomes active or inactive. A view is
+ * inactive while it is a hidden tab, while its window is minimized, or while
+ * its window has been hidden (e.g. closed to the tray). Views whose window
+ * has never been shown stay active so headless use keeps working. Models are
+ * not affected; only view refreshes should be paused.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+class ActivityManager : public QObject
+{
+    Q_OBJECT
+
+public:
+/**
+ * @brief Instance.
+ * @details Returns the process-wide activity manager.
+ * @return Activity manager instance.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static ActivityManager &instance();
+
+/**
+ * @brief Watch a view.
+ * @details Starts tracking the view; calling it again for the same view has no effect.
+ * @param view View to track.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void watch(QWidget *view);
+/**
+ * @brief Is active.
+ * @details Returns whether the view should refresh.
+ * @param view View to check.
+ * @return False for hidden tabs, minimized windows and windows hidden to the tray.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isActive(const QWidget *view) const;
+/**
+ * @brief Get active view count.
+ * @details Counts the watched views that are currently active.
+ * @return Number of active views.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int activeViewCount() const;
+
+    ActivityManager(const ActivityManager&) = delete;
+    ActivityManager& operator=(const ActivityManager&) = delete;
+
+signals:
+/**
+ * @brief Emitted when a view becomes active or inactive.
+ * @details Signal emitted when the associated state changes.
+ * @param view Watched view.
+ * @param active New state; views should catch up when it becomes true.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void activeChanged(QWidget *view, bool active);
+/**
+ * @brief Emitted when the visibility of a view may have changed.
+ * @details Signal emitted for every show, hide, window state or parent change affecting the view.
+ * @param view Watched view.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void visibilityChanged(QWidget *view);
+
+protected:
+/**
+ * @brief Event filter.
+ * @details Re-evaluates the views affected by the event.
+ * @param watched Watched object.
+ * @param event Event value.
+ * @return Always false; events are passed on.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+/**
+ * @brief Create ActivityManager instance.
+ * @details Initializes instance state.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ActivityManager() = default;
+
+    /**
+     * @brief Watched Tracked view and the window it currently lives in.
+     */
+    struct Watched {
+        QPointer<QWidget> view; /**< Tracked view. */
+        QPointer<QWidget> window; /**< Top-level window of the view. */
+        bool active = false; /**< State last reported through activeChanged. */
+    };
+
+/**
+ * @brief Update entry.
+ * @details Follows reparenting, then reports visibility and activity changes.
+ * @param index Index of the entry in views.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void update(int index);
+
+    QList<Watched> views; /**< Tracked views. */
+};
+
+#endif // ACTIVITYMANAGER_H
@@ -18,6 +18,8 @@
 namespace {
 QString repeatTextFor(const AlarmData &alarm)
 {
+    if (alarm.rule.isValid())
+        return alarm.rule.rruleText();
     const RepeatMode repeat = alarm.repeatMode;
     if (repeat == RepeatMode::SpecificDays)
         return alarm.days.isEmpty() ? "Once" : alarm.days.join(", ");
@@ -10,26 +10,65 @@
 
 #include "alarmmanager.h"
 #include "jsonalarmstorage.h"
+#include "binaryalarmstorage.h"
+#include "icsalarmstorage.h"
+#include "../storage/asyncstorage.h"
+#include <QFile>
 #include <QTimer>
-#include <QMap>
+#include <QtAlgorithms>
+#include <algorithm>
 #include <utility>
 
+namespace {
+// Upper bound for one sleep; a long single shot would miss wall-clock jumps and resume from suspend.
+constexpr qint64 kMaxWakeIntervalMs = 60 * 1000;
+}
+
 AlarmManager::AlarmManager(QObject *parent, std::unique_ptr<IAlarmStorage> storage)
     : QObject(parent)
-    , storage(storage ? std::move(storage) : std::make_unique<JsonAlarmStorage>())
+    , storage(storage ? std::move(storage) : std::make_unique<AsyncStorage<IAlarmStorage, QList<AlarmData>>>(std::make_unique<BinaryAlarmStorage>()))
 {
+    checkTimer.setSingleShot(true);
+    checkTimer.setTimerType(Qt::PreciseTimer);
     connect(&checkTimer, &QTimer::timeout, this, &AlarmManager::checkAlarms);
-    checkTimer.start(1000);
 }
 
 void AlarmManager::addAlarm(const AlarmData &data)
 {
     AlarmData a = data;
+    compileRecurrence(a);
     QDateTime now = QDateTime::currentDateTime();
     if (!a.nextTrigger.isValid())
         a.nextTrigger = computeNextTrigger(a, now);
 
+    a.id = nextId++;
     alarms.append(a);
+    idSlots.insert(a.id, alarms.size() - 1);
+    if (!nameSlots.contains(a.name))
+        nameSlots.insert(a.name, alarms.size() - 1);
+    scheduleAlarm(alarms.size() - 1);
+    emit alarmsUpdated();
+}
+
+void AlarmManager::addAlarms(const QList<AlarmData> &batch)
+{
+    if (batch.isEmpty())
+        return;
+
+    alarms.reserve(alarms.size() + batch.size());
+    const QDateTime now = QDateTime::currentDateTime();
+    for (const AlarmData &data : batch) {
+        AlarmData a = data;
+        compileRecurrence(a);
+        if (!a.nextTrigger.isValid())
+            a.nextTrigger = computeNextTrigger(a, now);
+        a.id = nextId++;
+        alarms.append(a);
+        idSlots.insert(a.id, alarms.size() - 1);
+        if (!nameSlots.contains(a.name))
+            nameSlots.insert(a.name, alarms.size() - 1);
+    }
+    rebuildSchedule();
     emit alarmsUpdated();
 }
 
@@ -37,6 +76,8 @@ void AlarmManager::removeAlarm(int index)
 {
     if (index >= 0 && index < alarms.size()) {
         alarms.removeAt(index);
+        reindex();
+        rebuildSchedule();
         emit alarmsUpdated();
     }
 }
@@ -46,16 +87,68 @@ void AlarmManager::toggleAlarm(int index)
     if (index < 0 || index >= alarms.size()) return;
     alarms[index].enabled = !alarms[index].enabled;
     if (alarms[index].enabled) {
-        alarms[index].nextTrigger = computeInitialTrigger(alarms[index].time);
+        alarms[index].nextTrigger = QDateTime();
+        scheduleAlarm(index);
+    } else {
+        armCheckTimer();
     }
     emit alarmsUpdated();
 }
 
+bool AlarmManager::removeAlarmById(quint64 id)
+{
+    const int index = indexOfId(id);
+    if (index < 0)
+        return false;
+    removeAlarm(index);
+    return true;
+}
+
+bool AlarmManager::toggleAlarmById(quint64 id)
+{
+    const int index = indexOfId(id);
+    if (index < 0)
+        return false;
+    toggleAlarm(index);
+    return true;
+}
+
+int AlarmManager::indexOfId(quint64 id) const
+{
+    return idSlots.value(id, -1);
+}
+
 QList<AlarmData> AlarmManager::getAlarms() const
 {
     return alarms;
 }
 
+const QList<AlarmData> &AlarmManager::alarmList() const
+{
+    return alarms;
+}
+
+int AlarmManager::alarmCount() const
+{
+    return alarms.size();
+}
+
+const AlarmData &AlarmManager::alarmAt(int index) const
+{
+    return alarms[index];
+}
+
+int AlarmManager::countEnabled() const
+{
+    return int(std::count_if(alarms.cbegin(), alarms.cend(),
+                             [](const AlarmData &a) { return a.enabled; }));
+}
+
+int AlarmManager::findByName(const QString &name) const
+{
+    return nameSlots.value(name, -1);
+}
+
 void AlarmManager::snoozeAlarm(const AlarmData &alarm, int minutes)
 {
     const int idx = findAlarmIndex(alarm);
@@ -63,11 +156,15 @@ void AlarmManager::snoozeAlarm(const AlarmData &alarm, int minutes)
         return;
     alarms[idx].nextTrigger = QDateTime::currentDateTime().addSecs(minutes * 60);
     alarms[idx].enabled = true;
+    scheduleAlarm(idx);
     emit alarmsUpdated();
 }
 
 int AlarmManager::findAlarmIndex(const AlarmData &alarm) const
 {
+    if (alarm.id != 0)
+        return indexOfId(alarm.id);
+
     for (int i = 0; i < alarms.size(); ++i) {
         const auto &a = alarms[i];
         if (a.name == alarm.name &&
@@ -80,6 +177,25 @@ int AlarmManager::findAlarmIndex(const AlarmData &alarm) const
     return -1;
 }
 
+void AlarmManager::reindex()
+{
+    for (const AlarmData &a : alarms)
+        nextId = qMax(nextId, a.id + 1);
+
+    idSlots.clear();
+    nameSlots.clear();
+    idSlots.reserve(alarms.size());
+    nameSlots.reserve(alarms.size());
+    for (int i = 0; i < alarms.size(); ++i) {
+        AlarmData &a = alarms[i];
+        if (a.id == 0 || idSlots.contains(a.id))
+            a.id = nextId++;
+        idSlots.insert(a.id, i);
+        if (!nameSlots.contains(a.name))
+            nameSlots.insert(a.name, i);
+    }
+}
+
 bool AlarmManager::save()
 {
     if (!storage)
@@ -87,6 +203,67 @@ bool AlarmManager::save()
     return storage->save(alarms);
 }
 
+int AlarmManager::importFromIcs(const QString &path, int *skipped)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return -1;
+
+    QList<AlarmData> imported;
+    if (!IcsAlarmStorage::read(f, [&imported](const AlarmData &a) { imported.append(a); }, skipped))
+        return -1;
+
+    // Events already known by UID replace their alarm (keeping its id), so
+    // importing the same calendar twice does not duplicate anything.
+    QHash<QString, int> uidSlots;
+    uidSlots.reserve(alarms.size());
+    for (int i = 0; i < alarms.size(); ++i)
+        uidSlots.insert(IcsAlarmStorage::uidOf(alarms[i]), i);
+
+    const QDateTime now = QDateTime::currentDateTime();
+
+    QList<AlarmData> added;
+    QHash<QString, int> addedSlots;
+    int updated = 0;
+    for (AlarmData &a : imported) {
+        int index = a.uid.isEmpty() ? -1 : uidSlots.value(a.uid, -1);
+        // A UID built from an id only names this alarm if the file came from
+        // this installation; another one may have used the same id.
+        if (index >= 0 && alarms[index].uid.isEmpty() && alarms[index].name != a.name)
+            index = -1;
+        if (index >= 0) {
+            a.id = alarms[index].id;
+            compileRecurrence(a);
+            if (!a.nextTrigger.isValid())
+                a.nextTrigger = computeNextTrigger(a, now);
+            alarms[index] = a;
+            ++updated;
+        } else if (!a.uid.isEmpty() && addedSlots.contains(a.uid)) {
+            added[addedSlots.value(a.uid)] = a;
+        } else {
+            if (!a.uid.isEmpty())
+                addedSlots.insert(a.uid, added.size());
+            added.append(a);
+        }
+    }
+
+    if (updated > 0)
+        reindex();
+    if (!added.isEmpty()) {
+        addAlarms(added);
+    } else if (updated > 0) {
+        rebuildSchedule();
+        emit alarmsUpdated();
+    }
+    return updated + int(added.size());
+}
+
+bool AlarmManager::exportToIcs(const QString &path) const
+{
+    IcsAlarmStorage storage(path);
+    return storage.save(alarms);
+}
+
 bool AlarmManager::load()
 {
     if (!storage)
@@ -96,9 +273,11 @@ bool AlarmManager::load()
         return false;
     alarms = loaded;
     for (auto &a : alarms) {
-        if (!a.nextTrigger.isValid())
-            a.nextTrigger = computeInitialTrigger(a.time);
+        compileRecurrence(a);
+        ensureNextTrigger(a);
     }
+    reindex();
+    rebuildSchedule();
     emit alarmsUpdated();
     return true;
 }
@@ -117,8 +296,11 @@ QDateTime AlarmManager::computeInitialTrigger(const QTime &t)
     return trigger;
 }
 
-QDateTime AlarmManager::computeNextTrigger(const AlarmData &a, const QDateTime &after)
+QDateTime AlarmManager::computeNextTrigger(AlarmData &a, const QDateTime &after)
 {
+    if (a.rule.isValid())
+        return a.rule.next(after, a.ruleCursor);
+
     QDate d = after.date();
     QTime t = a.time;
     QDateTime candidate(d, t);
@@ -135,46 +317,37 @@ QDateTime AlarmManager::computeNextTrigger(const AlarmData &a, const QDateTime &
 
 QDateTime AlarmManager::computeWeeklyTrigger(const AlarmData &a, const QDate &startDate, const QTime &t)
 {
-    QDate d = startDate;
-    const RepeatMode repeat = a.repeatMode;
-    static QMap<QString, int> map = {
-        {"Mon", 1}, {"Tue", 2}, {"Wed", 3}, {"Thu", 4},
-        {"Fri", 5}, {"Sat", 6}, {"Sun", 7}
-    };
-
-    for (int i = 0; i < 7; ++i) {
-        int dow = d.dayOfWeek();
-
-        bool ok = false;
-        switch (repeat) {
-        case RepeatMode::EveryDay:
-            ok = true;
-            break;
-        case RepeatMode::Weekdays:
-            ok = (dow <= 5);
-            break;
-        case RepeatMode::Weekends:
-            ok = (dow >= 6);
-            break;
-        case RepeatMode::SpecificDays:
-            ok = a.days.contains(map.key(dow));
-            break;
-        default:
-            ok = false;
-            break;
-        }
-
-        if (ok)
-            return QDateTime(d, t);
+    const quint32 mask = a.weekdayMask & kEveryDayMask;
+    if (mask == 0 || !startDate.isValid())
+        return QDateTime();
+
+    // Rotate so bit 0 is startDate's weekday; the lowest set bit is then the day offset.
+    const int start = startDate.dayOfWeek() - 1;
+    const quint32 rotated = ((mask >> start) | (mask << (7 - start))) & kEveryDayMask;
+    return QDateTime(startDate.addDays(qCountTrailingZeroBits(rotated)), t);
+}
 
-        d = d.addDays(1);
+void AlarmManager::compileRecurrence(AlarmData &a)
+{
+    a.rule = a.recurrence.isEmpty() ? RecurrenceRule() : RecurrenceRule::parse(a.recurrence);
+    if (a.rule.isValid() && !a.rule.start().isValid()) {
+        a.rule.setStart(QDateTime(QDate::currentDate(), a.time.isValid() ? a.time : QTime(0, 0)));
+        a.recurrence = a.rule.toString();
     }
 
-    return QDateTime();
+    if (a.repeatMode == RepeatMode::SpecificDays && a.weekdayMask != 0) {
+        a.weekdayMask &= kEveryDayMask;
+        if (a.days.isEmpty())
+            a.days = daysFromWeekdayMask(a.weekdayMask);
+        return;
+    }
+    a.weekdayMask = weekdayMaskFor(a.repeatMode, a.days);
 }
 
 bool AlarmManager::isOneTime(const AlarmData &a)
 {
+    if (a.rule.isValid())
+        return false;
     return a.repeatMode == RepeatMode::Never || a.repeatMode == RepeatMode::Once;
 }
 
@@ -185,36 +358,108 @@ bool AlarmManager::isDue(const AlarmData &a, const QDateTime &now)
 
 void AlarmManager::ensureNextTrigger(AlarmData &a)
 {
-    if (!a.nextTrigger.isValid())
-        a.nextTrigger = computeInitialTrigger(a.time);
+    if (a.nextTrigger.isValid())
+        return;
+    a.nextTrigger = a.rule.isValid() ? a.rule.next(QDateTime::currentDateTime(), a.ruleCursor)
+                                     : computeInitialTrigger(a.time);
 }
 
-void AlarmManager::handleTriggeredAlarm(AlarmData &a, const QDateTime &now)
+void AlarmManager::handleTriggeredAlarm(int index, const QDateTime &now)
 {
-    emit alarmTriggered(a);
+    // Reschedule before notifying: listeners may snooze or edit the alarm while handling the signal.
+    AlarmData &a = alarms[index];
+    const AlarmData fired = a;
 
     if (isOneTime(a)) {
         a.enabled = false;
     } else {
         a.nextTrigger = computeNextTrigger(a, now);
-        a.enabled = true;
+        // A rule with COUNT or UNTIL runs out; the alarm then stays off.
+        a.enabled = a.nextTrigger.isValid();
+        scheduleAlarm(index);
     }
 
+    emit alarmTriggered(fired);
     emit alarmsUpdated();
 }
 
 void AlarmManager::checkAlarms()
 {
     const QDateTime now = QDateTime::currentDateTime();
+    const qint64 nowMs = now.toMSecsSinceEpoch();
 
-    for (AlarmData &a : alarms) {
-        if (!a.enabled)
+    while (!deadlines.empty() && deadlines.front().atMs <= nowMs) {
+        const Deadline due = deadlines.front();
+        std::pop_heap(deadlines.begin(), deadlines.end(), &AlarmManager::laterDeadline);
+        deadlines.pop_back();
+        if (isStale(due))
             continue;
 
+        handleTriggeredAlarm(due.index, now);
+    }
+
+    armCheckTimer();
+}
+
+bool AlarmManager::laterDeadline(const Deadline &a, const Deadline &b)
+{
+    if (a.atMs != b.atMs)
+        return a.atMs > b.atMs;
+    return a.index > b.index;
+}
+
+bool AlarmManager::isStale(const Deadline &d) const
+{
+    if (d.index < 0 || d.index >= alarms.size())
+        return true;
+    const AlarmData &a = alarms[d.index];
+    return !a.enabled || !a.nextTrigger.isValid() || a.nextTrigger.toMSecsSinceEpoch() != d.atMs;
+}
+
+void AlarmManager::scheduleAlarm(int index)
+{
+    AlarmData &a = alarms[index];
+    if (a.enabled) {
+        ensureNextTrigger(a);
+        deadlines.push_back(Deadline{a.nextTrigger.toMSecsSinceEpoch(), index});
+        std::push_heap(deadlines.begin(), deadlines.end(), &AlarmManager::laterDeadline);
+    }
+    armCheckTimer();
+}
+
+void AlarmManager::rebuildSchedule()
+{
+    deadlines.clear();
+    for (int i = 0; i < alarms.size(); ++i) {
+        AlarmData &a = alarms[i];
+        if (!a.enabled)
+            continue;
         ensureNextTrigger(a);
-        if (isDue(a, now))
-            handleTriggeredAlarm(a, now);
+        deadlines.push_back(Deadline{a.nextTrigger.toMSecsSinceEpoch(), i});
     }
+    std::make_heap(deadlines.begin(), deadlines.end(), &AlarmManager::laterDeadline);
+    armCheckTimer();
+}
+
+void AlarmManager::armCheckTimer()
+{
+    if (deadlines.size() > size_t(2 * alarms.size() + 16)) {
+        rebuildSchedule();
+        return;
+    }
+
+    while (!deadlines.empty() && isStale(deadlines.front())) {
+        std::pop_heap(deadlines.begin(), deadlines.end(), &AlarmManager::laterDeadline);
+        deadlines.pop_back();
+    }
+
+    if (deadlines.empty()) {
+        checkTimer.stop();
+        return;
+    }
+
+    const qint64 waitMs = deadlines.front().atMs - QDateTime::currentMSecsSinceEpoch();
+    checkTimer.start(int(std::clamp<qint64>(waitMs, 0, kMaxWakeIntervalMs)));
 }
 
 void AlarmManager::saveToFile(const QString &path)
@@ -231,8 +476,10 @@ void AlarmManager::loadFromFile(const QString &path)
         return;
     alarms = loaded;
     for (auto &a : alarms) {
-        if (!a.nextTrigger.isValid())
-            a.nextTrigger = computeInitialTrigger(a.time);
+        compileRecurrence(a);
+        ensureNextTrigger(a);
     }
+    reindex();
+    rebuildSchedule();
     emit alarmsUpdated();
 }
@@ -16,9 +16,12 @@
 #include <QTime>
 #include <QDateTime>
 #include <QList>
+#include <QHash>
 #include <memory>
+#include <vector>
 #include "ialarmstorage.h"
 #include "alarmrepeatmode.h"
+#include "recurrencerule.h"
 
 /**
  * @brief AlarmData alarm component.
@@ -36,6 +39,12 @@ struct AlarmData {
     bool snooze; /**< Internal state value. */
     bool enabled; /**< Current state flag. */
     QDateTime nextTrigger; /**< Internal state value. */
+    quint64 id = 0; /**< Stable identifier assigned by AlarmManager and persisted with the alarm; 0 until added. */
+    quint8 weekdayMask = 0; /**< Days the alarm repeats on, bit (dayOfWeek - 1); compiled from repeatMode and days. */
+    QString recurrence; /**< iCalendar RRULE text, optionally with a DTSTART line; when valid it overrides repeatMode. */
+    RecurrenceRule rule; /**< Compiled form of recurrence; filled by AlarmManager. */
+    RecurrenceRule::Cursor ruleCursor; /**< Last occurrence taken from rule and its COUNT position; persisted so COUNT resumes there. */
+    QString uid; /**< iCalendar UID of the imported event; empty for alarms created here. */
 };
 
 /**
@@ -67,6 +76,14 @@ public:
  * @sa SmartClock
  */
     void addAlarm(const AlarmData &data);
+/**
+ * @brief Add alarms.
+ * @details Appends a batch, rebuilds the schedule once and emits a single alarmsUpdated.
+ * @param batch Alarms to add.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void addAlarms(const QList<AlarmData> &batch);
 /**
  * @brief Remove alarm.
  * @details Modifies the associated collection and notifies listeners.
@@ -83,6 +100,33 @@ public:
  * @sa SmartClock
  */
     void toggleAlarm(int index);
+/**
+ * @brief Remove alarm by id.
+ * @details Resolves the slot through the id index and removes the alarm.
+ * @param id Alarm id.
+ * @return True if an alarm with this id existed.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool removeAlarmById(quint64 id);
+/**
+ * @brief Toggle alarm by id.
+ * @details Resolves the slot through the id index and toggles the alarm.
+ * @param id Alarm id.
+ * @return True if an alarm with this id existed.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool toggleAlarmById(quint64 id);
+/**
+ * @brief Index of id.
+ * @details Maps a stable alarm id to its current slot through a hash index.
+ * @param id Alarm id.
+ * @return Zero-based index, or -1 if no alarm has this id.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int indexOfId(quint64 id) const;
 /**
  * @brief Get alarms.
  * @details Returns the current value derived from internal state.
@@ -91,6 +135,48 @@ public:
  * @sa SmartClock
  */
     QList<AlarmData> getAlarms() const;
+/**
+ * @brief Alarm list.
+ * @details Returns the stored alarms without copying.
+ * @return Const reference valid until the next modification.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    const QList<AlarmData> &alarmList() const;
+/**
+ * @brief Alarm count.
+ * @details Returns the number of alarms.
+ * @return Count value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int alarmCount() const;
+/**
+ * @brief Alarm at.
+ * @details Returns one stored alarm without copying.
+ * @param index Zero-based index; must be valid.
+ * @return Const reference valid until the next modification.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    const AlarmData &alarmAt(int index) const;
+/**
+ * @brief Count enabled.
+ * @details Counts enabled alarms without allocating.
+ * @return Count value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int countEnabled() const;
+/**
+ * @brief Find by name.
+ * @details Returns the index of the first alarm with the given name through a hash index.
+ * @param name Name string.
+ * @return Zero-based index, or -1 if none matches.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int findByName(const QString &name) const;
 /**
  * @brief Save to file.
  * @details Writes current state to persistent storage.
@@ -109,6 +195,26 @@ public:
  * @sa SmartClock
  */
     void loadFromFile(const QString &path);
+/**
+ * @brief Import from iCalendar file.
+ * @details Streams the events of an .ics file and applies them in one batch; an event whose UID
+ * matches an existing alarm replaces that alarm instead of adding a duplicate.
+ * @param path Filesystem path.
+ * @param skipped Receives the number of events that could not be imported. May be null.
+ * @return Number of added or updated alarms, or -1 if the file cannot be read.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int importFromIcs(const QString &path, int *skipped = nullptr);
+/**
+ * @brief Export to iCalendar file.
+ * @details Writes every alarm as a VEVENT with a VALARM.
+ * @param path Filesystem path.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool exportToIcs(const QString &path) const;
 /**
  * @brief Save operation.
  * @details Writes current state to persistent storage.
@@ -163,7 +269,7 @@ signals:
 private slots:
 /**
  * @brief Check alarms.
- * @details Performs the operation and updates state as needed.
+ * @details Fires every alarm whose deadline has passed, then re-arms the wake-up timer.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
@@ -182,16 +288,16 @@ private:
 /**
  * @brief Compute next trigger.
  * @details Performs the operation and updates state as needed.
- * @param a a value.
+ * @param a a value; its rule cursor advances when a recurrence rule is used.
  * @param after after value.
  * @return Return value of the operation.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    static QDateTime computeNextTrigger(const AlarmData &a, const QDateTime &after);
+    static QDateTime computeNextTrigger(AlarmData &a, const QDateTime &after);
 /**
  * @brief Compute weekly trigger.
- * @details Performs the operation and updates state as needed.
+ * @details Finds the first day from startDate on whose bit is set in the alarm's weekday mask, using a rotate and a bit scan.
  * @param a a value.
  * @param startDate startDate value.
  * @param t t value.
@@ -221,34 +327,107 @@ private:
     static bool isDue(const AlarmData &a, const QDateTime &now);
 /**
  * @brief Ensure next trigger.
- * @details Performs the operation and updates state as needed.
+ * @details Fills a missing trigger from the compiled rule, or from the alarm time when there is none.
  * @param a a value.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
     static void ensureNextTrigger(AlarmData &a);
+/**
+ * @brief Compile recurrence.
+ * @details Derives weekdayMask from repeatMode and days; a SpecificDays alarm that already has a mask keeps it and gets its days filled in for display.
+ * Also parses recurrence into rule; a rule without DTSTART is anchored at today's date and the alarm time, and recurrence is rewritten to keep that anchor.
+ * @param a Alarm to update.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static void compileRecurrence(AlarmData &a);
 /**
  * @brief Handle triggered alarm.
- * @details Performs the operation and updates state as needed.
- * @param a a value.
+ * @details Disables or reschedules the alarm, then notifies listeners.
+ * @param index Zero-based index.
  * @param now now value.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    void handleTriggeredAlarm(AlarmData &a, const QDateTime &now);
+    void handleTriggeredAlarm(int index, const QDateTime &now);
 /**
  * @brief Find alarm index.
- * @details Performs the operation and updates state as needed.
+ * @details Looks the alarm up by id in O(1); alarms without an id fall back to matching name, time, repeat mode and days.
  * @param alarm alarm value.
- * @return Integer value.
+ * @return Zero-based index, or -1 if not found.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
     int findAlarmIndex(const AlarmData &alarm) const;
+/**
+ * @brief Reindex.
+ * @details Assigns ids to alarms that have none and rebuilds the id and name indexes after slots shift.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void reindex();
+
+/**
+ * @brief Deadline heap entry.
+ * @details Next trigger of an enabled alarm and its slot in the alarms list.
+ * @note Entries are invalidated lazily; see isStale().
+ * @sa SmartClock
+ */
+    struct Deadline {
+        qint64 atMs; /**< Trigger time (milliseconds since epoch). */
+        int index; /**< Zero-based index into alarms. */
+    };
+
+/**
+ * @brief Later deadline.
+ * @details Heap comparator that keeps the earliest trigger on top.
+ * @param a a value.
+ * @param b b value.
+ * @return True if a triggers after b.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static bool laterDeadline(const Deadline &a, const Deadline &b);
+/**
+ * @brief Check whether stale.
+ * @details A heap entry is stale once its alarm was disabled, removed or rescheduled.
+ * @param d d value.
+ * @return True if the condition holds; false otherwise.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isStale(const Deadline &d) const;
+/**
+ * @brief Schedule alarm.
+ * @details Pushes the alarm's next trigger onto the heap and re-arms the wake-up.
+ * @param index Zero-based index.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void scheduleAlarm(int index);
+/**
+ * @brief Rebuild schedule.
+ * @details Recreates the deadline heap from enabled alarms after indices shift.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void rebuildSchedule();
+/**
+ * @brief Arm check timer.
+ * @details Drops stale heap entries and arms a single shot for the earliest trigger.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void armCheckTimer();
 
     QList<AlarmData> alarms; /**< Elapsed time in milliseconds. */
-    QTimer checkTimer; /**< Timer-related state. */
+    QTimer checkTimer; /**< Single-shot wake-up for the earliest trigger. */
+    std::vector<Deadline> deadlines; /**< Min-heap of enabled alarm triggers. */
     std::unique_ptr<IAlarmStorage> storage; /**< Owned storage backend. */
+    quint64 nextId = 1; /**< Next id handed out to a new alarm. */
+    QHash<quint64, int> idSlots; /**< Alarm id to index in alarms. */
+    QHash<QString, int> nameSlots; /**< Alarm name to index of its first occurrence. */
 };
 
 #endif // ALARMMANAGER_H
@@ -12,6 +12,7 @@
 #define ALARMREPEATMODE_H
 
 #include <QString>
+#include <QStringList>
 
 /**
  * @brief RepeatMode type.
@@ -83,4 +84,100 @@ inline RepeatMode repeatModeFromString(const QString &text)
     return RepeatMode::Never;
 }
 
+/**
+ * @brief Weekday mask with every day set.
+ * @details Bit (dayOfWeek - 1) stands for one weekday, Monday being bit 0.
+ * @sa SmartClock
+ */
+constexpr quint8 kEveryDayMask = 0x7F;
+/**
+ * @brief Weekday mask for Monday to Friday.
+ * @sa SmartClock
+ */
+constexpr quint8 kWeekdaysMask = 0x1F;
+/**
+ * @brief Weekday mask for Saturday and Sunday.
+ * @sa SmartClock
+ */
+constexpr quint8 kWeekendsMask = 0x60;
+
+/**
+ * @brief Weekday short names.
+ * @details Names used in AlarmData::days, indexed by dayOfWeek - 1.
+ * @return List of values.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline const QStringList &weekdayNames()
+{
+    static const QStringList names = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+    return names;
+}
+
+/**
+ * @brief Convert day names to a weekday mask.
+ * @details Unknown names are ignored.
+ * @param days Short day names ("Mon" ... "Sun").
+ * @return 7-bit weekday mask.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline quint8 weekdayMaskFromDays(const QStringList &days)
+{
+    quint8 mask = 0;
+    const QStringList &names = weekdayNames();
+    for (const QString &day : days) {
+        const int i = names.indexOf(day.trimmed());
+        if (i >= 0)
+            mask |= quint8(1u << i);
+    }
+    return mask;
+}
+
+/**
+ * @brief Convert a weekday mask to day names.
+ * @details Lists the set days from Monday to Sunday.
+ * @param mask 7-bit weekday mask.
+ * @return List of values.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline QStringList daysFromWeekdayMask(quint8 mask)
+{
+    QStringList days;
+    const QStringList &names = weekdayNames();
+    for (int i = 0; i < 7; ++i) {
+        if (mask & (1u << i))
+            days << names[i];
+    }
+    return days;
+}
+
+/**
+ * @brief Weekday mask for a repeat rule.
+ * @details Compiles a repeat mode and its day list into the days it fires on; one-time modes yield 0.
+ * @param mode Repeat mode.
+ * @param days Short day names, used by SpecificDays only.
+ * @return 7-bit weekday mask.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline quint8 weekdayMaskFor(RepeatMode mode, const QStringList &days)
+{
+    switch (mode) {
+    case RepeatMode::EveryDay:
+        return kEveryDayMask;
+    case RepeatMode::Weekdays:
+        return kWeekdaysMask;
+    case RepeatMode::Weekends:
+        return kWeekendsMask;
+    case RepeatMode::SpecificDays:
+        return weekdayMaskFromDays(days);
+    case RepeatMode::Never:
+    case RepeatMode::Once:
+        break;
+    }
+    return 0;
+}
+
 #endif // ALARMREPEATMODE_H
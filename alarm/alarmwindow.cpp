@@ -13,6 +13,7 @@
 #include "alarmsettingsdialog.h"
 #include "alarmfactory.h"
 #include "soundalarmaction.h"
+#include <QFileDialog>
 #include <QMessageBox>
 #include <QListWidget>
 #include <algorithm>
@@ -34,6 +35,8 @@ AlarmWindow::AlarmWindow(QWidget *parent)
 
     connect(ui->btnAdd, &QPushButton::clicked, this, &AlarmWindow::onAddAlarm);
     connect(ui->btnRemove, &QPushButton::clicked, this, &AlarmWindow::onRemoveAlarm);
+    connect(ui->btnImport, &QPushButton::clicked, this, &AlarmWindow::onImportAlarms);
+    connect(ui->btnExport, &QPushButton::clicked, this, &AlarmWindow::onExportAlarms);
     // Model updates are handled by controller.
 
     auto delShortcut = new QShortcut(QKeySequence(Qt::Key_Delete), this);
@@ -84,6 +87,22 @@ void AlarmWindow::onRemoveAlarm()
     showDeleteInfo(sorted.size());
 }
 
+void AlarmWindow::onImportAlarms()
+{
+    const QString path = QFileDialog::getOpenFileName(this, "Import alarms", QString(),
+                                                      "iCalendar files (*.ics)");
+    if (!path.isEmpty())
+        emit importRequested(path);
+}
+
+void AlarmWindow::onExportAlarms()
+{
+    const QString path = QFileDialog::getSaveFileName(this, "Export alarms", "alarms.ics",
+                                                      "iCalendar files (*.ics)");
+    if (!path.isEmpty())
+        emit exportRequested(path);
+}
+
 QList<int> AlarmWindow::selectedAlarmRows() const
 {
     QList<int> rows;
@@ -112,6 +131,26 @@ void AlarmWindow::showDeleteInfo(int count)
                              QString("Removed %1 alarm(s).").arg(count));
 }
 
+void AlarmWindow::showImportResult(int imported, int skipped)
+{
+    if (imported < 0) {
+        QMessageBox::warning(this, "Import failed", "The file is not a readable iCalendar file.");
+        return;
+    }
+    QString text = QString("Imported %1 alarm(s).").arg(imported);
+    if (skipped > 0)
+        text += QString("\nSkipped %1 event(s) that cannot be used as alarms.").arg(skipped);
+    QMessageBox::information(this, "Imported", text);
+}
+
+void AlarmWindow::showExportResult(bool ok)
+{
+    if (ok)
+        QMessageBox::information(this, "Exported", "Alarms exported.");
+    else
+        QMessageBox::warning(this, "Export failed", "The calendar file could not be written.");
+}
+
 void AlarmWindow::setAlarms(const QList<AlarmData> &alarms)
 {
     ui->listAlarms->clear();
@@ -97,6 +97,22 @@ signals:
  * @sa SmartClock
  */
     void snoozeRequested(const AlarmData &alarm, int minutes);
+/**
+ * @brief Import requested.
+ * @details Emitted after the user picked a calendar file to import.
+ * @param path Filesystem path.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void importRequested(const QString &path);
+/**
+ * @brief Export requested.
+ * @details Emitted after the user picked a calendar file to export to.
+ * @param path Filesystem path.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void exportRequested(const QString &path);
 
 public slots:
 /**
@@ -115,6 +131,23 @@ public slots:
  * @sa SmartClock
  */
     void showAlarmTriggered(const AlarmData &alarm);
+/**
+ * @brief Show import result.
+ * @details Tells the user how many events were imported and skipped, or that the file could not be read.
+ * @param imported Number of added or updated alarms, or -1 on failure.
+ * @param skipped Number of events that could not be imported.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void showImportResult(int imported, int skipped);
+/**
+ * @brief Show export result.
+ * @details Tells the user whether the calendar file was written.
+ * @param ok True if the export succeeded.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void showExportResult(bool ok);
 
 private slots:
 /**
@@ -131,6 +164,20 @@ private slots:
  * @sa SmartClock
  */
     void onRemoveAlarm();
+/**
+ * @brief On import alarms.
+ * @details Asks for an .ics file and requests its import.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onImportAlarms();
+/**
+ * @brief On export alarms.
+ * @details Asks for a target .ics file and requests the export.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onExportAlarms();
 
 private:
 /**
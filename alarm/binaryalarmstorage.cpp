@@ -0,0 +1,128 @@
+/**
+ * @file binaryalarmstorage.cpp
+ * @brief Definitions for binaryalarmstorage.
+ * @details Implements logic declared in the corresponding header for binaryalarmstorage.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "binaryalarmstorage.h"
+#include "../storage/atomicfile.h"
+#include "../storage/binaryformat.h"
+#include "jsonalarmstorage.h"
+#include "alarmmanager.h"
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+
+BinaryAlarmStorage::BinaryAlarmStorage(const QString &path, const QString &legacyJsonPath)
+    : path(path)
+    , legacyJsonPath(legacyJsonPath)
+{
+}
+
+void BinaryAlarmStorage::setBackupEnabled(bool enabled)
+{
+    backupEnabled = enabled;
+}
+
+QString BinaryAlarmStorage::resolvePath() const
+{
+    if (!path.isEmpty())
+        return path;
+
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(base);
+    return base + "/alarms.bin";
+}
+
+QString BinaryAlarmStorage::resolveLegacyPath() const
+{
+    if (!legacyJsonPath.isEmpty())
+        return legacyJsonPath;
+    if (!path.isEmpty())
+        return QString();
+
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return base + "/alarms.json";
+}
+
+QByteArray BinaryAlarmStorage::encode(const QList<AlarmData> &in)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    BinaryFormat::writeHeader(out, kMagic, kVersion);
+    out << quint32(in.size());
+    for (const auto &a : in) {
+        out << a.name
+            << qint32(a.time.isValid() ? a.time.msecsSinceStartOfDay() : -1)
+            << qint32(a.repeatMode)
+            << a.days << a.soundPath << a.snooze << a.enabled;
+        BinaryFormat::writeTimestamp(out, a.nextTrigger);
+        out << a.weekdayMask << a.recurrence << a.id;
+        BinaryFormat::writeTimestamp(out, a.ruleCursor.occurrence);
+        out << qint32(a.ruleCursor.index) << a.uid;
+    }
+    return data;
+}
+
+bool BinaryAlarmStorage::decode(const QByteArray &data, QList<AlarmData> &out)
+{
+    QDataStream in(data);
+    quint16 version = 0;
+    if (!BinaryFormat::readHeader(in, kMagic, kVersion, version))
+        return false;
+
+    quint32 count = 0;
+    in >> count;
+    QList<AlarmData> alarms;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        AlarmData a;
+        qint32 timeMs = -1;
+        qint32 mode = 0;
+        in >> a.name >> timeMs >> mode >> a.days >> a.soundPath >> a.snooze >> a.enabled;
+        a.time = timeMs >= 0 ? QTime::fromMSecsSinceStartOfDay(timeMs) : QTime();
+        a.repeatMode = mode >= int(RepeatMode::Never) && mode <= int(RepeatMode::Once)
+                           ? RepeatMode(mode) : RepeatMode::Never;
+        a.nextTrigger = BinaryFormat::readTimestamp(in);
+        in >> a.weekdayMask >> a.recurrence >> a.id;
+        qint32 index = 0;
+        a.ruleCursor.occurrence = BinaryFormat::readTimestamp(in);
+        in >> index >> a.uid;
+        a.ruleCursor.index = index;
+        alarms.append(a);
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    out = alarms;
+    return true;
+}
+
+bool BinaryAlarmStorage::load(QList<AlarmData> &out)
+{
+    const QString p = resolvePath();
+    QFile f(p);
+    if (f.exists()) {
+        if (!f.open(QIODevice::ReadOnly))
+            return false;
+        return decode(f.readAll(), out);
+    }
+
+    const QString legacy = resolveLegacyPath();
+    if (legacy.isEmpty() || !QFile::exists(legacy))
+        return false;
+
+    JsonAlarmStorage json(legacy);
+    if (!json.load(out))
+        return false;
+    save(out);
+    return true;
+}
+
+bool BinaryAlarmStorage::save(const QList<AlarmData> &in)
+{
+    return AtomicFile::write(resolvePath(), encode(in), backupEnabled);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file binaryalarmstorage.h
+ * @brief Declarations for binaryalarmstorage.
+ * @details Defines types and functions related to binaryalarmstorage.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef BINARYALARMSTORAGE_H
+#define BINARYALARMSTORAGE_H
+
+#include "ialarmstorage.h"
+#include <QString>
+
+/**
+ * @brief BinaryAlarmStorage Storage interface or implementation for persistence.
+ * @details Stores alarms in a versioned QDataStream file with epoch-millisecond timestamps.
+ * @note Migrates from the JSON file written by JsonAlarmStorage when no binary file exists yet.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+class BinaryAlarmStorage : public IAlarmStorage
+{
+public:
+    static constexpr quint32 kMagic = 0x5343414C; /**< File marker "SCAL". */
+    static constexpr quint16 kVersion = 1; /**< Current format version. */
+
+/**
+ * @brief Create BinaryAlarmStorage instance.
+ * @details Initializes instance state.
+ * @param path Filesystem path; defaults to alarms.bin in the app data folder.
+ * @param legacyJsonPath JSON file to migrate from; defaults to alarms.json next to the default path.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit BinaryAlarmStorage(const QString &path = QString(), const QString &legacyJsonPath = QString());
+
+/**
+ * @brief Load alarms from storage.
+ * @details Reads the binary file, or imports the legacy JSON file and rewrites it as binary.
+ * @param out Output list to populate.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool load(QList<AlarmData> &out) override;
+/**
+ * @brief Save alarms to storage.
+ * @details Writes alarm data to persistent storage.
+ * @param in Alarms to store.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool save(const QList<AlarmData> &in) override;
+
+/**
+ * @brief Set backup enabled.
+ * @details Updates internal state and emits signals as needed.
+ * @param enabled True to keep the previous file as a rolling .bak on every save.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setBackupEnabled(bool enabled);
+
+/**
+ * @brief Encode alarms.
+ * @details Serializes alarms in the current binary format.
+ * @param in Alarms to store.
+ * @return Encoded bytes.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QByteArray encode(const QList<AlarmData> &in);
+/**
+ * @brief Decode alarms.
+ * @details Parses bytes produced by encode().
+ * @param data Encoded bytes.
+ * @param out Output list to populate.
+ * @return True on success; false for foreign, newer or truncated data.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static bool decode(const QByteArray &data, QList<AlarmData> &out);
+
+private:
+/**
+ * @brief Resolve path.
+ * @details Performs the operation and updates state as needed.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString resolvePath() const;
+/**
+ * @brief Resolve legacy path.
+ * @details Returns the JSON file used for migration.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString resolveLegacyPath() const;
+
+    QString path; /**< Filesystem path. */
+    QString legacyJsonPath; /**< JSON file migrated on first load. */
+    bool backupEnabled = false; /**< Keep a rolling .bak of the previous file. */
+};
+
+#endif // BINARYALARMSTORAGE_H
@@ -0,0 +1,561 @@
+/**
+ * @file icsalarmstorage.cpp
+ * @brief Definitions for icsalarmstorage.
+ * @details Implements logic declared in the corresponding header for icsalarmstorage.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "icsalarmstorage.h"
+#include "alarmmanager.h"
+#include "recurrencerule.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QTimeZone>
+#include <QUrl>
+
+namespace {
+constexpr int kFoldOctets = 75;
+// Logical lines longer than this are dropped so a hostile file cannot grow memory without bound.
+constexpr qint64 kMaxLineBytes = 1 << 20;
+
+const char *const kDayCodes[] = {"MO", "TU", "WE", "TH", "FR", "SA", "SU"};
+
+QString unescapeText(const QByteArray &raw)
+{
+    const QString v = QString::fromUtf8(raw);
+    QString out;
+    out.reserve(v.size());
+    for (int i = 0; i < v.size(); ++i) {
+        const QChar c = v.at(i);
+        if (c == '\\' && i + 1 < v.size()) {
+            const QChar n = v.at(++i);
+            out += (n == 'n' || n == 'N') ? QChar('\n') : n;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+QByteArray escapeText(const QString &text)
+{
+    QString out;
+    out.reserve(text.size());
+    for (const QChar c : text) {
+        if (c == '\\' || c == ';' || c == ',') {
+            out += QChar('\\');
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else if (c != '\r') {
+            out += c;
+        }
+    }
+    return out.toUtf8();
+}
+
+// Splits "NAME;PARAM=x:VALUE" into an upper-case name, the raw parameters and the value.
+bool splitProperty(const QByteArray &line, QByteArray &name, QByteArray &params, QByteArray &value)
+{
+    bool quoted = false;
+    int nameEnd = -1;
+    for (int i = 0; i < line.size(); ++i) {
+        const char c = line.at(i);
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (!quoted && c == ';' && nameEnd < 0) {
+            nameEnd = i;
+        } else if (!quoted && c == ':') {
+            if (nameEnd < 0)
+                nameEnd = i;
+            name = line.left(nameEnd).trimmed().toUpper();
+            params = line.mid(nameEnd, i - nameEnd);
+            value = line.mid(i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the value of one ";KEY=value" parameter, without quotes; keys match case-insensitively.
+QByteArray parameter(const QByteArray &params, const QByteArray &key)
+{
+    bool quoted = false;
+    int begin = 0;
+    for (int i = 0; i <= params.size(); ++i) {
+        const char c = i < params.size() ? params.at(i) : ';';
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (c == ';' && !quoted) {
+            const QByteArray item = params.mid(begin, i - begin);
+            const int eq = item.indexOf('=');
+            if (eq > 0 && item.left(eq).trimmed().compare(key, Qt::CaseInsensitive) == 0) {
+                QByteArray value = item.mid(eq + 1).trimmed();
+                if (value.size() >= 2 && value.startsWith('"') && value.endsWith('"'))
+                    value = value.mid(1, value.size() - 2);
+                return value;
+            }
+            begin = i + 1;
+        }
+    }
+    return QByteArray();
+}
+
+// Reads a DATE-TIME in the zone named by TZID and converts it to local time. UTC
+// values ignore TZID; unknown zones fall back to floating (local) time.
+QDateTime parseZonedDateTime(const QByteArray &value, const QByteArray &params)
+{
+    const QDateTime parsed = RecurrenceRule::parseDateTime(QString::fromLatin1(value));
+    const QByteArray tzid = parameter(params, "TZID");
+    if (!parsed.isValid() || tzid.isEmpty() || parsed.timeSpec() == Qt::UTC)
+        return parsed;
+
+    QTimeZone zone(tzid);
+    if (!zone.isValid())
+        zone = QTimeZone(QTimeZone::windowsIdToDefaultIanaId(tzid));
+    if (!zone.isValid())
+        return parsed;
+    return QDateTime(parsed.date(), parsed.time(), zone).toLocalTime();
+}
+
+// Parses an RFC 5545 duration such as -PT15M or P1DT2H.
+bool parseDuration(const QByteArray &text, qint64 &seconds)
+{
+    int i = 0;
+    qint64 sign = 1;
+    if (i < text.size() && (text.at(i) == '+' || text.at(i) == '-'))
+        sign = text.at(i++) == '-' ? -1 : 1;
+    if (i >= text.size() || text.at(i) != 'P')
+        return false;
+
+    qint64 total = 0;
+    qint64 number = 0;
+    bool inTime = false;
+    bool digits = false;
+    bool any = false;
+    for (++i; i < text.size(); ++i) {
+        const char c = text.at(i);
+        if (c >= '0' && c <= '9') {
+            number = number * 10 + (c - '0');
+            digits = true;
+            continue;
+        }
+        if (c == 'T' && !digits) {
+            inTime = true;
+            continue;
+        }
+        if (!digits)
+            return false;
+        if (c == 'W' && !inTime)
+            total += number * 7 * 86400;
+        else if (c == 'D' && !inTime)
+            total += number * 86400;
+        else if (c == 'H' && inTime)
+            total += number * 3600;
+        else if (c == 'M' && inTime)
+            total += number * 60;
+        else if (c == 'S' && inTime)
+            total += number;
+        else
+            return false;
+        number = 0;
+        digits = false;
+        any = true;
+    }
+    if (!any || digits)
+        return false;
+    seconds = sign * total;
+    return true;
+}
+
+QString weeklyRule(quint8 mask)
+{
+    QStringList days;
+    for (int i = 0; i < 7; ++i) {
+        if (mask & (1u << i))
+            days << kDayCodes[i];
+    }
+    return "FREQ=WEEKLY;BYDAY=" + days.join(',');
+}
+
+// Maps the rules AlarmSettingsDialog can express back onto RepeatMode; anything else stays a custom rule.
+void applyRule(AlarmData &a, RecurrenceRule rule, const QDateTime &anchor)
+{
+    const QString text = rule.rruleText();
+    if (text == "FREQ=DAILY") {
+        a.repeatMode = RepeatMode::EveryDay;
+        return;
+    }
+    if (text == weeklyRule(kWeekdaysMask)) {
+        a.repeatMode = RepeatMode::Weekdays;
+        return;
+    }
+    if (text == weeklyRule(kWeekendsMask)) {
+        a.repeatMode = RepeatMode::Weekends;
+        return;
+    }
+    if (text == "FREQ=WEEKLY") {
+        a.repeatMode = RepeatMode::SpecificDays;
+        a.weekdayMask = quint8(1u << (anchor.date().dayOfWeek() - 1));
+        a.days = daysFromWeekdayMask(a.weekdayMask);
+        return;
+    }
+    if (text.startsWith("FREQ=WEEKLY;BYDAY=") && text.indexOf(';', 18) < 0) {
+        const QStringList codes = text.mid(18).split(',');
+        quint8 mask = 0;
+        for (int i = 0; i < 7; ++i) {
+            if (codes.contains(QLatin1String(kDayCodes[i])))
+                mask |= quint8(1u << i);
+        }
+        a.repeatMode = RepeatMode::SpecificDays;
+        a.weekdayMask = mask;
+        a.days = daysFromWeekdayMask(mask);
+        return;
+    }
+
+    rule.setStart(anchor);
+    a.recurrence = rule.toString();
+}
+
+bool writeLine(QIODevice &device, const QByteArray &line)
+{
+    int pos = 0;
+    int limit = kFoldOctets;
+    while (line.size() - pos > limit) {
+        int cut = pos + limit;
+        // Never split a UTF-8 sequence across a fold.
+        while (cut > pos && (uchar(line.at(cut)) & 0xC0) == 0x80)
+            --cut;
+        if (device.write(line.constData() + pos, cut - pos) < 0 || device.write("\r\n ", 3) < 0)
+            return false;
+        pos = cut;
+        limit = kFoldOctets - 1;
+    }
+    return device.write(line.constData() + pos, line.size() - pos) >= 0 && device.write("\r\n", 2) >= 0;
+}
+
+// Collects the properties of one VEVENT at a time and turns it into an AlarmData.
+class EventReader
+{
+public:
+    explicit EventReader(const std::function<void(const AlarmData &)> &sink)
+        : sink(sink)
+        , now(QDateTime::currentDateTime())
+    {
+    }
+
+    void line(const QByteArray &raw)
+    {
+        QByteArray name;
+        QByteArray params;
+        QByteArray value;
+        if (!splitProperty(raw, name, params, value))
+            return;
+
+        if (name == "BEGIN") {
+            const QByteArray component = value.trimmed().toUpper();
+            if (component == "VCALENDAR")
+                sawCalendar = true;
+            else if (component == "VEVENT" && !inEvent)
+                startEvent();
+            else if (component == "VALARM" && inEvent && nested == 0)
+                inAlarm = ++alarmCount;
+            else if (inEvent)
+                ++nested;
+            return;
+        }
+        if (name == "END") {
+            const QByteArray component = value.trimmed().toUpper();
+            if (component == "VALARM" && nested == 0)
+                inAlarm = 0;
+            else if (component == "VEVENT" && nested == 0 && inEvent)
+                finishEvent();
+            else if (nested > 0)
+                --nested;
+            return;
+        }
+        if (!inEvent || nested > 0)
+            return;
+
+        if (inAlarm) {
+            // Only the first VALARM decides when the alarm rings.
+            if (inAlarm == 1)
+                alarmProperty(name, params, value);
+            return;
+        }
+        if (name == "SUMMARY")
+            summary = unescapeText(value);
+        else if (name == "UID")
+            uid = unescapeText(value.trimmed());
+        else if (name == "DTSTART")
+            start = parseZonedDateTime(value, params);
+        else if (name == "DTEND")
+            end = parseZonedDateTime(value, params);
+        else if (name == "RECURRENCE-ID")
+            overridesInstance = true;
+        else if (name == "RRULE")
+            rrule = QString::fromLatin1(value.trimmed());
+        else if (name == "STATUS")
+            cancelled = value.trimmed().toUpper() == "CANCELLED";
+        else if (name == "X-SMARTCLOCK-ENABLED")
+            enabled = value.trimmed().toUpper() == "TRUE";
+        else if (name == "X-SMARTCLOCK-SNOOZE")
+            snooze = value.trimmed().toUpper() == "TRUE";
+    }
+
+    bool sawCalendar = false;
+    int skipped = 0;
+
+private:
+    void startEvent()
+    {
+        inEvent = true;
+        inAlarm = 0;
+        nested = 0;
+        alarmCount = 0;
+        summary.clear();
+        uid.clear();
+        overridesInstance = false;
+        start = QDateTime();
+        end = QDateTime();
+        rrule.clear();
+        cancelled = false;
+        enabled = true;
+        snooze = false;
+        offsetSecs = 0;
+        relatedToEnd = false;
+        absoluteTrigger = QDateTime();
+        sound.clear();
+    }
+
+    void alarmProperty(const QByteArray &name, const QByteArray &params, const QByteArray &value)
+    {
+        if (name == "TRIGGER") {
+            if (parameter(params, "VALUE").toUpper() == "DATE-TIME") {
+                absoluteTrigger = parseZonedDateTime(value, params);
+            } else {
+                parseDuration(value.trimmed().toUpper(), offsetSecs);
+                relatedToEnd = parameter(params, "RELATED").toUpper() == "END";
+            }
+        } else if (name == "ATTACH") {
+            const QString uri = QString::fromUtf8(value.trimmed());
+            if (uri.startsWith("qrc:") || uri.startsWith('/'))
+                sound = uri;
+            else if (uri.startsWith("file:", Qt::CaseInsensitive))
+                sound = QUrl(uri).toLocalFile();
+        }
+    }
+
+    void finishEvent()
+    {
+        inEvent = false;
+        inAlarm = 0;
+        // A RECURRENCE-ID event reschedules one instance of another event, which an alarm cannot express.
+        if (cancelled || overridesInstance || !start.isValid()) {
+            ++skipped;
+            return;
+        }
+
+        QDateTime anchor = absoluteTrigger;
+        if (!anchor.isValid())
+            anchor = (relatedToEnd && end.isValid() ? end : start).addSecs(offsetSecs);
+        const QDateTime local = anchor.toLocalTime();
+
+        AlarmData a;
+        a.name = summary.isEmpty() ? QString("Alarm") : summary;
+        a.uid = uid;
+        a.time = QTime(local.time().hour(), local.time().minute(), local.time().second());
+        a.soundPath = sound;
+        a.snooze = snooze;
+        a.enabled = enabled;
+
+        if (!rrule.isEmpty() && !absoluteTrigger.isValid()) {
+            const RecurrenceRule rule = RecurrenceRule::parse(rrule);
+            if (!rule.isValid()) {
+                ++skipped;
+                return;
+            }
+            applyRule(a, rule, anchor);
+        } else {
+            a.repeatMode = RepeatMode::Once;
+            a.nextTrigger = local;
+            // A past one-time event would fire the moment it is added.
+            if (local <= now)
+                a.enabled = false;
+        }
+        sink(a);
+    }
+
+    const std::function<void(const AlarmData &)> &sink;
+    const QDateTime now;
+    bool inEvent = false;
+    int inAlarm = 0; // 1-based number of the VALARM being read, 0 outside one.
+    int nested = 0;
+    int alarmCount = 0;
+    QString summary;
+    QString uid;
+    bool overridesInstance = false;
+    QDateTime start;
+    QDateTime end;
+    QString rrule;
+    bool cancelled = false;
+    bool enabled = true;
+    bool snooze = false;
+    qint64 offsetSecs = 0;
+    bool relatedToEnd = false;
+    QDateTime absoluteTrigger;
+    QString sound;
+};
+} // namespace
+
+IcsAlarmStorage::IcsAlarmStorage(const QString &path)
+    : path(path)
+{
+}
+
+bool IcsAlarmStorage::load(QList<AlarmData> &out)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    QList<AlarmData> alarms;
+    if (!read(f, [&alarms](const AlarmData &a) { alarms.append(a); }, &skipped))
+        return false;
+    out = alarms;
+    return true;
+}
+
+bool IcsAlarmStorage::save(const QList<AlarmData> &alarms)
+{
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+    if (!write(f, alarms)) {
+        f.cancelWriting();
+        return false;
+    }
+    return f.commit();
+}
+
+int IcsAlarmStorage::skippedEvents() const
+{
+    return skipped;
+}
+
+QString IcsAlarmStorage::uidOf(const AlarmData &alarm)
+{
+    return alarm.uid.isEmpty() ? QString("alarm-%1@smartclock").arg(alarm.id) : alarm.uid;
+}
+
+bool IcsAlarmStorage::read(QIODevice &device, const std::function<void(const AlarmData &)> &sink, int *skipped)
+{
+    if (!device.isReadable())
+        return false;
+
+    EventReader reader(sink);
+    QByteArray logical;
+    bool dropping = false;
+    auto flush = [&]() {
+        if (!dropping && !logical.isEmpty())
+            reader.line(logical);
+        logical.clear();
+        dropping = false;
+    };
+
+    while (!device.atEnd()) {
+        QByteArray physical = device.readLine(kMaxLineBytes);
+        const bool complete = physical.endsWith('\n') || device.atEnd();
+        while (physical.endsWith('\n') || physical.endsWith('\r'))
+            physical.chop(1);
+
+        const bool continuation = !physical.isEmpty() && (physical.at(0) == ' ' || physical.at(0) == '\t');
+        if (continuation) {
+            if (logical.size() + physical.size() > kMaxLineBytes)
+                dropping = true;
+            else
+                logical.append(physical.constData() + 1, physical.size() - 1);
+        } else {
+            flush();
+            logical = physical;
+        }
+
+        if (!complete) {
+            // Skip the rest of an oversized physical line and drop the logical line it belongs to.
+            dropping = true;
+            while (!device.atEnd() && !device.readLine(kMaxLineBytes).endsWith('\n')) {
+            }
+        }
+    }
+    flush();
+
+    if (skipped)
+        *skipped = reader.skipped;
+    return reader.sawCalendar;
+}
+
+bool IcsAlarmStorage::write(QIODevice &device, const QList<AlarmData> &alarms)
+{
+    if (!device.isWritable())
+        return false;
+
+    const QByteArray stamp = RecurrenceRule::formatDateTime(QDateTime::currentDateTimeUtc()).toLatin1();
+    bool ok = writeLine(device, "BEGIN:VCALENDAR")
+        && writeLine(device, "VERSION:2.0")
+        && writeLine(device, "PRODID:-//SmartClock//Alarms//EN");
+
+    for (const AlarmData &a : alarms) {
+        if (!ok)
+            break;
+        QString rule;
+        QDateTime start;
+        if (a.rule.isValid()) {
+            rule = a.rule.rruleText();
+            start = a.rule.start();
+        } else {
+            switch (a.repeatMode) {
+            case RepeatMode::EveryDay:
+                rule = "FREQ=DAILY";
+                break;
+            case RepeatMode::Weekdays:
+                rule = weeklyRule(kWeekdaysMask);
+                break;
+            case RepeatMode::Weekends:
+                rule = weeklyRule(kWeekendsMask);
+                break;
+            case RepeatMode::SpecificDays: {
+                const quint8 mask = a.weekdayMask ? a.weekdayMask : weekdayMaskFromDays(a.days);
+                if (mask)
+                    rule = weeklyRule(mask);
+                break;
+            }
+            default:
+                break;
+            }
+            start = a.nextTrigger.isValid() ? a.nextTrigger : QDateTime(QDate::currentDate(), a.time);
+        }
+
+        ok = writeLine(device, "BEGIN:VEVENT")
+            && writeLine(device, "UID:" + escapeText(uidOf(a)))
+            && writeLine(device, "DTSTAMP:" + stamp)
+            && writeLine(device, "DTSTART:" + RecurrenceRule::formatDateTime(start).toLatin1())
+            && writeLine(device, "SUMMARY:" + escapeText(a.name))
+            && (rule.isEmpty() || writeLine(device, "RRULE:" + rule.toLatin1()))
+            && writeLine(device, QByteArray("X-SMARTCLOCK-ENABLED:") + (a.enabled ? "TRUE" : "FALSE"))
+            && writeLine(device, QByteArray("X-SMARTCLOCK-SNOOZE:") + (a.snooze ? "TRUE" : "FALSE"))
+            && writeLine(device, "BEGIN:VALARM")
+            && writeLine(device, "TRIGGER:PT0S");
+        if (ok && a.soundPath.isEmpty()) {
+            ok = writeLine(device, "ACTION:DISPLAY") && writeLine(device, "DESCRIPTION:" + escapeText(a.name));
+        } else if (ok) {
+            const QString uri = a.soundPath.startsWith("qrc:") ? a.soundPath
+                                                               : QUrl::fromLocalFile(a.soundPath).toString();
+            ok = writeLine(device, "ACTION:AUDIO") && writeLine(device, "ATTACH:" + uri.toUtf8());
+        }
+        ok = ok && writeLine(device, "END:VALARM") && writeLine(device, "END:VEVENT");
+    }
+    return ok && writeLine(device, "END:VCALENDAR");
+}
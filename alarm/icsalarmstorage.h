@@ -0,0 +1,110 @@
+/**
+ * @file icsalarmstorage.h
+ * @brief Declarations for icsalarmstorage.
+ * @details Defines a streaming iCalendar (.ics) reader and writer for alarms.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef ICSALARMSTORAGE_H
+#define ICSALARMSTORAGE_H
+
+#include "ialarmstorage.h"
+#include <QIODevice>
+#include <QString>
+#include <functional>
+
+/**
+ * @brief IcsAlarmStorage Storage interface or implementation for persistence.
+ * @details Maps each VEVENT to one alarm. The first VALARM's TRIGGER moves
+ * the alarm relative to DTSTART (or DTEND with RELATED=END), or replaces it
+ * with an absolute time. Plain daily and weekly RRULEs become RepeatMode
+ * values; other supported rules are kept in AlarmData::recurrence.
+ * The reader unfolds and handles one logical line at a time and never holds
+ * more than the current event, so memory stays bounded by the line limit
+ * regardless of file size.
+ * Times with a TZID are read in that zone and converted to local time; an
+ * unknown zone falls back to floating (local) time. Each event's UID is kept
+ * on the alarm so that a later import can recognise it.
+ * @note Events that are cancelled, lack DTSTART, override one instance (RECURRENCE-ID) or use an unsupported RRULE are skipped.
+ * @warning Recurring events are anchored at their first occurrence's local time, so they do not follow later DST changes of their own zone.
+ * @sa SmartClock
+ */
+class IcsAlarmStorage : public IAlarmStorage
+{
+public:
+/**
+ * @brief Create IcsAlarmStorage instance.
+ * @details Initializes instance state.
+ * @param path Filesystem path.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit IcsAlarmStorage(const QString &path);
+
+/**
+ * @brief Load snapshot from storage.
+ * @details Streams the calendar file and replaces the output with its events.
+ * @param out Output snapshot to populate.
+ * @return True on success; false if the file cannot be read or holds no VCALENDAR.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool load(QList<AlarmData> &out) override;
+/**
+ * @brief Save snapshot to storage.
+ * @details Streams the alarms into the file and replaces it atomically.
+ * @param alarms Alarms to write.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool save(const QList<AlarmData> &alarms) override;
+/**
+ * @brief Get skipped events.
+ * @details Returns how many events the last load() skipped.
+ * @return Number of items.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int skippedEvents() const;
+/**
+ * @brief Get event UID.
+ * @details Returns the UID an alarm is written with: the imported UID, or one built from the stable id.
+ * @param alarm Alarm to name.
+ * @return UID text.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QString uidOf(const AlarmData &alarm);
+
+/**
+ * @brief Read calendar.
+ * @details Parses the device line by line and hands each finished event to the sink.
+ * @param device Readable device.
+ * @param sink Receives one alarm per imported event.
+ * @param skipped Receives the number of skipped events. May be null.
+ * @return True if a VCALENDAR was found; false otherwise.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static bool read(QIODevice &device, const std::function<void(const AlarmData &)> &sink,
+                     int *skipped = nullptr);
+/**
+ * @brief Write calendar.
+ * @details Writes one VEVENT with an audio VALARM per alarm, folding lines at 75 octets.
+ * @param device Writable device.
+ * @param alarms Alarms to write.
+ * @return True on success; false on a write error.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static bool write(QIODevice &device, const QList<AlarmData> &alarms);
+
+private:
+    QString path; /**< Calendar file path. */
+    int skipped = 0; /**< Events skipped by the last load. */
+};
+
+#endif // ICSALARMSTORAGE_H
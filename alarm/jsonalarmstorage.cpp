@@ -9,6 +9,7 @@
  */
 
 #include "jsonalarmstorage.h"
+#include "../storage/atomicfile.h"
 #include "alarmmanager.h"
 #include <QStandardPaths>
 #include <QDir>
@@ -22,6 +23,11 @@ JsonAlarmStorage::JsonAlarmStorage(const QString &path)
 {
 }
 
+void JsonAlarmStorage::setBackupEnabled(bool enabled)
+{
+    backupEnabled = enabled;
+}
+
 QString JsonAlarmStorage::resolvePath() const
 {
     if (!path.isEmpty())
@@ -58,6 +64,12 @@ bool JsonAlarmStorage::load(QList<AlarmData> &out)
         a.snooze = o["snooze"].toBool();
         a.enabled = o["enabled"].toBool();
         a.nextTrigger = QDateTime::fromString(o["nextTrigger"].toString(), Qt::ISODate);
+        a.weekdayMask = quint8(o["weekdayMask"].toInt() & kEveryDayMask);
+        a.recurrence = o["recurrence"].toString();
+        a.id = quint64(o["id"].toInteger());
+        a.ruleCursor.occurrence = QDateTime::fromString(o["occurrence"].toString(), Qt::ISODate);
+        a.ruleCursor.index = o["occurrenceIndex"].toInt();
+        a.uid = o["uid"].toString();
         out.append(a);
     }
 
@@ -79,14 +91,19 @@ bool JsonAlarmStorage::save(const QList<AlarmData> &alarms)
         o["snooze"] = a.snooze;
         o["enabled"] = a.enabled;
         o["nextTrigger"] = a.nextTrigger.toString(Qt::ISODate);
+        o["weekdayMask"] = int(a.weekdayMask);
+        o["id"] = qint64(a.id);
+        if (!a.recurrence.isEmpty())
+            o["recurrence"] = a.recurrence;
+        if (a.ruleCursor.index > 0) {
+            o["occurrence"] = a.ruleCursor.occurrence.toString(Qt::ISODate);
+            o["occurrenceIndex"] = a.ruleCursor.index;
+        }
+        if (!a.uid.isEmpty())
+            o["uid"] = a.uid;
         arr.append(o);
     }
 
     QJsonDocument doc(arr);
-    QFile f(p);
-    if (!f.open(QIODevice::WriteOnly))
-        return false;
-    f.write(doc.toJson());
-    f.close();
-    return true;
+    return AtomicFile::write(p, doc.toJson(), backupEnabled);
 }
@@ -0,0 +1,672 @@
+/**
+ * @file recurrencerule.cpp
+ * @brief Definitions for recurrencerule.
+ * @details Implements logic declared in the corresponding header for recurrencerule.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "recurrencerule.h"
+#include "alarmrepeatmode.h"
+#include <QStringList>
+#include <QTime>
+#include <QtAlgorithms>
+#include <algorithm>
+
+namespace {
+// Periods (or grid jumps) scanned before a rule that can never match again is treated as exhausted.
+constexpr int kMaxPeriods = 4000;
+constexpr quint32 kAllHours = 0xFFFFFF;
+constexpr quint64 kAllMinutes = (quint64(1) << 60) - 1;
+
+const char *const kDayCodes[] = {"MO", "TU", "WE", "TH", "FR", "SA", "SU"};
+
+int nextSetBit(quint64 mask, int from, int width)
+{
+    if (from < 0)
+        from = 0;
+    if (from >= width)
+        return -1;
+    quint64 rest = (mask >> from) << from;
+    if (width < 64)
+        rest &= (quint64(1) << width) - 1;
+    return rest ? int(qCountTrailingZeroBits(rest)) : -1;
+}
+
+int dayFromCode(const QString &code)
+{
+    for (int i = 0; i < 7; ++i) {
+        if (code == QLatin1String(kDayCodes[i]))
+            return i + 1;
+    }
+    return 0;
+}
+
+bool parseIntList(const QString &value, int lo, int hi, QList<int> &out)
+{
+    out.clear();
+    for (const QString &part : value.split(',')) {
+        bool ok = false;
+        const int v = part.trimmed().toInt(&ok);
+        if (!ok || v < lo || v > hi || (lo < 0 && v == 0))
+            return false;
+        out.append(v);
+    }
+    return !out.isEmpty();
+}
+
+// Day of month of the first given weekday, from the weekday of the 1st.
+int firstDayOfWeekday(int firstDow, int dow)
+{
+    return (dow - firstDow + 7) % 7 + 1;
+}
+} // namespace
+
+RecurrenceRule RecurrenceRule::parse(const QString &text, QString *error)
+{
+    auto fail = [error](const QString &message) {
+        if (error)
+            *error = message;
+        return RecurrenceRule();
+    };
+
+    RecurrenceRule rule;
+    QString rrule;
+    QString normalized = text;
+    normalized.replace('\r', '\n');
+    for (const QString &raw : normalized.split('\n', Qt::SkipEmptyParts)) {
+        const QString line = raw.trimmed();
+        if (line.isEmpty())
+            continue;
+        const QString upper = line.toUpper();
+        if (upper.startsWith("DTSTART")) {
+            const QDateTime start = parseDateTime(line.mid(line.lastIndexOf(':') + 1));
+            if (!start.isValid())
+                return fail(QString("Invalid DTSTART: %1").arg(line));
+            rule.setStart(start);
+        } else if (upper.startsWith("RRULE:")) {
+            rrule = upper.mid(6);
+        } else if (upper.contains('=')) {
+            rrule = upper;
+        } else {
+            return fail(QString("Unexpected line: %1").arg(line));
+        }
+    }
+    if (rrule.isEmpty())
+        return fail("Missing RRULE");
+
+    bool hasFreq = false;
+    QList<int> numbers;
+    for (const QString &part : rrule.split(';', Qt::SkipEmptyParts)) {
+        const int eq = part.indexOf('=');
+        if (eq <= 0)
+            return fail(QString("Malformed rule part: %1").arg(part));
+        const QString key = part.left(eq).trimmed();
+        const QString value = part.mid(eq + 1).trimmed();
+
+        if (key == "FREQ") {
+            if (value == "MINUTELY")
+                rule.freq = Frequency::Minutely;
+            else if (value == "HOURLY")
+                rule.freq = Frequency::Hourly;
+            else if (value == "DAILY")
+                rule.freq = Frequency::Daily;
+            else if (value == "WEEKLY")
+                rule.freq = Frequency::Weekly;
+            else if (value == "MONTHLY")
+                rule.freq = Frequency::Monthly;
+            else
+                return fail(QString("Unsupported FREQ: %1").arg(value));
+            hasFreq = true;
+        } else if (key == "INTERVAL") {
+            if (!parseIntList(value, 1, 10000, numbers) || numbers.size() != 1)
+                return fail(QString("Invalid INTERVAL: %1").arg(value));
+            rule.step = numbers.first();
+        } else if (key == "COUNT") {
+            if (!parseIntList(value, 1, 100000, numbers) || numbers.size() != 1)
+                return fail(QString("Invalid COUNT: %1").arg(value));
+            rule.maxCount = numbers.first();
+        } else if (key == "UNTIL") {
+            rule.untilTime = parseDateTime(value);
+            if (!rule.untilTime.isValid())
+                return fail(QString("Invalid UNTIL: %1").arg(value));
+            // A date-only UNTIL includes the whole day.
+            if (value.size() == 8)
+                rule.untilTime = QDateTime(rule.untilTime.date(), QTime(23, 59, 59));
+        } else if (key == "BYDAY") {
+            for (const QString &entry : value.split(',')) {
+                const QString code = entry.trimmed();
+                const int day = dayFromCode(code.right(2));
+                if (code.size() < 2 || day == 0)
+                    return fail(QString("Invalid BYDAY: %1").arg(code));
+                const QString ordinal = code.left(code.size() - 2);
+                if (ordinal.isEmpty()) {
+                    rule.dayMask |= quint8(1u << (day - 1));
+                    continue;
+                }
+                if (!parseIntList(ordinal, -5, 5, numbers))
+                    return fail(QString("Invalid BYDAY ordinal: %1").arg(code));
+                rule.nthDays.append(NthDay{numbers.first(), day});
+            }
+        } else if (key == "BYMONTHDAY") {
+            if (!parseIntList(value, -31, 31, numbers))
+                return fail(QString("Invalid BYMONTHDAY: %1").arg(value));
+            for (int d : numbers) {
+                if (d > 0)
+                    rule.monthDays |= quint32(1) << d;
+                else
+                    rule.lastMonthDays |= quint32(1) << -d;
+            }
+        } else if (key == "BYHOUR") {
+            if (!parseIntList(value, 0, 23, numbers))
+                return fail(QString("Invalid BYHOUR: %1").arg(value));
+            for (int h : numbers)
+                rule.hours |= quint32(1) << h;
+        } else if (key == "BYMINUTE") {
+            if (!parseIntList(value, 0, 59, numbers))
+                return fail(QString("Invalid BYMINUTE: %1").arg(value));
+            for (int m : numbers)
+                rule.minutes |= quint64(1) << m;
+        } else if (key == "BYSETPOS") {
+            if (!parseIntList(value, -366, 366, numbers))
+                return fail(QString("Invalid BYSETPOS: %1").arg(value));
+            rule.setPositions = numbers;
+        } else if (key == "WKST") {
+            if (value != "MO")
+                return fail("Only WKST=MO is supported");
+        } else {
+            return fail(QString("Unsupported rule part: %1").arg(key));
+        }
+    }
+
+    if (!hasFreq)
+        return fail("Missing FREQ");
+    if (!rule.nthDays.isEmpty() && rule.freq != Frequency::Monthly)
+        return fail("BYDAY ordinals need FREQ=MONTHLY");
+    if (!rule.setPositions.isEmpty() && rule.freq < Frequency::Daily)
+        return fail("BYSETPOS needs FREQ=DAILY or longer");
+    if (rule.maxCount > 0 && rule.untilTime.isValid())
+        return fail("COUNT and UNTIL cannot be combined");
+
+    rule.valid = true;
+    if (error)
+        error->clear();
+    return rule;
+}
+
+QDateTime RecurrenceRule::parseDateTime(const QString &value)
+{
+    const QString v = value.trimmed().toUpper();
+    const QDate date = QDate::fromString(v.left(8), "yyyyMMdd");
+    if (!date.isValid())
+        return QDateTime();
+    if (v.size() == 8)
+        return QDateTime(date, QTime(0, 0));
+    if (v.size() < 15 || v.at(8) != 'T')
+        return QDateTime();
+
+    const QTime time = QTime::fromString(v.mid(9, 6), "HHmmss");
+    if (!time.isValid())
+        return QDateTime();
+    if (v.size() == 16 && v.endsWith('Z'))
+        return QDateTime(date, time, Qt::UTC);
+    return v.size() == 15 ? QDateTime(date, time) : QDateTime();
+}
+
+QString RecurrenceRule::formatDateTime(const QDateTime &value)
+{
+    if (!value.isValid())
+        return QString();
+    const QString text = value.toString("yyyyMMdd'T'HHmmss");
+    return value.timeSpec() == Qt::UTC ? text + 'Z' : text;
+}
+
+bool RecurrenceRule::isValid() const
+{
+    return valid;
+}
+
+RecurrenceRule::Frequency RecurrenceRule::frequency() const
+{
+    return freq;
+}
+
+int RecurrenceRule::interval() const
+{
+    return step;
+}
+
+int RecurrenceRule::count() const
+{
+    return maxCount;
+}
+
+QDateTime RecurrenceRule::until() const
+{
+    return untilTime;
+}
+
+QDateTime RecurrenceRule::start() const
+{
+    return dtstart;
+}
+
+void RecurrenceRule::setStart(const QDateTime &start)
+{
+    if (!start.isValid()) {
+        dtstart = QDateTime();
+        return;
+    }
+    dtstart = start.timeSpec() == Qt::UTC ? start : start.toLocalTime();
+    const QTime t = dtstart.time();
+    dtstart.setTime(QTime(t.hour(), t.minute(), t.second()));
+}
+
+QDateTime RecurrenceRule::next(const QDateTime &after) const
+{
+    Cursor cursor;
+    return next(after, cursor);
+}
+
+QDateTime RecurrenceRule::next(const QDateTime &after, Cursor &cursor) const
+{
+    if (!valid || !dtstart.isValid() || !after.isValid())
+        return QDateTime();
+    if (maxCount == 0) {
+        cursor.occurrence = nextUnbounded(after);
+        cursor.index = 0;
+        return cursor.occurrence;
+    }
+
+    // COUNT is defined from DTSTART; resume from the cursor when it is still behind us.
+    QDateTime current = dtstart.addSecs(-1);
+    int index = 0;
+    if (cursor.index > 0 && cursor.index <= maxCount && cursor.occurrence.isValid()
+        && cursor.occurrence >= dtstart && cursor.occurrence <= after) {
+        current = cursor.occurrence;
+        index = cursor.index;
+    }
+    while (index < maxCount) {
+        current = nextUnbounded(current);
+        if (!current.isValid())
+            break;
+        ++index;
+        if (current > after) {
+            cursor.occurrence = current;
+            cursor.index = index;
+            return current;
+        }
+    }
+    return QDateTime();
+}
+
+QList<QDateTime> RecurrenceRule::occurrences(const QDateTime &from, const QDateTime &to, int limit) const
+{
+    QList<QDateTime> out;
+    if (!valid || !dtstart.isValid() || !from.isValid() || !to.isValid() || limit == 0)
+        return out;
+
+    QDateTime current = maxCount > 0 ? dtstart.addSecs(-1) : from.addMSecs(-1);
+    for (int index = 0;;) {
+        current = nextUnbounded(current);
+        if (!current.isValid() || current > to)
+            break;
+        if (maxCount > 0 && ++index > maxCount)
+            break;
+        if (current < from)
+            continue;
+        out.append(current);
+        if (limit > 0 && out.size() >= limit)
+            break;
+    }
+    return out;
+}
+
+QString RecurrenceRule::rruleText() const
+{
+    if (!valid)
+        return QString();
+
+    static const char *const kFrequencyNames[] = {"MINUTELY", "HOURLY", "DAILY", "WEEKLY", "MONTHLY"};
+    QStringList parts;
+    parts << QString("FREQ=%1").arg(kFrequencyNames[int(freq)]);
+    if (step != 1)
+        parts << QString("INTERVAL=%1").arg(step);
+    if (maxCount > 0)
+        parts << QString("COUNT=%1").arg(maxCount);
+    if (untilTime.isValid())
+        parts << "UNTIL=" + formatDateTime(untilTime);
+
+    QStringList days;
+    for (int i = nextSetBit(dayMask, 0, 7); i >= 0; i = nextSetBit(dayMask, i + 1, 7))
+        days << kDayCodes[i];
+    for (const NthDay &nth : nthDays)
+        days << QString::number(nth.ordinal) + kDayCodes[nth.dayOfWeek - 1];
+    if (!days.isEmpty())
+        parts << "BYDAY=" + days.join(',');
+
+    QStringList monthDayList;
+    for (int d = nextSetBit(monthDays, 1, 32); d >= 0; d = nextSetBit(monthDays, d + 1, 32))
+        monthDayList << QString::number(d);
+    for (int d = nextSetBit(lastMonthDays, 1, 32); d >= 0; d = nextSetBit(lastMonthDays, d + 1, 32))
+        monthDayList << QString::number(-d);
+    if (!monthDayList.isEmpty())
+        parts << "BYMONTHDAY=" + monthDayList.join(',');
+
+    QStringList hourList;
+    for (int h = nextSetBit(hours, 0, 24); h >= 0; h = nextSetBit(hours, h + 1, 24))
+        hourList << QString::number(h);
+    if (!hourList.isEmpty())
+        parts << "BYHOUR=" + hourList.join(',');
+
+    QStringList minuteList;
+    for (int m = nextSetBit(minutes, 0, 60); m >= 0; m = nextSetBit(minutes, m + 1, 60))
+        minuteList << QString::number(m);
+    if (!minuteList.isEmpty())
+        parts << "BYMINUTE=" + minuteList.join(',');
+
+    if (!setPositions.isEmpty()) {
+        QStringList positions;
+        for (int pos : setPositions)
+            positions << QString::number(pos);
+        parts << "BYSETPOS=" + positions.join(',');
+    }
+    return parts.join(';');
+}
+
+QString RecurrenceRule::toString() const
+{
+    if (!valid)
+        return QString();
+    const QString rule = "RRULE:" + rruleText();
+    return dtstart.isValid() ? "DTSTART:" + formatDateTime(dtstart) + '\n' + rule : rule;
+}
+
+QDateTime RecurrenceRule::nextUnbounded(const QDateTime &after) const
+{
+    // Day and time-of-day arithmetic below works in DTSTART's time spec.
+    const QDateTime ref = dtstart.timeSpec() == Qt::UTC ? after.toUTC() : after.toLocalTime();
+    QDateTime found;
+    if (freq == Frequency::Hourly && minutes)
+        found = nextInHours(ref);
+    else
+        found = freq < Frequency::Daily ? nextOnGrid(ref) : nextInPeriods(ref);
+    if (found.isValid() && untilTime.isValid() && found > untilTime)
+        return QDateTime();
+    return found;
+}
+
+QDateTime RecurrenceRule::nextOnGrid(const QDateTime &after) const
+{
+    const qint64 stepSecs = qint64(step) * (freq == Frequency::Minutely ? 60 : 3600);
+    qint64 k = after < dtstart ? 0 : dtstart.secsTo(after) / stepSecs + 1;
+    for (int i = 0; i < kMaxPeriods; ++i) {
+        const QDateTime t = dtstart.addSecs(k * stepSecs);
+        if (untilTime.isValid() && t > untilTime)
+            return QDateTime();
+        const QDateTime allowed = firstAllowedFrom(t);
+        if (!allowed.isValid())
+            return QDateTime();
+        if (allowed == t)
+            return t;
+        // Jump to the first grid step at or after the next allowed minute.
+        k = (dtstart.secsTo(allowed) + stepSecs - 1) / stepSecs;
+    }
+    return QDateTime();
+}
+
+QDateTime RecurrenceRule::nextInHours(const QDateTime &after) const
+{
+    const qint64 stepSecs = qint64(step) * 3600;
+    const QTime t0 = dtstart.time();
+    const QDateTime base(dtstart.date(), QTime(t0.hour(), 0), dtstart.timeSpec());
+    qint64 k = after < base ? 0 : base.secsTo(after) / stepSecs;
+    for (int i = 0; i < kMaxPeriods; ++i) {
+        const QDateTime hourStart = base.addSecs(k * stepSecs);
+        if (untilTime.isValid() && hourStart > untilTime)
+            return QDateTime();
+        const QDateTime allowed = firstAllowedFrom(hourStart);
+        if (!allowed.isValid())
+            return QDateTime();
+        const int hour = hourStart.time().hour();
+        if (allowed.date() != hourStart.date() || allowed.time().hour() != hour) {
+            // Jump to the first grid hour at or after the next allowed hour.
+            const QDateTime allowedHour(allowed.date(), QTime(allowed.time().hour(), 0), dtstart.timeSpec());
+            k = (base.secsTo(allowedHour) + stepSecs - 1) / stepSecs;
+            continue;
+        }
+        for (int m = nextSetBit(minutes, 0, 60); m >= 0; m = nextSetBit(minutes, m + 1, 60)) {
+            const QDateTime candidate = at(hourStart.date(), hour * 60 + m, t0.second());
+            if (candidate > after && candidate >= dtstart)
+                return candidate;
+        }
+        ++k;
+    }
+    return QDateTime();
+}
+
+QDateTime RecurrenceRule::nextInPeriods(const QDateTime &after) const
+{
+    const QDateTime from = after < dtstart ? dtstart.addSecs(-1) : after;
+    QDate period = periodStart(dtstart.date());
+    const QDate target = periodStart(from.date());
+
+    qint64 elapsed = 0;
+    switch (freq) {
+    case Frequency::Weekly:
+        elapsed = period.daysTo(target) / 7;
+        break;
+    case Frequency::Monthly:
+        elapsed = qint64(target.year() - period.year()) * 12 + target.month() - period.month();
+        break;
+    default:
+        elapsed = period.daysTo(target);
+        break;
+    }
+    if (elapsed > 0)
+        period = advancePeriod(period, (elapsed / step) * step);
+
+    for (int i = 0; i < kMaxPeriods; ++i) {
+        if (untilTime.isValid() && period > untilTime.date())
+            return QDateTime();
+        const QDateTime found = firstInPeriod(period, from);
+        if (found.isValid())
+            return found;
+        period = advancePeriod(period, step);
+    }
+    return QDateTime();
+}
+
+QDateTime RecurrenceRule::firstInPeriod(const QDate &period, const QDateTime &after) const
+{
+    const QList<QDate> dates = datesInPeriod(period);
+    if (setPositions.isEmpty()) {
+        for (const QDate &d : dates) {
+            if (d < after.date())
+                continue;
+            const QDateTime found = firstOnDate(d, after);
+            if (found.isValid())
+                return found;
+        }
+        return QDateTime();
+    }
+
+    // BYSETPOS picks from the whole ordered set of the period's instants.
+    const int second = dtstart.time().second();
+    QList<QDateTime> instants;
+    for (const QDate &d : dates) {
+        for (int m = firstMinuteFrom(0); m >= 0; m = firstMinuteFrom(m + 1))
+            instants.append(at(d, m, second));
+    }
+    QList<QDateTime> picked;
+    const int n = instants.size();
+    for (int pos : setPositions) {
+        const int index = pos > 0 ? pos - 1 : n + pos;
+        if (index >= 0 && index < n)
+            picked.append(instants[index]);
+    }
+    std::sort(picked.begin(), picked.end());
+    for (const QDateTime &t : picked) {
+        if (t > after && t >= dtstart)
+            return t;
+    }
+    return QDateTime();
+}
+
+QDateTime RecurrenceRule::firstOnDate(const QDate &date, const QDateTime &after) const
+{
+    if (date < after.date())
+        return QDateTime();
+    const QTime ref = after.time();
+    const int from = date == after.date() ? ref.hour() * 60 + ref.minute() : 0;
+    const int second = dtstart.time().second();
+    for (int m = firstMinuteFrom(from); m >= 0; m = firstMinuteFrom(m + 1)) {
+        const QDateTime candidate = at(date, m, second);
+        if (candidate > after && candidate >= dtstart)
+            return candidate;
+    }
+    return QDateTime();
+}
+
+QDateTime RecurrenceRule::firstAllowedFrom(const QDateTime &t) const
+{
+    const QTime time = t.time();
+    const int minute = time.hour() * 60 + time.minute();
+    QDate date = t.date();
+    for (int i = 0; i < kMaxPeriods; ++i, date = date.addDays(1)) {
+        if (!dayMatches(date))
+            continue;
+        const int m = firstMinuteFrom(i == 0 ? minute : 0);
+        if (m < 0)
+            continue;
+        if (i == 0 && m == minute)
+            return t;
+        return at(date, m, 0);
+    }
+    return QDateTime();
+}
+
+QList<QDate> RecurrenceRule::datesInPeriod(const QDate &period) const
+{
+    QList<QDate> dates;
+    switch (freq) {
+    case Frequency::Weekly: {
+        const quint8 days = dayMask ? dayMask : quint8(1u << (dtstart.date().dayOfWeek() - 1));
+        for (int i = nextSetBit(days, 0, 7); i >= 0; i = nextSetBit(days, i + 1, 7)) {
+            const QDate d = period.addDays(i);
+            if (dayMatches(d))
+                dates.append(d);
+        }
+        break;
+    }
+    case Frequency::Monthly: {
+        const quint32 mask = monthMask(period);
+        for (int d = nextSetBit(mask, 1, 32); d >= 0; d = nextSetBit(mask, d + 1, 32))
+            dates.append(QDate(period.year(), period.month(), d));
+        break;
+    }
+    default:
+        if (dayMatches(period))
+            dates.append(period);
+        break;
+    }
+    return dates;
+}
+
+quint32 RecurrenceRule::monthMask(const QDate &first) const
+{
+    const int dim = first.daysInMonth();
+    const quint32 all = quint32(((quint64(1) << (dim + 1)) - 1) & ~quint64(1));
+    const bool byMonthDay = monthDays || lastMonthDays;
+    const bool byWeekday = dayMask || !nthDays.isEmpty();
+    if (!byMonthDay && !byWeekday) {
+        const int day = dtstart.date().day();
+        return day <= dim ? quint32(1) << day : 0;
+    }
+
+    quint32 dayFilter = all;
+    if (byMonthDay) {
+        dayFilter = monthDays & all;
+        for (int k = nextSetBit(lastMonthDays, 1, dim + 1); k >= 0; k = nextSetBit(lastMonthDays, k + 1, dim + 1))
+            dayFilter |= quint32(1) << (dim + 1 - k);
+    }
+
+    quint32 weekdayFilter = all;
+    if (byWeekday) {
+        weekdayFilter = 0;
+        const int firstDow = first.dayOfWeek();
+        for (int w = nextSetBit(dayMask, 0, 7); w >= 0; w = nextSetBit(dayMask, w + 1, 7)) {
+            for (int d = firstDayOfWeekday(firstDow, w + 1); d <= dim; d += 7)
+                weekdayFilter |= quint32(1) << d;
+        }
+        for (const NthDay &nth : nthDays) {
+            const int firstDay = firstDayOfWeekday(firstDow, nth.dayOfWeek);
+            const int available = (dim - firstDay) / 7 + 1;
+            const int index = nth.ordinal > 0 ? nth.ordinal - 1 : available + nth.ordinal;
+            if (index >= 0 && index < available)
+                weekdayFilter |= quint32(1) << (firstDay + 7 * index);
+        }
+    }
+    return dayFilter & weekdayFilter;
+}
+
+bool RecurrenceRule::dayMatches(const QDate &date) const
+{
+    const quint8 days = dayMask ? dayMask : kEveryDayMask;
+    if (!(days & (1u << (date.dayOfWeek() - 1))))
+        return false;
+    if (!monthDays && !lastMonthDays)
+        return true;
+    const int day = date.day();
+    return (monthDays & (quint32(1) << day))
+        || (lastMonthDays & (quint32(1) << (date.daysInMonth() + 1 - day)));
+}
+
+int RecurrenceRule::firstMinuteFrom(int from) const
+{
+    const QTime t = dtstart.time();
+    const bool grid = freq < Frequency::Daily;
+    const quint32 hourMask = hours ? hours : (grid ? kAllHours : quint32(1) << t.hour());
+    const quint64 minuteMask = minutes ? minutes : (grid ? kAllMinutes : quint64(1) << t.minute());
+
+    int minute = from % 60;
+    for (int h = nextSetBit(hourMask, from / 60, 24); h >= 0; h = nextSetBit(hourMask, h + 1, 24)) {
+        if (h * 60 > from)
+            minute = 0;
+        const int m = nextSetBit(minuteMask, minute, 60);
+        if (m >= 0)
+            return h * 60 + m;
+    }
+    return -1;
+}
+
+QDate RecurrenceRule::periodStart(const QDate &date) const
+{
+    switch (freq) {
+    case Frequency::Weekly:
+        return date.addDays(1 - date.dayOfWeek());
+    case Frequency::Monthly:
+        return QDate(date.year(), date.month(), 1);
+    default:
+        return date;
+    }
+}
+
+QDate RecurrenceRule::advancePeriod(const QDate &period, qint64 periods) const
+{
+    switch (freq) {
+    case Frequency::Weekly:
+        return period.addDays(7 * periods);
+    case Frequency::Monthly:
+        return period.addMonths(int(periods));
+    default:
+        return period.addDays(periods);
+    }
+}
+
+QDateTime RecurrenceRule::at(const QDate &date, int minuteOfDay, int second) const
+{
+    return QDateTime(date, QTime(minuteOfDay / 60, minuteOfDay % 60, second), dtstart.timeSpec());
+}
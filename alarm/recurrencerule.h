@@ -0,0 +1,363 @@
+/**
+ * @file recurrencerule.h
+ * @brief Declarations for recurrencerule.
+ * @details Defines a compiled subset of the iCalendar (RFC 5545) RRULE grammar used by alarms.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef RECURRENCERULE_H
+#define RECURRENCERULE_H
+
+#include <QDate>
+#include <QDateTime>
+#include <QList>
+#include <QString>
+
+/**
+ * @brief RecurrenceRule compiled recurrence rule.
+ * @details Parses FREQ (MINUTELY, HOURLY, DAILY, WEEKLY, MONTHLY), INTERVAL,
+ * COUNT, UNTIL, BYDAY (with ordinals for MONTHLY, e.g. 2TU or -1FR),
+ * BYMONTHDAY, BYHOUR, BYMINUTE, BYSETPOS and WKST=MO, plus an optional
+ * DTSTART line. The BY parts are compiled into bit masks, so next() jumps
+ * straight to the interval-aligned period (day, week or month) or grid step
+ * that holds the following occurrence instead of walking day by day.
+ * Examples: "FREQ=WEEKLY;INTERVAL=2;BYDAY=TU" (every other Tuesday),
+ * "FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1" (last weekday of the
+ * month), "FREQ=MINUTELY;INTERVAL=90;BYHOUR=8,9,10,11,12,13,14,15,16,17"
+ * (every 90 minutes from 08:00 until before 18:00). As in RFC 5545,
+ * BYMINUTE expands an HOURLY rule ("FREQ=HOURLY;BYMINUTE=0,30" rings twice
+ * an hour) and limits a MINUTELY one. With COUNT, a Cursor carried between
+ * calls lets next() resume from the last occurrence instead of counting
+ * again from DTSTART.
+ * @note Times are local unless DTSTART ends in Z; TZID parameters are ignored.
+ * @warning Occurrences are produced at whole seconds taken from DTSTART.
+ * @sa SmartClock
+ */
+class RecurrenceRule
+{
+public:
+    /**
+     * @brief Frequency type.
+     * @details Period the INTERVAL counts in.
+     * @sa SmartClock
+     */
+    enum class Frequency {
+        Minutely, ///< Enum value: minutely.
+        Hourly, ///< Enum value: hourly.
+        Daily, ///< Enum value: daily.
+        Weekly, ///< Enum value: weekly, weeks start on Monday.
+        Monthly ///< Enum value: monthly.
+    };
+
+    /**
+     * @brief Cursor Position in the occurrence series.
+     * @details Remembers one occurrence and its 1-based index so COUNT can be continued from there.
+     * @sa SmartClock
+     */
+    struct Cursor {
+        QDateTime occurrence; /**< Last occurrence returned by next(); invalid before the first call. */
+        int index = 0; /**< 1-based position of occurrence in the series; 0 when unknown. */
+    };
+
+/**
+ * @brief Create RecurrenceRule instance.
+ * @details Creates an invalid rule.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    RecurrenceRule() = default;
+
+/**
+ * @brief Parse rule.
+ * @details Accepts "FREQ=...", "RRULE:FREQ=..." or a DTSTART line followed by an RRULE line.
+ * @param text Rule text.
+ * @param error Receives a description of the first problem; cleared on success. May be null.
+ * @return Compiled rule; invalid if the text is malformed or uses unsupported parts.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static RecurrenceRule parse(const QString &text, QString *error = nullptr);
+/**
+ * @brief Parse date-time.
+ * @details Reads the iCalendar forms yyyyMMdd, yyyyMMddTHHmmss and yyyyMMddTHHmmssZ.
+ * @param value Text value.
+ * @return Parsed value; UTC when the text ends in Z, local otherwise, invalid on error.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QDateTime parseDateTime(const QString &value);
+/**
+ * @brief Format date-time.
+ * @details Writes the iCalendar form, with a trailing Z for UTC values.
+ * @param value Date-time value.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QString formatDateTime(const QDateTime &value);
+
+/**
+ * @brief Check whether valid.
+ * @details Returns true once the rule has been parsed successfully.
+ * @return True if the condition holds; false otherwise.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isValid() const;
+/**
+ * @brief Get frequency.
+ * @details Returns the FREQ part.
+ * @return Current value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    Frequency frequency() const;
+/**
+ * @brief Get interval.
+ * @details Returns the INTERVAL part.
+ * @return Current value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int interval() const;
+/**
+ * @brief Get count.
+ * @details Returns the COUNT part.
+ * @return Number of occurrences, or 0 when unbounded.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int count() const;
+/**
+ * @brief Get until.
+ * @details Returns the UNTIL part.
+ * @return Last allowed instant, or an invalid value when unbounded.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime until() const;
+/**
+ * @brief Get start.
+ * @details Returns DTSTART, which anchors INTERVAL and supplies defaults for missing BY parts.
+ * @return Current value; invalid until a start is parsed or set.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime start() const;
+/**
+ * @brief Set start.
+ * @details Replaces DTSTART; milliseconds are dropped and non-UTC values are converted to local time.
+ * @param start Anchor instant.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setStart(const QDateTime &start);
+
+/**
+ * @brief Next occurrence.
+ * @details Returns the first occurrence strictly after the given instant.
+ * @param after Reference instant.
+ * @return Next occurrence, or an invalid value when the rule is invalid, has no start or is exhausted.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime next(const QDateTime &after) const;
+/**
+ * @brief Next occurrence from a cursor.
+ * @details Like next(), but with COUNT resumes from the cursor when it lies at or before the reference instant and restarts from DTSTART otherwise.
+ * @param after Reference instant.
+ * @param cursor Position to resume from; updated to the returned occurrence.
+ * @return Next occurrence, or an invalid value when the rule is invalid, has no start or is exhausted.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime next(const QDateTime &after, Cursor &cursor) const;
+/**
+ * @brief Occurrences in range.
+ * @details Expands the rule between two instants, both inclusive.
+ * @param from First instant.
+ * @param to Last instant.
+ * @param limit Maximum number of results; negative for no limit.
+ * @return Occurrences in ascending order.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QList<QDateTime> occurrences(const QDateTime &from, const QDateTime &to, int limit = -1) const;
+
+/**
+ * @brief Get rule text.
+ * @details Returns the canonical RRULE value without the "RRULE:" prefix.
+ * @return Formatted string value; empty for an invalid rule.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString rruleText() const;
+/**
+ * @brief Convert to string.
+ * @details Returns a DTSTART line (when set) and an RRULE line; parse() reads it back unchanged.
+ * @return Formatted string value; empty for an invalid rule.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString toString() const;
+
+private:
+    /**
+     * @brief NthDay BYDAY entry with an ordinal.
+     * @sa SmartClock
+     */
+    struct NthDay {
+        int ordinal; /**< 1..5 from the start of the month, -1..-5 from its end. */
+        int dayOfWeek; /**< 1 (Monday) to 7 (Sunday). */
+    };
+
+/**
+ * @brief Next without count.
+ * @details Applies UNTIL but ignores COUNT.
+ * @param after Reference instant.
+ * @return Next occurrence or an invalid value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime nextUnbounded(const QDateTime &after) const;
+/**
+ * @brief Next in expanded hours.
+ * @details HOURLY with BYMINUTE: steps over the hour grid and expands each allowed hour into its BYMINUTE instants.
+ * @param after Reference instant in DTSTART's time spec.
+ * @return Next occurrence or an invalid value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime nextInHours(const QDateTime &after) const;
+/**
+ * @brief Next on the minute or hour grid.
+ * @details Steps along DTSTART + k * INTERVAL and skips disallowed stretches by jumping to the next allowed minute.
+ * @param after Reference instant.
+ * @return Next occurrence or an invalid value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime nextOnGrid(const QDateTime &after) const;
+/**
+ * @brief Next in periods.
+ * @details Jumps to the interval-aligned day, week or month holding the instant and scans forward period by period.
+ * @param after Reference instant.
+ * @return Next occurrence or an invalid value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime nextInPeriods(const QDateTime &after) const;
+/**
+ * @brief First in period.
+ * @details Returns the first occurrence in the period after the instant, applying BYSETPOS.
+ * @param period First day of the period.
+ * @param after Reference instant.
+ * @return Occurrence or an invalid value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime firstInPeriod(const QDate &period, const QDateTime &after) const;
+/**
+ * @brief First on date.
+ * @details Returns the first time of day on the date that lies after the instant and not before DTSTART.
+ * @param date Day to search.
+ * @param after Reference instant.
+ * @return Occurrence or an invalid value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime firstOnDate(const QDate &date, const QDateTime &after) const;
+/**
+ * @brief First allowed from.
+ * @details Returns the instant itself if its minute is allowed, else the start of the next allowed minute.
+ * @param t Reference instant.
+ * @return Allowed instant or an invalid value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime firstAllowedFrom(const QDateTime &t) const;
+/**
+ * @brief Dates in period.
+ * @details Lists the days of a period that match BYDAY and BYMONTHDAY.
+ * @param period First day of the period.
+ * @return Dates in ascending order.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QList<QDate> datesInPeriod(const QDate &period) const;
+/**
+ * @brief Month mask.
+ * @details Combines BYMONTHDAY and BYDAY into a day-of-month mask for one month.
+ * @param first First day of the month.
+ * @return Mask with bit d set for each matching day d.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    quint32 monthMask(const QDate &first) const;
+/**
+ * @brief Check whether day matches.
+ * @details Applies the weekday and BYMONTHDAY filters to one day.
+ * @param date Day to test.
+ * @return True if the condition holds; false otherwise.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool dayMatches(const QDate &date) const;
+/**
+ * @brief First minute from.
+ * @details Scans the hour and minute masks for the first allowed minute of day.
+ * @param from Minute of day to start at.
+ * @return Minute of day, or -1 if none is left.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int firstMinuteFrom(int from) const;
+/**
+ * @brief Period start.
+ * @details Returns the first day of the day, week or month holding the date.
+ * @param date Date value.
+ * @return Date value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDate periodStart(const QDate &date) const;
+/**
+ * @brief Advance period.
+ * @details Moves a period start forward by whole periods.
+ * @param period First day of the period.
+ * @param periods Number of periods.
+ * @return Date value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDate advancePeriod(const QDate &period, qint64 periods) const;
+/**
+ * @brief Instant at.
+ * @details Builds an instant in DTSTART's time spec.
+ * @param date Day.
+ * @param minuteOfDay Minute of day.
+ * @param second Second of minute.
+ * @return Date-time value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QDateTime at(const QDate &date, int minuteOfDay, int second) const;
+
+    bool valid = false; /**< Set once parsing succeeded. */
+    Frequency freq = Frequency::Daily; /**< FREQ part. */
+    int step = 1; /**< INTERVAL part. */
+    int maxCount = 0; /**< COUNT part; 0 when unbounded. */
+    QDateTime untilTime; /**< UNTIL part; invalid when unbounded. */
+    QDateTime dtstart; /**< Anchor instant. */
+    quint8 dayMask = 0; /**< BYDAY entries without ordinal, bit (dayOfWeek - 1). */
+    QList<NthDay> nthDays; /**< BYDAY entries with ordinal. */
+    quint32 monthDays = 0; /**< Positive BYMONTHDAY entries, bit d for day d. */
+    quint32 lastMonthDays = 0; /**< Negative BYMONTHDAY entries, bit d for day -d. */
+    quint32 hours = 0; /**< BYHOUR entries, bit h for hour h. */
+    quint64 minutes = 0; /**< BYMINUTE entries, bit m for minute m. */
+    QList<int> setPositions; /**< BYSETPOS entries. */
+};
+
+#endif // RECURRENCERULE_H
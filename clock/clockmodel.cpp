@@ -10,14 +10,24 @@
 
 #include "clockmodel.h"
 #include "jsonclockstorage.h"
+#include "../storage/asyncstorage.h"
 #include <QDateTime>
 #include <QTimeZone>
-#include <QLocale>
+#include <limits>
 #include <utility>
 
+namespace {
+constexpr qint64 kMsPerDay = 24 * 60 * 60 * 1000;
+
+QString twoDigits(int value)
+{
+    return QString::number(value).rightJustified(2, QChar('0'));
+}
+}
+
 ClockModel::ClockModel(QObject *parent, std::unique_ptr<IClockStorage> storage)
     : QObject(parent)
-    , storage(storage ? std::move(storage) : std::make_unique<JsonClockStorage>())
+    , storage(storage ? std::move(storage) : std::make_unique<AsyncStorage<IClockStorage, ClockSnapshot>>(std::make_unique<JsonClockStorage>()))
 {
 }
 
@@ -51,18 +61,70 @@ void ClockModel::removeClock(int index)
 {
     if (index < 0 || index >= clocksList.size())
         return;
-    clocksList.removeAt(index);
+    const QString zone = clocksList.takeAt(index).zone;
+    bool stillUsed = false;
+    for (const auto &ci : clocksList)
+        stillUsed = stillUsed || ci.zone == zone;
+    if (!stillUsed)
+        zoneCache.remove(zone);
     emit clocksChanged();
 }
 
 QString ClockModel::timeTextFor(const ClockInfo &ci) const
 {
-    QTimeZone tz(ci.zone.toUtf8());
-    QDateTime nowTz = QDateTime::currentDateTimeUtc().toTimeZone(tz);
-    QLocale en(QLocale::English);
-    QString fmt = format12 ? "hh:mm:ss AP" : "HH:mm:ss";
-    QString timeText = en.toString(nowTz.time(), fmt);
-    return QString("%1 - %2").arg(QString::fromUtf8(tz.id()), timeText);
+    return timeTextFor(ci, QDateTime::currentMSecsSinceEpoch());
+}
+
+QString ClockModel::timeTextFor(const ClockInfo &ci, qint64 nowMs) const
+{
+    const ZoneCache &z = zoneFor(ci.zone, nowMs);
+    if (!z.valid)
+        return QString("%1 - ").arg(z.label);
+
+    qint64 msOfDay = (nowMs + z.offsetMs) % kMsPerDay;
+    if (msOfDay < 0)
+        msOfDay += kMsPerDay;
+    const int secs = int(msOfDay / 1000);
+    const int h = secs / 3600;
+    const int m = (secs / 60) % 60;
+    const int s = secs % 60;
+
+    QString timeText;
+    if (format12) {
+        const int h12 = h % 12 == 0 ? 12 : h % 12;
+        timeText = twoDigits(h12) + ':' + twoDigits(m) + ':' + twoDigits(s) + (h < 12 ? " AM" : " PM");
+    } else {
+        timeText = twoDigits(h) + ':' + twoDigits(m) + ':' + twoDigits(s);
+    }
+    return z.label + " - " + timeText;
+}
+
+const ClockModel::ZoneCache &ClockModel::zoneFor(const QString &zone, qint64 nowMs) const
+{
+    ZoneCache &z = zoneCache[zone];
+    if (z.validUntilMs > z.validFromMs && nowMs >= z.validFromMs && nowMs < z.validUntilMs)
+        return z;
+
+    const QTimeZone tz(zone.toUtf8());
+    z.label = QString::fromUtf8(tz.id());
+    z.valid = tz.isValid();
+    z.validFromMs = std::numeric_limits<qint64>::min();
+    z.validUntilMs = std::numeric_limits<qint64>::max();
+    if (!z.valid)
+        return z;
+
+    const QDateTime now = QDateTime::fromMSecsSinceEpoch(nowMs, QTimeZone::utc());
+    z.offsetMs = qint64(tz.offsetFromUtc(now)) * 1000;
+    if (tz.hasTransitions()) {
+        const QTimeZone::OffsetData next = tz.nextTransition(now);
+        if (next.atUtc.isValid())
+            z.validUntilMs = next.atUtc.toMSecsSinceEpoch();
+        // previousTransition() is strictly before its argument, so ask from just after now.
+        const QTimeZone::OffsetData prev = tz.previousTransition(now.addMSecs(1));
+        if (prev.atUtc.isValid())
+            z.validFromMs = prev.atUtc.toMSecsSinceEpoch();
+    }
+    return z;
 }
 
 bool ClockModel::load()
@@ -73,6 +135,7 @@ bool ClockModel::load()
     if (!storage->load(snap))
         return false;
     clocksList = snap.clocks;
+    zoneCache.clear();
     format12 = snap.format12h;
     emit formatChanged(format12);
     emit clocksChanged();
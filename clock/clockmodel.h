@@ -13,6 +13,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QHash>
 #include <memory>
 #include "iclockstorage.h"
 
@@ -108,6 +109,16 @@ public:
  * @sa SmartClock
  */
     QString timeTextFor(const ClockInfo &ci) const;
+/**
+ * @brief Time text for.
+ * @details Formats the clock at the given instant, reusing the cached zone offset until its next transition.
+ * @param ci ci value.
+ * @param nowMs Instant in milliseconds since the epoch (UTC).
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString timeTextFor(const ClockInfo &ci, qint64 nowMs) const;
 
 /**
  * @brief Load operation.
@@ -152,6 +163,33 @@ signals:
     void formatChanged(bool enabled);
 
 private:
+/**
+ * @brief ZoneCache type.
+ * @details Resolved zone with the UTC offset valid for [validFromMs, validUntilMs).
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+    struct ZoneCache {
+        QString label; /**< Canonical zone id shown to the user. */
+        bool valid = false; /**< False for unknown zone ids. */
+        qint64 offsetMs = 0; /**< UTC offset in milliseconds. */
+        qint64 validFromMs = 0; /**< Start of the cached offset period. */
+        qint64 validUntilMs = 0; /**< Next transition; the offset must be recomputed from here on. */
+    };
+
+/**
+ * @brief Zone for.
+ * @details Returns the cached zone, resolving it again only outside its valid period.
+ * @param zone Time zone identifier.
+ * @param nowMs Instant in milliseconds since the epoch (UTC).
+ * @return Cached zone state.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    const ZoneCache &zoneFor(const QString &zone, qint64 nowMs) const;
+
+    mutable QHash<QString, ZoneCache> zoneCache; /**< Resolved zones keyed by zone id. */
     QList<ClockInfo> clocksList; /**< Internal state value. */
     bool format12 = false; /**< Internal state value. */
     std::unique_ptr<IClockStorage> storage; /**< Owned storage backend. */
@@ -11,6 +11,7 @@
 #include "clockwindow.h"
 #include "ui_clockwindow.h"
 #include "clocksettingsdialog.h"
+#include "../activitymanager.h"
 #include <QMessageBox>
 #include <QTimeZone>
 #include <QShortcut>
@@ -36,7 +37,11 @@ ClockWindow::ClockWindow(QWidget *parent)
     connect(deleteShortcut, &QShortcut::activated, this, &ClockWindow::onRemoveClock);
 
     connect(&timer, &QTimer::timeout, this, &ClockWindow::updateTime);
-    timer.start(1000);
+    ActivityManager &activity = ActivityManager::instance();
+    activity.watch(this);
+    connect(&activity, &ActivityManager::activeChanged, this, &ClockWindow::onActiveChanged);
+    if (activity.isActive(this))
+        timer.start(1000);
 
     controller = new ClockController(model, this, this);
     ui->checkFormat12->setChecked(model->format12h());
@@ -75,6 +80,18 @@ void ClockWindow::updateTime()
     updateListTexts();
 }
 
+void ClockWindow::onActiveChanged(QWidget *view, bool active)
+{
+    if (view != this)
+        return;
+    if (active) {
+        updateTime();
+        timer.start(1000);
+    } else {
+        timer.stop();
+    }
+}
+
 void ClockWindow::onAddClock()
 {
     ClockSettingsDialog dlg(this);
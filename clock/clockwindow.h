@@ -117,6 +117,15 @@ private slots:
  * @sa SmartClock
  */
     void onToggleFormat(bool checked);
+/**
+ * @brief On active changed.
+ * @details Stops the 1 s refresh while the tab is hidden and catches up when it is shown again.
+ * @param view View whose state changed.
+ * @param active True if the view is on screen.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onActiveChanged(QWidget *view, bool active);
 
 private:
     Ui::ClockWindow *ui;
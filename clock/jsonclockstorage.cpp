@@ -9,6 +9,7 @@
  */
 
 #include "jsonclockstorage.h"
+#include "../storage/atomicfile.h"
 #include "clockmodel.h"
 #include <QStandardPaths>
 #include <QDir>
@@ -22,6 +23,11 @@ JsonClockStorage::JsonClockStorage(const QString &path)
 {
 }
 
+void JsonClockStorage::setBackupEnabled(bool enabled)
+{
+    backupEnabled = enabled;
+}
+
 QString JsonClockStorage::resolvePath() const
 {
     if (!path.isEmpty())
@@ -78,10 +84,5 @@ bool JsonClockStorage::save(const ClockSnapshot &in)
     root["clocks"] = arr;
 
     QJsonDocument doc(root);
-    QFile f(p);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
-        return false;
-    f.write(doc.toJson(QJsonDocument::Indented));
-    f.close();
-    return true;
+    return AtomicFile::write(p, doc.toJson(QJsonDocument::Indented), backupEnabled);
 }
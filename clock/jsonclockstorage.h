@@ -52,6 +52,15 @@ public:
  */
     bool save(const ClockSnapshot &in) override;
 
+/**
+ * @brief Set backup enabled.
+ * @details Updates internal state and emits signals as needed.
+ * @param enabled True to keep the previous file as a rolling .bak on every save.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setBackupEnabled(bool enabled);
+
 private:
 /**
  * @brief Resolve path.
@@ -63,6 +72,7 @@ private:
     QString resolvePath() const;
 
     QString path; /**< Filesystem path. */
+    bool backupEnabled = false; /**< Keep a rolling .bak of the previous file. */
 };
 
 #endif // JSONCLOCKSTORAGE_H
@@ -11,17 +11,19 @@
 #include "alarmcontroller.h"
 #include "../alarm/alarmwindow.h"
 #include <QCoreApplication>
-#include <algorithm>
 
 AlarmController::AlarmController(AlarmManager *model, AlarmWindow *view, QObject *parent)
     : QObject(parent)
     , model(model)
     , view(view)
+    , saver(new DebouncedSaver([model]() { return model->save(); }, this))
 {
     connect(view, &AlarmWindow::addAlarmRequested, this, &AlarmController::onAddAlarmRequested);
     connect(view, &AlarmWindow::removeAlarmsRequested, this, &AlarmController::onRemoveAlarmsRequested);
     connect(view, &AlarmWindow::alarmToggled, this, &AlarmController::onAlarmToggled);
     connect(view, &AlarmWindow::snoozeRequested, this, &AlarmController::onSnoozeRequested);
+    connect(view, &AlarmWindow::importRequested, this, &AlarmController::onImportRequested);
+    connect(view, &AlarmWindow::exportRequested, this, &AlarmController::onExportRequested);
 
     connect(model, &AlarmManager::alarmsUpdated, this, &AlarmController::onModelUpdated);
     connect(model, &AlarmManager::alarmTriggered, view, &AlarmWindow::showAlarmTriggered);
@@ -30,13 +32,15 @@ AlarmController::AlarmController(AlarmManager *model, AlarmWindow *view, QObject
     onModelUpdated();
 
     connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() {
-        this->model->save();
+        saver->markDirty();
+        saver->flush();
     });
+    connect(view, &QObject::destroyed, saver, &DebouncedSaver::flush);
 }
 
 QString AlarmController::nextAlarmString() const
 {
-    const QList<AlarmData> list = model->getAlarms();
+    const QList<AlarmData> &list = model->alarmList();
 
     if (list.isEmpty())
         return "No alarms set";
@@ -73,32 +77,49 @@ QString AlarmController::nextAlarmString() const
 void AlarmController::onAddAlarmRequested(const AlarmData &data)
 {
     model->addAlarm(data);
-    model->save();
+    saver->markDirty();
 }
 
 void AlarmController::onRemoveAlarmsRequested(const QList<int> &rows)
 {
-    QList<int> sorted = rows;
-    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
-    for (int row : sorted) {
-        model->removeAlarm(row);
+    QList<quint64> ids;
+    ids.reserve(rows.size());
+    for (int row : rows) {
+        if (row >= 0 && row < model->alarmCount())
+            ids.append(model->alarmAt(row).id);
     }
-    model->save();
+    for (quint64 id : ids)
+        model->removeAlarmById(id);
+    saver->markDirty();
 }
 
 void AlarmController::onAlarmToggled(int index, bool /*enabled*/)
 {
     model->toggleAlarm(index);
-    model->save();
+    saver->markDirty();
 }
 
 void AlarmController::onSnoozeRequested(const AlarmData &alarm, int minutes)
 {
     model->snoozeAlarm(alarm, minutes);
-    model->save();
+    saver->markDirty();
+}
+
+void AlarmController::onImportRequested(const QString &path)
+{
+    int skipped = 0;
+    const int imported = model->importFromIcs(path, &skipped);
+    if (imported > 0)
+        saver->markDirty();
+    view->showImportResult(imported, skipped);
+}
+
+void AlarmController::onExportRequested(const QString &path)
+{
+    view->showExportResult(model->exportToIcs(path));
 }
 
 void AlarmController::onModelUpdated()
 {
-    view->setAlarms(model->getAlarms());
+    view->setAlarms(model->alarmList());
 }
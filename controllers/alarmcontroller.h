@@ -14,6 +14,7 @@
 #include <QObject>
 #include <QList>
 #include "../alarm/alarmmanager.h"
+#include "../storage/debouncedsaver.h"
 
 /**
  * @brief AlarmWindow Top-level window UI class.
@@ -90,6 +91,22 @@ private slots:
  * @sa SmartClock
  */
     void onSnoozeRequested(const AlarmData &alarm, int minutes);
+/**
+ * @brief On import requested.
+ * @details Imports the calendar file into the model, schedules a save and reports the result through the view.
+ * @param path Filesystem path.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onImportRequested(const QString &path);
+/**
+ * @brief On export requested.
+ * @details Writes the model's alarms to the calendar file and reports the result through the view.
+ * @param path Filesystem path.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onExportRequested(const QString &path);
 /**
  * @brief On model updated.
  * @details Performs the operation and updates state as needed.
@@ -101,6 +118,7 @@ private slots:
 private:
     AlarmManager *model;
     AlarmWindow *view;
+    DebouncedSaver *saver; /**< Coalesces saves after edits. */
 };
 
 #endif // ALARMCONTROLLER_H
@@ -21,6 +21,7 @@ ClockController::ClockController(ClockModel *model, ClockWindow *view, QObject *
     : QObject(parent)
     , model(model)
     , view(view)
+    , saver(new DebouncedSaver([model]() { return model->save(); }, this))
 {
     connect(view, &ClockWindow::addClockRequested, this, &ClockController::onAddClockRequested);
     connect(view, &ClockWindow::removeClocksRequested, this, &ClockController::onRemoveClocksRequested);
@@ -36,14 +37,16 @@ ClockController::ClockController(ClockModel *model, ClockWindow *view, QObject *
     view->syncFromModel();
 
     connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() {
-        this->model->save();
+        saver->markDirty();
+        saver->flush();
     });
+    connect(view, &QObject::destroyed, saver, &DebouncedSaver::flush);
 }
 
 void ClockController::onAddClockRequested(const QString &zone)
 {
     model->addClock(zone);
-    model->save();
+    saver->markDirty();
     view->syncFromModel();
 }
 
@@ -53,13 +56,13 @@ void ClockController::onRemoveClocksRequested(const QList<int> &rows)
     std::sort(sorted.begin(), sorted.end(), std::greater<int>());
     for (int row : sorted)
         model->removeClock(row);
-    model->save();
+    saver->markDirty();
     view->syncFromModel();
 }
 
 void ClockController::onFormatToggled(bool enabled)
 {
     model->setFormat12h(enabled);
-    model->save();
+    saver->markDirty();
     view->syncFromModel();
 }
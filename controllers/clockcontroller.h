@@ -13,6 +13,7 @@
 
 #include <QObject>
 #include "../clock/clockmodel.h"
+#include "../storage/debouncedsaver.h"
 
 /**
  * @brief ClockWindow Top-level window UI class.
@@ -74,6 +75,7 @@ private slots:
 private:
     ClockModel *model;
     ClockWindow *view;
+    DebouncedSaver *saver; /**< Coalesces saves after edits. */
 };
 
 #endif // CLOCKCONTROLLER_H
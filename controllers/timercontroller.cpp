@@ -11,12 +11,12 @@
 #include "timercontroller.h"
 #include "../timer/timerwindow.h"
 #include <QCoreApplication>
-#include <algorithm>
 
 TimerController::TimerController(TimerManager *model, TimerWindow *view, QObject *parent)
     : QObject(parent)
     , model(model)
     , view(view)
+    , saver(new DebouncedSaver([model]() { return model->save(); }, this))
 {
     connect(view, &TimerWindow::addTimerRequested, this, &TimerController::onAddTimerRequested);
     connect(view, &TimerWindow::editTimerRequested, this, &TimerController::onEditTimerRequested);
@@ -26,46 +26,53 @@ TimerController::TimerController(TimerManager *model, TimerWindow *view, QObject
 
     model->load();
     connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() {
-        this->model->save();
+        saver->markDirty();
+        saver->flush();
     });
+    connect(view, &QObject::destroyed, saver, &DebouncedSaver::flush);
 }
 
 void TimerController::onAddTimerRequested(const QString &name, int seconds, const QString &type, const QString &group)
 {
     model->addTimer(name, seconds, type, group);
-    model->save();
+    saver->markDirty();
 }
 
 void TimerController::onEditTimerRequested(int index, const QString &name, int seconds, const QString &type, const QString &group)
 {
     model->editTimer(index, name, seconds, type, group);
-    model->save();
+    saver->markDirty();
 }
 
 void TimerController::onDeleteTimersRequested(const QList<int> &rows)
 {
-    QList<int> sorted = rows;
-    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
-    for (int row : sorted) {
-        model->removeTimer(row);
-    }
-    model->save();
+    model->removeTimers(rows);
+    saver->markDirty();
 }
 
 void TimerController::onStartPauseRequested(const QList<int> &rows)
 {
+    QList<int> toStart;
+    QList<int> toPause;
     for (int row : rows) {
-        const auto timers = model->getTimers();
-        if (row < 0 || row >= timers.size())
+        if (row < 0 || row >= model->timerCount())
             continue;
-        if (timers[row].running)
-            model->pauseTimer(row);
+        if (model->timerAt(row).running)
+            toPause.append(row);
         else
-            model->startTimer(row);
+            toStart.append(row);
+    }
+
+    {
+        TimerManager::UpdateScope batch(model);
+        model->pauseTimers(toPause);
+        model->startTimers(toStart);
     }
+    saver->markDirty();
 }
 
 void TimerController::onSaveRequested()
 {
-    model->save();
+    saver->markDirty();
+    saver->flush();
 }
@@ -14,6 +14,7 @@
 #include <QObject>
 #include <QList>
 #include "../timer/timermanager.h"
+#include "../storage/debouncedsaver.h"
 
 /**
  * @brief TimerWindow Top-level window UI class.
@@ -97,6 +98,7 @@ private slots:
 private:
     TimerManager *model;
     TimerWindow *view;
+    DebouncedSaver *saver; /**< Coalesces saves after edits. */
 };
 
 #endif // TIMERCONTROLLER_H
@@ -0,0 +1,234 @@
+/**
+ * @file controlserver.cpp
+ * @brief Definitions for controlserver.
+ * @details Implements logic declared in the corresponding header for controlserver.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "controlserver.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMetaObject>
+#include <algorithm>
+#include <utility>
+
+ControlServer::ControlServer(QObject *parent)
+    : QObject(parent)
+    , server(new QLocalServer(this))
+{
+    server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(server, &QLocalServer::newConnection, this, &ControlServer::onNewConnection);
+}
+
+ControlServer::~ControlServer()
+{
+    server->close();
+}
+
+bool ControlServer::listen(const QString &name)
+{
+    if (server->listen(name))
+        return true;
+    if (server->serverError() != QAbstractSocket::AddressInUseError)
+        return false;
+
+    // Only reclaim the name if nobody answers on it.
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (probe.waitForConnected(100))
+        return false;
+    QLocalServer::removeServer(name);
+    return server->listen(name);
+}
+
+QString ControlServer::serverName() const
+{
+    return server->fullServerName();
+}
+
+void ControlServer::registerCommand(const QByteArray &verb, Handler handler)
+{
+    handlers.insert(verb.toLower(), std::move(handler));
+}
+
+QByteArray ControlServer::execute(const QByteArray &line) const
+{
+    return dispatch(nullptr, splitArguments(line));
+}
+
+QByteArray ControlServer::dispatch(Connection *connection, const QList<QByteArray> &tokens) const
+{
+    if (tokens.isEmpty())
+        return "ERR empty request";
+
+    const QByteArray verb = tokens.first().toLower();
+    if (verb == "subscribe" || verb == "unsubscribe") {
+        if (!connection)
+            return "ERR no connection";
+        QList<QByteArray> topics = tokens.mid(1);
+        if (topics.isEmpty())
+            topics.append("*");
+        for (const QByteArray &topic : topics) {
+            if (verb == "subscribe")
+                connection->topics.insert(topic.toLower());
+            else if (topic == "*")
+                connection->topics.clear();
+            else
+                connection->topics.remove(topic.toLower());
+        }
+        return "OK";
+    }
+
+    const auto it = handlers.constFind(verb);
+    if (it == handlers.cend())
+        return "ERR unknown command " + tokens.first();
+
+    const Reply reply = it.value()(tokens.mid(1));
+    QByteArray out = reply.ok ? QByteArray("OK") : QByteArray("ERR");
+    if (!reply.payload.isEmpty())
+        out += ' ' + reply.payload;
+    return out;
+}
+
+QList<QByteArray> ControlServer::splitArguments(const QByteArray &line)
+{
+    QList<QByteArray> tokens;
+    QByteArray current;
+    bool inToken = false;
+    bool quoted = false;
+    for (int i = 0; i < line.size(); ++i) {
+        const char c = line.at(i);
+        if (quoted) {
+            if (c == '\\' && i + 1 < line.size()) {
+                const char escaped = line.at(++i);
+                current += escaped == 'n' ? '\n' : escaped == 'r' ? '\r' : escaped;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                current += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+            inToken = true;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            if (inToken)
+                tokens.append(current);
+            current.clear();
+            inToken = false;
+        } else {
+            current += c;
+            inToken = true;
+        }
+    }
+    if (inToken)
+        tokens.append(current);
+    return tokens;
+}
+
+QByteArray ControlServer::quote(const QByteArray &value)
+{
+    // Spaces and control characters (newlines above all) must never appear bare.
+    const bool plain = !value.isEmpty() && std::none_of(value.cbegin(), value.cend(), [](char c) {
+        return uchar(c) <= ' ' || c == 0x7F || c == '"' || c == '\\';
+    });
+    if (plain)
+        return value;
+
+    QByteArray out = "\"";
+    for (const char c : value) {
+        if (c == '\n') {
+            out += "\\n";
+        } else if (c == '\r') {
+            out += "\\r";
+        } else {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            out += c;
+        }
+    }
+    return out + '"';
+}
+
+void ControlServer::publish(const QByteArray &topic, const QByteArray &payload)
+{
+    const QByteArray line = "! " + topic + ' ' + payload + '\n';
+    QList<QLocalSocket *> targets;
+    for (auto it = clients.cbegin(); it != clients.cend(); ++it) {
+        if (it.value().topics.contains(topic) || it.value().topics.contains("*"))
+            targets.append(it.key());
+    }
+    for (QLocalSocket *socket : std::as_const(targets))
+        send(socket, line);
+}
+
+int ControlServer::subscriberCount() const
+{
+    int count = 0;
+    for (const Connection &connection : clients) {
+        if (!connection.topics.isEmpty())
+            ++count;
+    }
+    return count;
+}
+
+void ControlServer::onNewConnection()
+{
+    while (QLocalSocket *socket = server->nextPendingConnection()) {
+        clients.insert(socket, Connection());
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { handleReadyRead(socket); });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+            clients.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void ControlServer::send(QLocalSocket *socket, const QByteArray &data)
+{
+    auto found = clients.find(socket);
+    if (found == clients.end() || found.value().closing)
+        return;
+    socket->write(data);
+    socket->flush();
+    if (socket->bytesToWrite() > kMaxBacklogBytes) {
+        // Deferred, because a batch may still hold this client's state.
+        found.value().closing = true;
+        QMetaObject::invokeMethod(socket, &QLocalSocket::abort, Qt::QueuedConnection);
+    }
+}
+
+void ControlServer::handleReadyRead(QLocalSocket *socket)
+{
+    auto found = clients.find(socket);
+    if (found == clients.end() || found.value().closing)
+        return;
+    Connection &connection = found.value();
+    connection.buffer += socket->readAll();
+
+    QByteArray replies;
+    qsizetype start = 0;
+    qsizetype end = connection.buffer.indexOf('\n');
+    if (end >= 0) {
+        emit batchStarted();
+        for (; end >= 0; end = connection.buffer.indexOf('\n', start)) {
+            replies += dispatch(&connection, splitArguments(connection.buffer.mid(start, end - start)));
+            replies += '\n';
+            start = end + 1;
+        }
+        emit batchFinished();
+    }
+    connection.buffer.remove(0, start);
+
+    if (connection.buffer.size() > kMaxLineBytes) {
+        replies += "ERR request too long\n";
+        connection.buffer.clear();
+        socket->write(replies);
+        socket->disconnectFromServer();
+        return;
+    }
+    if (!replies.isEmpty())
+        send(socket, replies);
+}
@@ -0,0 +1,212 @@
+/**
+ * @file controlserver.h
+ * @brief Declarations for controlserver.
+ * @details Defines the local-socket control channel of the headless daemon.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef CONTROLSERVER_H
+#define CONTROLSERVER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <functional>
+
+class QLocalServer;
+class QLocalSocket;
+
+/**
+ * @brief ControlServer local control endpoint.
+ * @details Listens on a QLocalServer (a Unix domain socket or a named pipe)
+ * and speaks a line protocol: each request is one line "verb arg...", with
+ * arguments separated by spaces and double quotes around arguments that
+ * contain spaces. Each request gets exactly one reply line, "OK [payload]"
+ * or "ERR message", in request order, so clients may pipeline requests.
+ * All replies produced by one read are written back in a single batch.
+ * Clients may "subscribe [topic...]" to events; each published event is
+ * one line "! topic payload", which can arrive between replies.
+ * @note Only the current user may connect to the socket.
+ * @warning Handlers run on the GUI/event thread and must not block.
+ * @sa SmartClock
+ */
+class ControlServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Reply Result of one command.
+     * @sa SmartClock
+     */
+    struct Reply {
+        bool ok = true; /**< False to answer with ERR. */
+        QByteArray payload; /**< Text after OK or ERR; must not contain newlines. */
+    };
+
+    using Handler = std::function<Reply(const QList<QByteArray> &args)>; /**< Command callback. */
+
+    static constexpr int kMaxLineBytes = 64 * 1024; /**< Longest accepted request line. */
+    static constexpr qint64 kMaxBacklogBytes = 4 * 1024 * 1024; /**< Unsent output after which a client is dropped. */
+
+/**
+ * @brief Create ControlServer instance.
+ * @details Initializes instance state.
+ * @param parent Parent QObject.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit ControlServer(QObject *parent = nullptr);
+/**
+ * @brief Destroy ControlServer instance.
+ * @details Closes the server and its connections.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ~ControlServer() override;
+
+/**
+ * @brief Listen.
+ * @details Starts listening on the socket name; a stale socket left by a crashed daemon is removed, a live one is not.
+ * @param name Local socket name or path.
+ * @return True on success; false if another instance is listening or the socket cannot be created.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool listen(const QString &name);
+/**
+ * @brief Get server name.
+ * @details Returns the full socket path while listening.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString serverName() const;
+/**
+ * @brief Register command.
+ * @details Installs or replaces the handler for a verb.
+ * @param verb Lower-case command name.
+ * @param handler Callback producing the reply.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void registerCommand(const QByteArray &verb, Handler handler);
+/**
+ * @brief Execute line.
+ * @details Parses and dispatches one request line without a socket.
+ * @param line Request line without the newline.
+ * @return Reply line without the newline.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QByteArray execute(const QByteArray &line) const;
+/**
+ * @brief Split arguments.
+ * @details Tokenizes a request line on spaces, honouring double quotes and backslash escapes inside them;
+ * "\n" and "\r" inside quotes decode to a newline and a carriage return.
+ * @param line Request line.
+ * @return Tokens, verb first.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QList<QByteArray> splitArguments(const QByteArray &line);
+/**
+ * @brief Quote argument.
+ * @details Quotes a value so splitArguments() reads it back as one token. Values with spaces or
+ * control characters are always quoted, and newlines are escaped so the result stays on one line.
+ * @param value Raw value.
+ * @return Quoted value, or the value itself when no quoting is needed.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QByteArray quote(const QByteArray &value);
+/**
+ * @brief Publish event.
+ * @details Writes "! topic payload" to every client subscribed to the topic or to all topics.
+ * @param topic Event topic, e.g. "timer".
+ * @param payload Event text; must not contain newlines.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void publish(const QByteArray &topic, const QByteArray &payload);
+/**
+ * @brief Get subscriber count.
+ * @details Returns how many clients receive at least one topic.
+ * @return Number of items.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int subscriberCount() const;
+
+signals:
+/**
+ * @brief Batch started.
+ * @details Emitted before the requests of one read are run, so listeners can coalesce change notifications.
+ * @sa SmartClock
+ */
+    void batchStarted();
+/**
+ * @brief Batch finished.
+ * @details Emitted after the requests of one read have run, before their replies are written.
+ * @sa SmartClock
+ */
+    void batchFinished();
+
+private slots:
+/**
+ * @brief On new connection.
+ * @details Accepts pending clients and wires their sockets.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onNewConnection();
+
+private:
+    /**
+     * @brief Connection Per-client state.
+     * @sa SmartClock
+     */
+    struct Connection {
+        QByteArray buffer; /**< Unterminated input. */
+        QSet<QByteArray> topics; /**< Subscribed topics; "*" for all. */
+        bool closing = false; /**< Set once the client is being dropped. */
+    };
+
+/**
+ * @brief Dispatch.
+ * @details Runs one tokenized request; subscription verbs apply to the given client.
+ * @param connection Requesting client, or null without a socket.
+ * @param tokens Request tokens, verb first.
+ * @return Reply line without the newline.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QByteArray dispatch(Connection *connection, const QList<QByteArray> &tokens) const;
+/**
+ * @brief Send.
+ * @details Queues output on a client and drops clients that stopped reading.
+ * @param socket Client socket.
+ * @param data Bytes to write.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void send(QLocalSocket *socket, const QByteArray &data);
+/**
+ * @brief Handle ready read.
+ * @details Runs every complete line buffered on the socket and writes the replies in one batch.
+ * @param socket Client socket.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void handleReadyRead(QLocalSocket *socket);
+
+    QLocalServer *server; /**< Listening endpoint. */
+    QHash<QByteArray, Handler> handlers; /**< Commands by verb. */
+    QHash<QLocalSocket *, Connection> clients; /**< State per connected client. */
+};
+
+#endif // CONTROLSERVER_H
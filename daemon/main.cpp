@@ -0,0 +1,101 @@
+/**
+ * @file main.cpp
+ * @brief Definitions for the smartclockd entry point.
+ * @details Implements the headless daemon executable around SmartClockDaemon.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include "smartclockdaemon.h"
+#include "../storage/instancelock.h"
+
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef Q_OS_UNIX
+int signalPipe[2] = {-1, -1};
+
+// Only async-signal-safe work here; the event loop picks the byte up.
+void onSignal(int)
+{
+    const char byte = 1;
+    [[maybe_unused]] const ssize_t n = ::write(signalPipe[0], &byte, 1);
+}
+
+// Routes SIGTERM/SIGINT into QCoreApplication::quit() so state is flushed on exit.
+void installQuitOnSignals(QCoreApplication &app)
+{
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalPipe) != 0)
+        return;
+    auto *notifier = new QSocketNotifier(signalPipe[1], QSocketNotifier::Read, &app);
+    QObject::connect(notifier, &QSocketNotifier::activated, &app, [notifier]() {
+        notifier->setEnabled(false);
+        char byte;
+        [[maybe_unused]] const ssize_t n = ::read(signalPipe[1], &byte, 1);
+        QCoreApplication::quit();
+    });
+
+    struct sigaction action = {};
+    action.sa_handler = onSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    ::sigaction(SIGTERM, &action, nullptr);
+    ::sigaction(SIGINT, &action, nullptr);
+}
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    QElapsedTimer startup;
+    startup.start();
+
+    QCoreApplication app(argc, argv);
+    // Same AppDataLocation as the GUI, so both see one set of timers and alarms;
+    // InstanceLock keeps the two from running against those files at once.
+    QCoreApplication::setApplicationName("SmartClock");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless SmartClock timer and alarm service.");
+    parser.addHelpOption();
+    const QCommandLineOption socketOption("socket", "Control socket name.", "name", "smartclockd");
+    const QCommandLineOption timerOption("on-timer", "Command run when a timer finishes.", "command");
+    const QCommandLineOption alarmOption("on-alarm", "Command run when an alarm fires.", "command");
+    const QCommandLineOption noControlOption("no-control", "Do not open the control socket.");
+    parser.addOptions({socketOption, timerOption, alarmOption, noControlOption});
+    parser.process(app);
+
+    InstanceLock lock;
+    if (!lock.tryLock()) {
+        qCritical("smartclockd: another SmartClock process holds %s", qPrintable(lock.path()));
+        return 1;
+    }
+
+    SmartClockDaemon::Options options;
+    options.socketName = parser.value(socketOption);
+    options.timerCommand = parser.value(timerOption);
+    options.alarmCommand = parser.value(alarmOption);
+    options.control = !parser.isSet(noControlOption);
+
+    SmartClockDaemon daemon(options);
+    QObject::connect(&daemon, &SmartClockDaemon::quitRequested, &app, &QCoreApplication::quit);
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, &daemon, &SmartClockDaemon::shutdown);
+#ifdef Q_OS_UNIX
+    installQuitOnSignals(app);
+#endif
+
+    if (!daemon.start())
+        return 1;
+    qInfo("smartclockd: ready in %lld ms", static_cast<long long>(startup.elapsed()));
+    return app.exec();
+}
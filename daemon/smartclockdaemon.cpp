@@ -0,0 +1,351 @@
+/**
+ * @file smartclockdaemon.cpp
+ * @brief Definitions for smartclockdaemon.
+ * @details Implements logic declared in the corresponding header for smartclockdaemon.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "smartclockdaemon.h"
+#include "../alarm/recurrencerule.h"
+#include "../storage/debouncedsaver.h"
+#include <QDateTime>
+#include <QProcess>
+#include <QtGlobal>
+
+namespace {
+QByteArray statusName(TimerStatus status)
+{
+    switch (status) {
+    case TimerStatus::Running:
+        return "running";
+    case TimerStatus::Paused:
+        return "paused";
+    case TimerStatus::Finished:
+        return "finished";
+    }
+    return "paused";
+}
+
+bool parseId(const QByteArray &text, quint64 &id)
+{
+    bool ok = false;
+    id = text.toULongLong(&ok);
+    return ok && id != 0;
+}
+
+QByteArray quotedName(const QString &name)
+{
+    return ControlServer::quote(name.toUtf8());
+}
+
+ControlServer::Reply error(const QByteArray &message)
+{
+    return ControlServer::Reply{false, message};
+}
+}
+
+SmartClockDaemon::SmartClockDaemon(const Options &options,
+                                   std::unique_ptr<ITimerStorage> timerStorage,
+                                   std::unique_ptr<IAlarmStorage> alarmStorage,
+                                   std::unique_ptr<IStopwatchStorage> stopwatchStorage,
+                                   QObject *parent)
+    : QObject(parent)
+    , options(options)
+    , timerManager(new TimerManager(this, std::move(timerStorage)))
+    , alarmManager(new AlarmManager(this, std::move(alarmStorage)))
+    , stopwatchModel(new StopwatchModel(this, std::move(stopwatchStorage)))
+    , timerSaver(new DebouncedSaver([this]() { return timerManager->save(); }, this))
+    , alarmSaver(new DebouncedSaver([this]() { return alarmManager->save(); }, this))
+    , stopwatchSaver(new DebouncedSaver([this]() { return stopwatchModel->save(); }, this))
+    , server(new ControlServer(this))
+{
+    timerSaver->setDelay(options.saveDelayMs);
+    alarmSaver->setDelay(options.saveDelayMs);
+    stopwatchSaver->setDelay(options.saveDelayMs);
+
+    // Ticks only move "remaining" forward from lastUpdated, so state is
+    // written on transitions rather than on every timersChanged.
+    connect(timerManager, &TimerManager::timerCompleted, this, &SmartClockDaemon::onTimerCompleted);
+    connect(alarmManager, &AlarmManager::alarmTriggered, this, &SmartClockDaemon::onAlarmTriggered);
+
+    // One timersChanged per pipelined read instead of one per command.
+    connect(server, &ControlServer::batchStarted, timerManager, &TimerManager::beginUpdate);
+    connect(server, &ControlServer::batchFinished, timerManager, &TimerManager::endUpdate);
+
+    registerCommands();
+}
+
+SmartClockDaemon::~SmartClockDaemon()
+{
+    shutdown();
+}
+
+bool SmartClockDaemon::start()
+{
+    timerManager->load();
+    alarmManager->load();
+    stopwatchModel->load();
+
+    if (!options.control)
+        return true;
+    if (!server->listen(options.socketName)) {
+        qWarning("smartclockd: cannot listen on %s", qPrintable(options.socketName));
+        return false;
+    }
+    return true;
+}
+
+void SmartClockDaemon::shutdown()
+{
+    timerSaver->flush();
+    alarmSaver->flush();
+    stopwatchSaver->flush();
+}
+
+TimerManager *SmartClockDaemon::timers() const
+{
+    return timerManager;
+}
+
+AlarmManager *SmartClockDaemon::alarms() const
+{
+    return alarmManager;
+}
+
+StopwatchModel *SmartClockDaemon::stopwatch() const
+{
+    return stopwatchModel;
+}
+
+ControlServer *SmartClockDaemon::controlServer() const
+{
+    return server;
+}
+
+void SmartClockDaemon::onTimerCompleted(quint64 id)
+{
+    const int index = timerManager->indexOfId(id);
+    const QString name = index >= 0 ? timerManager->timerAt(index).name : QString();
+    runAction(options.timerCommand, QStringLiteral("timer"), name);
+    server->publish("timer", "finished " + QByteArray::number(id) + ' ' + quotedName(name));
+    timerSaver->markDirty();
+}
+
+void SmartClockDaemon::onAlarmTriggered(const AlarmData &alarm)
+{
+    runAction(options.alarmCommand, QStringLiteral("alarm"), alarm.name);
+    server->publish("alarm", "triggered " + QByteArray::number(alarm.id) + ' ' + quotedName(alarm.name));
+    alarmSaver->markDirty();
+}
+
+void SmartClockDaemon::runAction(const QString &command, const QString &kind, const QString &name)
+{
+    qInfo("smartclockd: %s \"%s\" fired", qPrintable(kind), qPrintable(name));
+
+    QStringList args = QProcess::splitCommand(command);
+    if (!args.isEmpty()) {
+        const QString program = args.takeFirst();
+        args << kind << name;
+        if (!QProcess::startDetached(program, args))
+            qWarning("smartclockd: failed to start %s", qPrintable(program));
+    }
+    emit actionFired(kind, name);
+}
+
+void SmartClockDaemon::registerCommands()
+{
+    server->registerCommand("ping", [](const QList<QByteArray> &) {
+        return ControlServer::Reply{true, "pong"};
+    });
+    server->registerCommand("status", [this](const QList<QByteArray> &) {
+        const QByteArray payload = "timers=" + QByteArray::number(timerManager->timerCount())
+            + " running=" + QByteArray::number(timerManager->countByStatus(TimerStatus::Running))
+            + " alarms=" + QByteArray::number(alarmManager->alarmCount())
+            + " enabled=" + QByteArray::number(alarmManager->countEnabled());
+        return ControlServer::Reply{true, payload};
+    });
+    server->registerCommand("save", [this](const QList<QByteArray> &) {
+        timerSaver->markDirty();
+        alarmSaver->markDirty();
+        stopwatchSaver->markDirty();
+        const bool timersOk = timerSaver->flush();
+        const bool alarmsOk = alarmSaver->flush();
+        const bool stopwatchOk = stopwatchSaver->flush();
+        return timersOk && alarmsOk && stopwatchOk ? ControlServer::Reply{} : error("save failed");
+    });
+    server->registerCommand("quit", [this](const QList<QByteArray> &) {
+        // Let the reply go out before the event loop stops.
+        QMetaObject::invokeMethod(this, &SmartClockDaemon::quitRequested, Qt::QueuedConnection);
+        return ControlServer::Reply{};
+    });
+    server->registerCommand("timer", [this](const QList<QByteArray> &args) { return timerCommand(args); });
+    server->registerCommand("alarm", [this](const QList<QByteArray> &args) { return alarmCommand(args); });
+    server->registerCommand("stopwatch", [this](const QList<QByteArray> &args) { return stopwatchCommand(args); });
+}
+
+QByteArray SmartClockDaemon::timerSlots(const QList<QByteArray> &ids, QList<int> &out) const
+{
+    if (ids.isEmpty())
+        return "missing timer id";
+    out.clear();
+    out.reserve(ids.size());
+    for (const QByteArray &text : ids) {
+        quint64 id = 0;
+        const int index = parseId(text, id) ? timerManager->indexOfId(id) : -1;
+        if (index < 0)
+            return "unknown timer " + text;
+        out.append(index);
+    }
+    return {};
+}
+
+ControlServer::Reply SmartClockDaemon::timerCommand(const QList<QByteArray> &args)
+{
+    const QByteArray sub = args.value(0).toLower();
+    const QList<QByteArray> rest = args.mid(1);
+
+    if (sub == "add") {
+        bool ok = false;
+        const int seconds = rest.value(1).toInt(&ok);
+        if (rest.value(0).isEmpty() || !ok || seconds <= 0)
+            return error("usage: timer add <name> <seconds> [type] [group]");
+        const QString type = rest.size() > 2 ? QString::fromUtf8(rest.at(2)) : QStringLiteral("Normal");
+        timerManager->addTimer(QString::fromUtf8(rest.at(0)), seconds, type, QString::fromUtf8(rest.value(3)));
+        timerSaver->markDirty();
+        return {true, QByteArray::number(timerManager->timerList().last().id)};
+    }
+    if (sub == "list") {
+        QByteArray ids;
+        for (const TimerData &t : timerManager->timerList()) {
+            if (!ids.isEmpty())
+                ids += ' ';
+            ids += QByteArray::number(t.id);
+        }
+        return {true, ids};
+    }
+
+    QList<int> indices;
+    const QByteArray failure = timerSlots(rest, indices);
+    if (!failure.isEmpty())
+        return error(failure);
+
+    if (sub == "start") {
+        timerManager->startTimers(indices);
+    } else if (sub == "pause") {
+        timerManager->pauseTimers(indices);
+    } else if (sub == "remove") {
+        timerManager->removeTimers(indices);
+    } else if (sub == "get") {
+        const TimerData &t = timerManager->timerAt(indices.first());
+        const int remaining = timerManager->remainingSeconds(indices.first(), QDateTime::currentMSecsSinceEpoch());
+        return {true, "id=" + QByteArray::number(t.id) + " state=" + statusName(t.status)
+                          + " remaining=" + QByteArray::number(remaining)
+                          + " duration=" + QByteArray::number(t.duration)
+                          + " name=" + quotedName(t.name)};
+    } else {
+        return error("unknown timer command " + sub);
+    }
+    timerSaver->markDirty();
+    return {};
+}
+
+ControlServer::Reply SmartClockDaemon::alarmCommand(const QList<QByteArray> &args)
+{
+    const QByteArray sub = args.value(0).toLower();
+    const QList<QByteArray> rest = args.mid(1);
+
+    if (sub == "add") {
+        const QString timeText = QString::fromUtf8(rest.value(1));
+        QTime time = QTime::fromString(timeText, "H:mm");
+        if (!time.isValid())
+            time = QTime::fromString(timeText, "H:mm:ss");
+        if (rest.value(0).isEmpty() || !time.isValid())
+            return error("usage: alarm add <name> <HH:mm[:ss]> [repeat|RRULE]");
+
+        AlarmData a;
+        a.name = QString::fromUtf8(rest.at(0));
+        a.time = time;
+        a.snooze = false;
+        a.enabled = true;
+        const QString repeat = QString::fromUtf8(rest.value(2));
+        if (repeat.contains('=')) {
+            QString why;
+            if (!RecurrenceRule::parse(repeat, &why).isValid())
+                return error("invalid rule: " + why.toUtf8());
+            a.recurrence = repeat;
+        } else if (!repeat.isEmpty()) {
+            a.repeatMode = repeatModeFromString(repeat);
+            if (a.repeatMode == RepeatMode::Never && repeat.compare("Never", Qt::CaseInsensitive) != 0)
+                return error("unknown repeat " + rest.at(2));
+            if (a.repeatMode == RepeatMode::SpecificDays)
+                return error("specific days need an RRULE with BYDAY");
+        }
+        alarmManager->addAlarm(a);
+        alarmSaver->markDirty();
+        return {true, QByteArray::number(alarmManager->alarmList().last().id)};
+    }
+    if (sub == "list") {
+        QByteArray ids;
+        for (const AlarmData &a : alarmManager->alarmList()) {
+            if (!ids.isEmpty())
+                ids += ' ';
+            ids += QByteArray::number(a.id);
+        }
+        return {true, ids};
+    }
+
+    quint64 id = 0;
+    const int index = parseId(rest.value(0), id) ? alarmManager->indexOfId(id) : -1;
+    if (index < 0)
+        return error(rest.isEmpty() ? QByteArray("missing alarm id") : "unknown alarm " + rest.first());
+
+    if (sub == "enable" || sub == "disable") {
+        if (alarmManager->alarmAt(index).enabled != (sub == "enable"))
+            alarmManager->toggleAlarm(index);
+    } else if (sub == "remove") {
+        alarmManager->removeAlarm(index);
+    } else if (sub == "get") {
+        const AlarmData &a = alarmManager->alarmAt(index);
+        const QByteArray next = a.enabled && a.nextTrigger.isValid()
+            ? a.nextTrigger.toString(Qt::ISODate).toUtf8() : QByteArray("-");
+        return {true, "id=" + QByteArray::number(a.id) + " enabled=" + QByteArray::number(a.enabled ? 1 : 0)
+                          + " time=" + a.time.toString("HH:mm:ss").toUtf8()
+                          + " next=" + next
+                          + " name=" + quotedName(a.name)};
+    } else {
+        return error("unknown alarm command " + sub);
+    }
+    alarmSaver->markDirty();
+    return {};
+}
+
+ControlServer::Reply SmartClockDaemon::stopwatchCommand(const QList<QByteArray> &args)
+{
+    const QByteArray sub = args.value(0).toLower();
+
+    if (sub == "get") {
+        return {true, "running=" + QByteArray::number(stopwatchModel->isRunning() ? 1 : 0)
+                          + " elapsed_ms=" + QByteArray::number(stopwatchModel->elapsedMs())
+                          + " laps=" + QByteArray::number(stopwatchModel->lapDurations().size())};
+    }
+    if (sub == "start") {
+        stopwatchModel->start();
+    } else if (sub == "pause" || sub == "stop") {
+        stopwatchModel->stop();
+    } else if (sub == "reset") {
+        stopwatchModel->reset();
+    } else if (sub == "lap") {
+        if (!stopwatchModel->isRunning())
+            return error("stopwatch is not running");
+        stopwatchModel->addLap();
+        stopwatchSaver->markDirty();
+        return {true, QByteArray::number(stopwatchModel->lapDurations().size())};
+    } else {
+        return error("unknown stopwatch command " + sub);
+    }
+    stopwatchSaver->markDirty();
+    return {};
+}
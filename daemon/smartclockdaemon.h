@@ -0,0 +1,228 @@
+/**
+ * @file smartclockdaemon.h
+ * @brief Declarations for smartclockdaemon.
+ * @details Defines the headless service that runs timers and alarms without a UI.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef SMARTCLOCKDAEMON_H
+#define SMARTCLOCKDAEMON_H
+
+#include <QObject>
+#include <QString>
+#include <memory>
+
+#include "../alarm/alarmmanager.h"
+#include "../stopwatch/stopwatchmodel.h"
+#include "../timer/timermanager.h"
+#include "controlserver.h"
+
+class DebouncedSaver;
+
+/**
+ * @brief SmartClockDaemon headless timer and alarm service.
+ * @details Owns a TimerManager, an AlarmManager and a StopwatchModel on a
+ * QCoreApplication, loads their state from the same files the GUI uses,
+ * keeps it saved through debounced writes, and runs a configured command
+ * whenever a timer finishes or an alarm fires. A ControlServer gives local
+ * clients "timer", "alarm" and "stopwatch" commands and publishes
+ * "! timer finished <id> <name>" and "! alarm triggered <id> <name>" events.
+ * Nothing here links against Gui, Widgets or Multimedia, which keeps
+ * startup fast and the resident footprint small.
+ * @note Run either the daemon or the GUI against one state directory; both write the same files.
+ * @warning Actions are started detached and are never waited for.
+ * @sa SmartClock
+ */
+class SmartClockDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Options Daemon configuration.
+     * @sa SmartClock
+     */
+    struct Options {
+        QString socketName = QStringLiteral("smartclockd"); /**< Control socket name. */
+        QString timerCommand; /**< Command run when a timer finishes; empty for none. */
+        QString alarmCommand; /**< Command run when an alarm fires; empty for none. */
+        bool control = true; /**< False to run without a control socket. */
+        int saveDelayMs = 500; /**< Quiet period before state is written. */
+    };
+
+/**
+ * @brief Create SmartClockDaemon instance.
+ * @details Initializes instance state; models use their default storages unless storages are given.
+ * @param options Daemon configuration.
+ * @param timerStorage Timer storage backend, or null for the default.
+ * @param alarmStorage Alarm storage backend, or null for the default.
+ * @param stopwatchStorage Stopwatch storage backend, or null for the default.
+ * @param parent Parent QObject.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit SmartClockDaemon(const Options &options,
+                              std::unique_ptr<ITimerStorage> timerStorage = {},
+                              std::unique_ptr<IAlarmStorage> alarmStorage = {},
+                              std::unique_ptr<IStopwatchStorage> stopwatchStorage = {},
+                              QObject *parent = nullptr);
+/**
+ * @brief Destroy SmartClockDaemon instance.
+ * @details Flushes unsaved state.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ~SmartClockDaemon() override;
+
+/**
+ * @brief Start.
+ * @details Loads saved state, arms timers and alarms and opens the control socket.
+ * @return True on success; false if the control socket cannot be opened.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool start();
+/**
+ * @brief Shutdown.
+ * @details Writes pending state and closes the control socket.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void shutdown();
+
+/**
+ * @brief Get timers.
+ * @details Returns the timer manager.
+ * @return Pointer owned by the daemon.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    TimerManager *timers() const;
+/**
+ * @brief Get alarms.
+ * @details Returns the alarm manager.
+ * @return Pointer owned by the daemon.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    AlarmManager *alarms() const;
+/**
+ * @brief Get stopwatch.
+ * @details Returns the stopwatch model.
+ * @return Pointer owned by the daemon.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    StopwatchModel *stopwatch() const;
+/**
+ * @brief Get control server.
+ * @details Returns the control endpoint; it only listens after start().
+ * @return Pointer owned by the daemon.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ControlServer *controlServer() const;
+
+signals:
+/**
+ * @brief Action fired.
+ * @details Emitted after a timer finished or an alarm fired and its command was started.
+ * @param kind "timer" or "alarm".
+ * @param name Timer or alarm name.
+ * @sa SmartClock
+ */
+    void actionFired(const QString &kind, const QString &name);
+/**
+ * @brief Quit requested.
+ * @details Emitted when a control client asks the daemon to exit.
+ * @sa SmartClock
+ */
+    void quitRequested();
+
+private slots:
+/**
+ * @brief On timer completed.
+ * @details Runs the timer command, publishes the event and schedules a save.
+ * @param id Stable timer id.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onTimerCompleted(quint64 id);
+/**
+ * @brief On alarm triggered.
+ * @details Runs the alarm command, publishes the event and schedules a save.
+ * @param alarm Alarm that fired.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onAlarmTriggered(const AlarmData &alarm);
+
+private:
+/**
+ * @brief Run action.
+ * @details Starts the command detached with the kind and name appended as arguments.
+ * @param command Command line; empty to do nothing.
+ * @param kind "timer" or "alarm".
+ * @param name Timer or alarm name.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void runAction(const QString &command, const QString &kind, const QString &name);
+/**
+ * @brief Register commands.
+ * @details Installs the built-in control verbs.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void registerCommands();
+/**
+ * @brief Timer command.
+ * @details Handles "timer add|start|pause|remove|get|list".
+ * @param args Subcommand and its arguments.
+ * @return Command reply.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ControlServer::Reply timerCommand(const QList<QByteArray> &args);
+/**
+ * @brief Alarm command.
+ * @details Handles "alarm add|enable|disable|remove|get|list".
+ * @param args Subcommand and its arguments.
+ * @return Command reply.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ControlServer::Reply alarmCommand(const QList<QByteArray> &args);
+/**
+ * @brief Stopwatch command.
+ * @details Handles "stopwatch start|pause|reset|lap|get".
+ * @param args Subcommand and its arguments.
+ * @return Command reply.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ControlServer::Reply stopwatchCommand(const QList<QByteArray> &args);
+/**
+ * @brief Timer slots.
+ * @details Resolves id arguments to timer indices.
+ * @param ids Id arguments; at least one.
+ * @param out Receives the indices.
+ * @return Empty on success; otherwise the error text.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QByteArray timerSlots(const QList<QByteArray> &ids, QList<int> &out) const;
+
+    Options options; /**< Daemon configuration. */
+    TimerManager *timerManager; /**< Timers, owned. */
+    AlarmManager *alarmManager; /**< Alarms, owned. */
+    StopwatchModel *stopwatchModel; /**< Stopwatch, owned. */
+    DebouncedSaver *timerSaver; /**< Coalesces timer writes. */
+    DebouncedSaver *alarmSaver; /**< Coalesces alarm writes. */
+    DebouncedSaver *stopwatchSaver; /**< Coalesces stopwatch writes. */
+    ControlServer *server; /**< Local control endpoint. */
+};
+
+#endif // SMARTCLOCKDAEMON_H
@@ -11,6 +11,7 @@
 #include <QApplication>
 #include <QMessageBox>
 #include "mainwindow.h"
+#include "storage/instancelock.h"
 
 extern int qInitResources_resources();
 
@@ -22,6 +23,11 @@ int main(int argc, char *argv[])
         QMessageBox::critical(nullptr, "Error", "System tray not available!");
         return -1;
     }
+    InstanceLock lock;
+    if (!lock.tryLock()) {
+        QMessageBox::critical(nullptr, "Error", "SmartClock or smartclockd is already running!");
+        return -1;
+    }
     QApplication::setQuitOnLastWindowClosed(false);
 
     MainWindow w;
@@ -117,6 +117,7 @@ void MainWindow::setupTrayIcon()
     });
 
     connect(openStopwatch, &QAction::hovered, this, [this]() {
+        stopwatchWindow->updateDisplay();
         QString info = QString(
                            "<b>⏲ Stopwatch</b><br>"
                            "🏁 Lap: <b>%1</b><br>"
@@ -215,12 +216,12 @@ void MainWindow::closeEvent(QCloseEvent *event)
 
 int MainWindow::getRunningTimers() const
 {
-    return timerWindow ? timerWindow->getManager()->getFilteredTimers("Running").size() : 0;
+    return timerWindow ? timerWindow->getManager()->countByStatus(TimerStatus::Running) : 0;
 }
 
 int MainWindow::getFinishedTimers() const
 {
-    return timerWindow ? timerWindow->getManager()->getFilteredTimers("Finished").size() : 0;
+    return timerWindow ? timerWindow->getManager()->countByStatus(TimerStatus::Finished) : 0;
 }
 
 QString MainWindow::getNextAlarmTime() const
@@ -0,0 +1,108 @@
+/**
+ * @file refreshscheduler.cpp
+ * @brief Definitions for refreshscheduler.
+ * @details Implements logic declared in the corresponding header for refreshscheduler.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "refreshscheduler.h"
+#include "activitymanager.h"
+#include <QScreen>
+#include <QWindow>
+#include <QtMath>
+
+RefreshScheduler::RefreshScheduler(QWidget *target, QObject *parent)
+    : QObject(parent)
+    , target(target)
+{
+    connect(&timer, &QTimer::timeout, this, &RefreshScheduler::tick);
+    ActivityManager &activity = ActivityManager::instance();
+    activity.watch(target);
+    connect(&activity, &ActivityManager::visibilityChanged, this, [this](QWidget *view) {
+        if (view == this->target)
+            reschedule();
+    });
+}
+
+void RefreshScheduler::setActive(bool value)
+{
+    if (active == value)
+        return;
+    active = value;
+    reschedule();
+}
+
+bool RefreshScheduler::isActive() const
+{
+    return active;
+}
+
+void RefreshScheduler::setHiddenInterval(int ms)
+{
+    hiddenMs = qMax(0, ms);
+    reschedule();
+}
+
+int RefreshScheduler::hiddenInterval() const
+{
+    return hiddenMs;
+}
+
+bool RefreshScheduler::isOnScreen() const
+{
+    if (!target || !target->isVisible())
+        return false;
+    const QWidget *top = target->window();
+    return top && !top->isMinimized();
+}
+
+int RefreshScheduler::currentInterval() const
+{
+    return timer.isActive() ? timer.interval() : 0;
+}
+
+int RefreshScheduler::frameInterval() const
+{
+    qreal rate = 0;
+    if (target) {
+        if (const QScreen *screen = target->screen())
+            rate = screen->refreshRate();
+    }
+    if (rate <= 0)
+        rate = kFallbackRefreshRate;
+    return qMax(1, qRound(1000.0 / rate));
+}
+
+void RefreshScheduler::reschedule()
+{
+    const bool onScreen = isOnScreen();
+    const bool caughtUp = onScreen && !wasOnScreen;
+    wasOnScreen = onScreen;
+
+    if (onScreen) {
+        if (QWindow *handle = target->window()->windowHandle())
+            connect(handle, &QWindow::screenChanged,
+                    this, &RefreshScheduler::reschedule, Qt::UniqueConnection);
+    }
+
+    if (!active) {
+        timer.stop();
+        return;
+    }
+
+    const int interval = onScreen ? frameInterval() : hiddenMs;
+    if (interval <= 0) {
+        timer.stop();
+        return;
+    }
+
+    timer.setTimerType(onScreen ? Qt::PreciseTimer : Qt::CoarseTimer);
+    if (!timer.isActive() || timer.interval() != interval)
+        timer.start(interval);
+
+    if (caughtUp)
+        emit tick();
+}
@@ -0,0 +1,130 @@
+/**
+ * @file refreshscheduler.h
+ * @brief Declarations for refreshscheduler.
+ * @details Defines a display refresh driver that follows the screen refresh rate and the visibility of its widget.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef REFRESHSCHEDULER_H
+#define REFRESHSCHEDULER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QWidget>
+
+/**
+ * @brief RefreshScheduler Display refresh driver.
+ * @details Emits tick() once per screen frame while the target widget is
+ * on screen. Visibility changes come from ActivityManager. When the widget is
+ * hidden (inactive tab), its window is minimized or the window is hidden to
+ * the tray, ticks drop to the hidden interval, or stop if that interval is
+ * 0. One tick is emitted as soon as the widget becomes visible again so the
+ * view catches up immediately.
+ * @note Public API is documented per member.
+ * @warning The target widget must outlive the scheduler or be its parent.
+ * @sa SmartClock
+ */
+class RefreshScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kFallbackRefreshRate = 60; /**< Rate used when the screen reports none. */
+    static constexpr int kDefaultHiddenIntervalMs = 1000; /**< Default throttled interval (1 Hz). */
+
+/**
+ * @brief Create RefreshScheduler instance.
+ * @details Registers the target with ActivityManager and follows its visibility changes.
+ * @param target Widget whose visibility gates the refresh.
+ * @param parent Parent QObject.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit RefreshScheduler(QWidget *target, QObject *parent = nullptr);
+
+/**
+ * @brief Set active.
+ * @details Marks whether there is anything to animate; an inactive scheduler never ticks.
+ * @param active True while the view changes over time.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setActive(bool active);
+/**
+ * @brief Is active.
+ * @details Returns the current value derived from internal state.
+ * @return True if the scheduler has been activated.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isActive() const;
+/**
+ * @brief Set hidden interval.
+ * @details Sets the tick interval used while the target is not on screen.
+ * @param ms Interval in milliseconds; 0 stops ticking while hidden.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setHiddenInterval(int ms);
+/**
+ * @brief Get hidden interval.
+ * @details Returns the current value derived from internal state.
+ * @return Interval in milliseconds; 0 means stopped while hidden.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int hiddenInterval() const;
+/**
+ * @brief Is on screen.
+ * @details Returns true if the target is visible and its window is not minimized.
+ * @return True if ticks run at the screen rate.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isOnScreen() const;
+/**
+ * @brief Get current interval.
+ * @details Returns the interval the driver is ticking at.
+ * @return Interval in milliseconds, or 0 if stopped.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int currentInterval() const;
+/**
+ * @brief Get frame interval.
+ * @details Derives one frame period from the refresh rate of the target's screen.
+ * @return Interval in milliseconds, at least 1.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int frameInterval() const;
+
+signals:
+/**
+ * @brief Emitted when the view should repaint.
+ * @details Signal emitted once per scheduled frame.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void tick();
+
+private:
+/**
+ * @brief Reschedule.
+ * @details Picks the interval for the current state and restarts or stops the timer; also follows screen changes.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void reschedule();
+
+    QPointer<QWidget> target; /**< Widget whose visibility gates the refresh. */
+    QTimer timer; /**< Frame timer. */
+    bool active = false; /**< True while there is something to animate. */
+    bool wasOnScreen = false; /**< On-screen state at the last reschedule. */
+    int hiddenMs = kDefaultHiddenIntervalMs; /**< Interval while not on screen. */
+};
+
+#endif // REFRESHSCHEDULER_H
@@ -18,11 +18,20 @@ AnalogStopwatchDial::AnalogStopwatchDial(QWidget *parent)
     : QWidget(parent)
 {
     setMinimumSize(250, 250);
+    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, [this]() {
+        invalidateFace();
+        update();
+    });
 }
 
 void AnalogStopwatchDial::setElapsed(const QTime &time)
 {
-    elapsed = time;
+    setElapsed(StopwatchTime::fromMs(time.isValid() ? time.msecsSinceStartOfDay() : 0));
+}
+
+void AnalogStopwatchDial::setElapsed(StopwatchTime::Duration value)
+{
+    elapsed = value;
     update();
 }
 void AnalogStopwatchDial::show() {
@@ -33,41 +42,50 @@ void AnalogStopwatchDial::show() {
     QWidget::show();
 }
 
-void AnalogStopwatchDial::paintEvent(QPaintEvent *)
+void AnalogStopwatchDial::invalidateFace()
 {
-    QPainter p(this);
+    face = QPixmap();
+}
+
+int AnalogStopwatchDial::faceRenderCount() const
+{
+    return faceRenders;
+}
+
+void AnalogStopwatchDial::resizeEvent(QResizeEvent *event)
+{
+    invalidateFace();
+    QWidget::resizeEvent(event);
+}
+
+AnalogStopwatchDial::DialColors AnalogStopwatchDial::colors()
+{
+    if (ThemeManager::instance().currentTheme() == Theme::Dark)
+        return {QColor("#090C08"), QColor("#C9D1D9"), QColor("#99AA38"), QColor("#D52941"), QColor("#99AA38")};
+    return {QColor("#FFF8E8"), QColor("#41521F"), QColor("#D52941"), QColor("#990D35"), QColor("#FCD581")};
+}
+
+void AnalogStopwatchDial::renderFace()
+{
+    const qreal dpr = devicePixelRatioF();
+    face = QPixmap(size() * dpr);
+    face.setDevicePixelRatio(dpr);
+    face.fill(Qt::transparent);
+    ++faceRenders;
+
+    const DialColors c = colors();
+    QPainter p(&face);
     p.setRenderHint(QPainter::Antialiasing);
 
     int side = qMin(width(), height());
     p.translate(width() / 2, height() / 2);
     p.scale(side / 200.0, side / 200.0);
 
-    Theme theme = ThemeManager::instance().currentTheme();
-    bool isDark = (theme == Theme::Dark);
-
-    QColor bg, dialBg, text, accent, milli, border;
-
-    if (isDark) {
-        bg      = QColor("#0E273C");
-        dialBg  = QColor("#090C08");
-        text    = QColor("#C9D1D9");
-        accent  = QColor("#99AA38");
-        milli   = QColor("#D52941");
-        border  = QColor("#99AA38");
-    } else {
-        bg      = QColor("#FFF8E8");
-        dialBg  = QColor("#FFF8E8");
-        text    = QColor("#41521F");
-        accent  = QColor("#D52941");
-        milli   = QColor("#990D35");
-        border  = QColor("#FCD581");
-    }
-
-    p.setBrush(dialBg);
-    p.setPen(QPen(border, 3));
+    p.setBrush(c.dialBg);
+    p.setPen(QPen(c.border, 3));
     p.drawEllipse(-100, -100, 200, 200);
 
-    p.setPen(QPen(text, 2));
+    p.setPen(QPen(c.text, 2));
     for (int i = 0; i < 60; ++i) {
         if (i % 5 == 0)
             p.drawLine(0, -90, 0, -100);
@@ -76,37 +94,57 @@ void AnalogStopwatchDial::paintEvent(QPaintEvent *)
         p.rotate(6.0);
     }
 
-    p.save();
-    p.setPen(QPen(border.lighter(120), 1.5));
+    p.setBrush(Qt::NoBrush);
+    p.setPen(QPen(c.border.lighter(120), 1.5));
     p.drawEllipse(-35, -35, 70, 70);
-    p.restore();
+}
+
+void AnalogStopwatchDial::paintEvent(QPaintEvent *)
+{
+    // The pixmap is tied to one size and DPR; moving to another screen changes the DPR.
+    if (face.isNull() || face.devicePixelRatio() != devicePixelRatioF())
+        renderFace();
+
+    QPainter p(this);
+    p.drawPixmap(0, 0, face);
+    p.setRenderHint(QPainter::Antialiasing);
+
+    int side = qMin(width(), height());
+    p.translate(width() / 2, height() / 2);
+    p.scale(side / 200.0, side / 200.0);
+
+    const DialColors c = colors();
+    const qint64 totalMs = qMax<qint64>(0, StopwatchTime::toMs(elapsed));
+    const int msec = int(totalMs % 1000);
+    const int second = int((totalMs / 1000) % 60);
+    const int minute = int((totalMs / 60000) % 30);
 
     p.save();
-    p.setPen(QPen(text, 2, Qt::SolidLine, Qt::RoundCap));
-    double minuteAngle = (elapsed.minute() % 30) * 12.0 + (elapsed.second() / 60.0) * 12.0;
+    p.setPen(QPen(c.text, 2, Qt::SolidLine, Qt::RoundCap));
+    double minuteAngle = minute * 12.0 + (second / 60.0) * 12.0;
     p.rotate(minuteAngle);
     p.drawLine(0, 0, 0, -25);
     p.restore();
 
     p.save();
-    p.setPen(QPen(accent, 2.4, Qt::SolidLine, Qt::RoundCap));
-    double secAngle = (elapsed.second() + elapsed.msec() / 1000.0) * 6.0;
+    p.setPen(QPen(c.accent, 2.4, Qt::SolidLine, Qt::RoundCap));
+    double secAngle = (second + msec / 1000.0) * 6.0;
     p.rotate(secAngle);
     p.drawLine(0, 10, 0, -85);
     p.restore();
 
     p.save();
-    p.setPen(QPen(milli, 1.2, Qt::SolidLine, Qt::RoundCap));
-    double msAngle = (elapsed.msec() / 1000.0) * 360.0;
+    p.setPen(QPen(c.milli, 1.2, Qt::SolidLine, Qt::RoundCap));
+    double msAngle = (msec / 1000.0) * 360.0;
     p.rotate(msAngle);
     p.drawLine(0, 0, 0, -60);
     p.restore();
 
-    p.setBrush(accent);
+    p.setBrush(c.accent);
     p.setPen(Qt::NoPen);
     p.drawEllipse(-4, -4, 8, 8);
 
-    p.setPen(text);
+    p.setPen(c.text);
     p.setFont(QFont("Poppins", 10, QFont::Bold));
-    p.drawText(-40, 40, 80, 20, Qt::AlignCenter, elapsed.toString("mm:ss.zzz").left(8));
+    p.drawText(-60, 40, 120, 20, Qt::AlignCenter, StopwatchTime::format(elapsed));
 }
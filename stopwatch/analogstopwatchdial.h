@@ -13,6 +13,9 @@
 
 #include <QWidget>
 #include <QTime>
+#include <QPixmap>
+#include <QColor>
+#include "stopwatchtime.h"
 
 /**
  * @brief AnalogStopwatchDial stopwatch component.
@@ -35,13 +38,21 @@ public:
  */
     explicit AnalogStopwatchDial(QWidget *parent = nullptr);
 /**
- * @brief Get elapsed time.
- * @details Updates internal state and emits signals as needed.
+ * @brief Set elapsed time.
+ * @details Updates internal state and schedules a repaint.
  * @param time time value.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
     void setElapsed(const QTime &time);
+/**
+ * @brief Set elapsed time.
+ * @details Updates internal state and schedules a repaint; unlike QTime this does not wrap at 24 h.
+ * @param elapsed Elapsed duration.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setElapsed(StopwatchTime::Duration elapsed);
 /**
  * @brief Show operation.
  * @details Performs the operation and updates state as needed.
@@ -49,6 +60,21 @@ public:
  * @sa SmartClock
  */
     void show();
+/**
+ * @brief Invalidate face.
+ * @details Drops the cached dial face so the next paint renders it again.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void invalidateFace();
+/**
+ * @brief Face render count.
+ * @details Returns how many times the static face has been rendered into the cache.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int faceRenderCount() const;
 
 protected:
 /**
@@ -59,9 +85,50 @@ protected:
  * @sa SmartClock
  */
     void paintEvent(QPaintEvent *event) override;
+/**
+ * @brief Resize event.
+ * @details Invalidates the cached face for the new size.
+ * @param event event value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void resizeEvent(QResizeEvent *event) override;
 
 private:
-    QTime elapsed; /**< Elapsed time in milliseconds. */
+/**
+ * @brief DialColors type.
+ * @details Palette used to paint the dial for one theme.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+    struct DialColors {
+        QColor dialBg; /**< Face fill. */
+        QColor text; /**< Ticks, minute hand and digits. */
+        QColor accent; /**< Second hand and hub. */
+        QColor milli; /**< Millisecond hand. */
+        QColor border; /**< Outer ring. */
+    };
+
+/**
+ * @brief Colors.
+ * @details Returns the palette for the current theme.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static DialColors colors();
+/**
+ * @brief Render face.
+ * @details Paints the static face (ring, ticks, inner circle) into the cache at the current size and device pixel ratio.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void renderFace();
+
+    StopwatchTime::Duration elapsed{0}; /**< Elapsed time shown by the hands. */
+    QPixmap face; /**< Cached static dial face. */
+    int faceRenders = 0; /**< Number of face renders, for diagnostics. */
 };
 
 #endif // ANALOGSTOPWATCHDIAL_H
@@ -0,0 +1,72 @@
+/**
+ * @file asyncstopwatchstorage.h
+ * @brief Declarations for asyncstopwatchstorage.
+ * @details Defines the AsyncStorage adapter for IStopwatchStorage including bank snapshots.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef ASYNCSTOPWATCHSTORAGE_H
+#define ASYNCSTOPWATCHSTORAGE_H
+
+#include "istopwatchstorage.h"
+#include "../storage/asyncstorage.h"
+
+/**
+ * @brief AsyncStopwatchStorage adapter running a stopwatch backend off the GUI thread.
+ * @details Extends AsyncStorage with the bank calls of IStopwatchStorage so
+ * StopwatchBank saves run on the same worker as single-stopwatch saves.
+ * @note Public API is documented per member.
+ * @warning The wrapped storage is only touched from the worker thread once wrapped.
+ * @sa SmartClock
+ */
+class AsyncStopwatchStorage : public AsyncStorage<IStopwatchStorage, StopwatchSnapshot>
+{
+public:
+    using AsyncStorage::AsyncStorage;
+
+/**
+ * @brief Load bank snapshot from storage.
+ * @details Blocks until the worker has read the bank, so it observes every earlier save.
+ * @param out Output snapshot to populate.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool loadBank(StopwatchBankSnapshot &out) override
+    {
+        IStopwatchStorage *storage = inner.get();
+        const std::optional<StopwatchBankSnapshot> loaded =
+            worker.submit([storage]() -> std::optional<StopwatchBankSnapshot> {
+                StopwatchBankSnapshot snap;
+                if (!storage || !storage->loadBank(snap))
+                    return std::nullopt;
+                return snap;
+            }).result();
+        if (!loaded)
+            return false;
+        out = *loaded;
+        return true;
+    }
+
+/**
+ * @brief Save bank snapshot to storage.
+ * @details Queues the write; like save(), it waits inside a SyncSaveScope and otherwise reports the previous background write.
+ * @param in Input snapshot.
+ * @return True on success; false on failure or without a wrapped storage.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool saveBank(const StopwatchBankSnapshot &in) override
+    {
+        IStopwatchStorage *storage = inner.get();
+        if (!storage)
+            return false;
+        const bool earlierOk = !saveFailed.load();
+        const QFuture<bool> done = submitSave([storage, in]() { return storage->saveBank(in); });
+        return SyncSaveScope::isActive() ? done.result() : earlierOk;
+    }
+};
+
+#endif // ASYNCSTOPWATCHSTORAGE_H
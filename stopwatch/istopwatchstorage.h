@@ -12,6 +12,8 @@
 #define ISTOPWATCHSTORAGE_H
 
 #include <QList>
+#include <QString>
+#include "stopwatchtime.h"
 
 /**
  * @brief StopwatchSnapshot snapshot.
@@ -21,9 +23,32 @@
  * @sa SmartClock
  */
 struct StopwatchSnapshot {
-    int elapsedMs = 0;          /**< Total elapsed time at capture (milliseconds). */
-    bool running = false;       /**< True if the stopwatch was running when captured. */
-    QList<int> lapDurations;    /**< Ordered list of lap segment durations (milliseconds). */
+    StopwatchTime::Duration elapsed{0};             /**< Total elapsed time at capture. */
+    bool running = false;                           /**< True if the stopwatch was running when captured. */
+    QList<StopwatchTime::Duration> lapDurations;    /**< Ordered list of lap segment durations. */
+};
+
+/**
+ * @brief StopwatchBankEntry snapshot.
+ * @details One named stopwatch inside a StopwatchBank.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+struct StopwatchBankEntry {
+    QString name;                                   /**< Station name. */
+    StopwatchSnapshot state;                        /**< Elapsed time, running flag and laps. */
+};
+
+/**
+ * @brief StopwatchBankSnapshot snapshot.
+ * @details Captures every stopwatch of a StopwatchBank for persistence or restore.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+struct StopwatchBankSnapshot {
+    QList<StopwatchBankEntry> entries;              /**< Stopwatches in bank order. */
 };
 
 /**
@@ -61,6 +86,24 @@ public:
  * @sa SmartClock
  */
     virtual bool save(const StopwatchSnapshot &in) = 0;
+/**
+ * @brief Load bank snapshot from storage.
+ * @details Reads every stopwatch of a StopwatchBank; backends without bank support return false.
+ * @param out Output snapshot to populate.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    virtual bool loadBank(StopwatchBankSnapshot &out) { Q_UNUSED(out); return false; }
+/**
+ * @brief Save bank snapshot to storage.
+ * @details Writes every stopwatch of a StopwatchBank; backends without bank support return false.
+ * @param in Input snapshot.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    virtual bool saveBank(const StopwatchBankSnapshot &in) { Q_UNUSED(in); return false; }
 };
 
 #endif // ISTOPWATCHSTORAGE_H
@@ -9,19 +9,92 @@
  */
 
 #include "jsonstopwatchstorage.h"
+#include "../storage/atomicfile.h"
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QTime>
+
+namespace {
+
+StopwatchSnapshot snapshotFromJson(const QJsonObject &obj)
+{
+    StopwatchSnapshot out;
+    // Files written before the microsecond time base only carry milliseconds.
+    const qint64 elapsedUs = obj.contains("elapsed_us")
+        ? obj.value("elapsed_us").toInteger(0)
+        : obj.value("elapsed_ms").toInteger(0) * 1000;
+    out.elapsed = StopwatchTime::Duration(qMax<qint64>(0, elapsedUs));
+    out.running = obj.value("running").toBool(false);
+
+    if (obj.contains("durations_us")) {
+        const QJsonArray durArr = obj.value("durations_us").toArray();
+        for (const QJsonValue &v : durArr)
+            out.lapDurations.append(StopwatchTime::Duration(v.toInteger()));
+    } else {
+        const QJsonArray durArr = obj.value("durations").toArray();
+        for (const QJsonValue &v : durArr)
+            out.lapDurations.append(StopwatchTime::fromMs(v.toInteger()));
+    }
+    return out;
+}
+
+QJsonObject snapshotToJson(const StopwatchSnapshot &in)
+{
+    QJsonObject obj;
+    obj["elapsed_us"] = qint64(in.elapsed.count());
+    obj["running"] = in.running;
+
+    QJsonArray durArr;
+    for (StopwatchTime::Duration d : in.lapDurations)
+        durArr.append(qint64(d.count()));
+    obj["durations_us"] = durArr;
+
+    QJsonArray lapsArr;
+    StopwatchTime::Duration acc{0};
+    for (int i = 0; i < in.lapDurations.size(); ++i) {
+        acc += in.lapDurations[i];
+        QString text = QString("Lap %1: %2 (+%3)")
+                           .arg(i + 1)
+                           .arg(StopwatchTime::format(acc), StopwatchTime::format(in.lapDurations[i]));
+        lapsArr.append(text);
+    }
+    obj["laps"] = lapsArr;
+    return obj;
+}
+
+// False if the file is missing; a corrupt file reads as an empty object.
+bool readObject(const QString &path, QJsonObject &out)
+{
+    out = QJsonObject();
+    QFile f(path);
+    if (!f.exists() || !f.open(QIODevice::ReadOnly))
+        return false;
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &err);
+    f.close();
+
+    if (err.error == QJsonParseError::NoError && doc.isObject())
+        out = doc.object();
+    return true;
+}
+
+} // namespace
 
 JsonStopwatchStorage::JsonStopwatchStorage(const QString &path)
     : path(path)
 {
 }
 
+void JsonStopwatchStorage::setBackupEnabled(bool enabled)
+{
+    backupEnabled = enabled;
+}
+
 QString JsonStopwatchStorage::resolvePath() const
 {
     if (!path.isEmpty())
@@ -32,66 +105,80 @@ QString JsonStopwatchStorage::resolvePath() const
     return base + "/stopwatch.json";
 }
 
+QString JsonStopwatchStorage::resolveBankPath() const
+{
+    // Named after the single-stopwatch file, so the two never collide.
+    if (!path.isEmpty()) {
+        const QFileInfo info(path);
+        return info.dir().filePath(info.completeBaseName() + ".bank.json");
+    }
+
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(base);
+    return base + "/stopwatches.json";
+}
+
 bool JsonStopwatchStorage::load(StopwatchSnapshot &out)
 {
     out = StopwatchSnapshot{};
-    const QString p = resolvePath();
-    QFile f(p);
-    if (!f.exists() || !f.open(QIODevice::ReadOnly))
+    QJsonObject obj;
+    if (!readObject(resolvePath(), obj))
         return false;
+    if (!obj.isEmpty())
+        out = snapshotFromJson(obj);
+    return true;
+}
 
-    QJsonParseError err;
-    QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &err);
-    f.close();
+bool JsonStopwatchStorage::save(const StopwatchSnapshot &in)
+{
+    const QString p = resolvePath();
 
-    if (err.error != QJsonParseError::NoError || !doc.isObject())
+    if (in.elapsed.count() <= 0 && !in.running && in.lapDurations.isEmpty()) {
+        QFile::remove(p);
         return true;
+    }
 
-    QJsonObject obj = doc.object();
-    out.elapsedMs = qMax(0, obj.value("elapsed_ms").toInt(0));
-    out.running = obj.value("running").toBool(false);
+    QJsonDocument doc(snapshotToJson(in));
+    return AtomicFile::write(p, doc.toJson(QJsonDocument::Compact), backupEnabled);
+}
 
-    QJsonArray durArr = obj.value("durations").toArray();
-    for (const QJsonValue &v : durArr)
-        out.lapDurations.append(v.toInt());
+bool JsonStopwatchStorage::loadBank(StopwatchBankSnapshot &out)
+{
+    out = StopwatchBankSnapshot{};
+    QJsonObject obj;
+    if (!readObject(resolveBankPath(), obj))
+        return false;
 
+    const QJsonArray arr = obj.value("stopwatches").toArray();
+    out.entries.reserve(arr.size());
+    for (const QJsonValue &v : arr) {
+        const QJsonObject entryObj = v.toObject();
+        StopwatchBankEntry entry;
+        entry.name = entryObj.value("name").toString();
+        entry.state = snapshotFromJson(entryObj);
+        out.entries.append(entry);
+    }
     return true;
 }
 
-bool JsonStopwatchStorage::save(const StopwatchSnapshot &in)
+bool JsonStopwatchStorage::saveBank(const StopwatchBankSnapshot &in)
 {
-    const QString p = resolvePath();
+    const QString p = resolveBankPath();
 
-    if (in.elapsedMs <= 0 && !in.running && in.lapDurations.isEmpty()) {
+    if (in.entries.isEmpty()) {
         QFile::remove(p);
         return true;
     }
 
-    QJsonObject obj;
-    obj["elapsed_ms"] = in.elapsedMs;
-    obj["running"] = in.running;
-
-    QJsonArray durArr;
-    for (int d : in.lapDurations)
-        durArr.append(d);
-    obj["durations"] = durArr;
-
-    QJsonArray lapsArr;
-    int accMs = 0;
-    for (int i = 0; i < in.lapDurations.size(); ++i) {
-        accMs += in.lapDurations[i];
-        QString lapTimeStr = QTime(0, 0).addMSecs(accMs).toString("mm:ss.zzz").left(8);
-        QString deltaStr = QTime(0, 0).addMSecs(in.lapDurations[i]).toString("mm:ss.zzz").left(8);
-        QString text = QString("Lap %1: %2 (+%3)").arg(i + 1).arg(lapTimeStr).arg(deltaStr);
-        lapsArr.append(text);
+    QJsonArray arr;
+    for (const StopwatchBankEntry &entry : in.entries) {
+        QJsonObject entryObj = snapshotToJson(entry.state);
+        entryObj["name"] = entry.name;
+        arr.append(entryObj);
     }
-    obj["laps"] = lapsArr;
+    QJsonObject obj;
+    obj["stopwatches"] = arr;
 
     QJsonDocument doc(obj);
-    QFile f(p);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
-        return false;
-    f.write(doc.toJson(QJsonDocument::Compact));
-    f.close();
-    return true;
+    return AtomicFile::write(p, doc.toJson(QJsonDocument::Compact), backupEnabled);
 }
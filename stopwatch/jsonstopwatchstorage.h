@@ -26,7 +26,7 @@ class JsonStopwatchStorage : public IStopwatchStorage
 public:
 /**
  * @brief Create JsonStopwatchStorage instance.
- * @details Initializes instance state.
+ * @details Initializes instance state. The single stopwatch (load/save) and the bank (loadBank/saveBank) are kept in separate files.
  * @param path Filesystem path.
  * @note Validate inputs where applicable.
  * @sa SmartClock
@@ -51,6 +51,33 @@ public:
  * @sa SmartClock
  */
     bool save(const StopwatchSnapshot &in) override;
+/**
+ * @brief Load bank snapshot from storage.
+ * @details Reads the "stopwatches" array of the bank file.
+ * @param out Output snapshot to populate.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool loadBank(StopwatchBankSnapshot &out) override;
+/**
+ * @brief Save bank snapshot to storage.
+ * @details Writes every stopwatch into the bank file, or removes it when the bank is empty.
+ * @param in Input snapshot.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool saveBank(const StopwatchBankSnapshot &in) override;
+
+/**
+ * @brief Set backup enabled.
+ * @details Updates internal state and emits signals as needed.
+ * @param enabled True to keep the previous file as a rolling .bak on every save.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setBackupEnabled(bool enabled);
 
 private:
 /**
@@ -61,8 +88,17 @@ private:
  * @sa SmartClock
  */
     QString resolvePath() const;
+/**
+ * @brief Resolve bank path.
+ * @details Returns <basename>.bank.json next to the configured path, or AppData/stopwatches.json when none was given.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString resolveBankPath() const;
 
     QString path; /**< Filesystem path. */
+    bool backupEnabled = false; /**< Keep a rolling .bak of the previous file. */
 };
 
 #endif // JSONSTOPWATCHSTORAGE_H
@@ -0,0 +1,246 @@
+/**
+ * @file stopwatchbank.cpp
+ * @brief Definitions for stopwatchbank.
+ * @details Implements logic declared in the corresponding header for stopwatchbank.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "stopwatchbank.h"
+#include "asyncstopwatchstorage.h"
+#include "jsonstopwatchstorage.h"
+#include <algorithm>
+
+StopwatchBank::StopwatchBank(QObject *parent, std::unique_ptr<IStopwatchStorage> storage)
+    : QObject(parent)
+    , storage(storage ? std::move(storage) : std::make_unique<AsyncStopwatchStorage>(std::make_unique<JsonStopwatchStorage>()))
+{
+}
+
+int StopwatchBank::count() const
+{
+    return names.size();
+}
+
+int StopwatchBank::addStopwatch(const QString &name)
+{
+    const int index = names.size();
+    names.append(name);
+    accumulated.append(StopwatchTime::Duration::zero());
+    startStamps.append(Clock::time_point());
+    running.resize(index + 1);
+    lastSplits.append(StopwatchTime::Duration::zero());
+    laps.append(QList<StopwatchTime::Duration>());
+    emit stopwatchesChanged();
+    return index;
+}
+
+void StopwatchBank::removeStopwatch(int index)
+{
+    if (!isValid(index))
+        return;
+    if (running.testBit(index))
+        --runningTotal;
+    const int last = names.size() - 1;
+    for (int i = index; i < last; ++i)
+        running.setBit(i, running.testBit(i + 1));
+    running.resize(last);
+    names.removeAt(index);
+    accumulated.removeAt(index);
+    startStamps.removeAt(index);
+    lastSplits.removeAt(index);
+    laps.removeAt(index);
+    emit stopwatchesChanged();
+}
+
+QString StopwatchBank::name(int index) const
+{
+    return isValid(index) ? names[index] : QString();
+}
+
+bool StopwatchBank::isRunning(int index) const
+{
+    return isValid(index) && running.testBit(index);
+}
+
+int StopwatchBank::runningCount() const
+{
+    return runningTotal;
+}
+
+StopwatchTime::Duration StopwatchBank::elapsed(int index) const
+{
+    return elapsedAt(index, Clock::now());
+}
+
+StopwatchTime::Duration StopwatchBank::elapsedAt(int index, Clock::time_point now) const
+{
+    if (!isValid(index))
+        return StopwatchTime::Duration::zero();
+    if (!running.testBit(index))
+        return accumulated[index];
+    return accumulated[index] + std::chrono::duration_cast<StopwatchTime::Duration>(now - startStamps[index]);
+}
+
+QList<StopwatchTime::Duration> StopwatchBank::lapDurations(int index) const
+{
+    return isValid(index) ? laps[index] : QList<StopwatchTime::Duration>();
+}
+
+void StopwatchBank::start(const QList<int> &indices)
+{
+    const Clock::time_point now = Clock::now();
+    QList<int> changed;
+    for (int i : indices) {
+        if (!isValid(i) || running.testBit(i))
+            continue;
+        startStamps[i] = now;
+        running.setBit(i);
+        ++runningTotal;
+        changed.append(i);
+    }
+    if (!changed.isEmpty())
+        emit stateChanged(changed);
+}
+
+void StopwatchBank::stop(const QList<int> &indices)
+{
+    const Clock::time_point now = Clock::now();
+    QList<int> changed;
+    for (int i : indices) {
+        if (!isValid(i) || !running.testBit(i))
+            continue;
+        accumulated[i] = elapsedAt(i, now);
+        running.clearBit(i);
+        --runningTotal;
+        changed.append(i);
+    }
+    if (!changed.isEmpty())
+        emit stateChanged(changed);
+}
+
+void StopwatchBank::lap(const QList<int> &indices)
+{
+    const Clock::time_point now = Clock::now();
+    QList<int> recorded;
+    for (int i : indices) {
+        if (!isValid(i) || !running.testBit(i))
+            continue;
+        const StopwatchTime::Duration split = elapsedAt(i, now);
+        laps[i].append(std::max(StopwatchTime::Duration::zero(), split - lastSplits[i]));
+        lastSplits[i] = split;
+        recorded.append(i);
+    }
+    if (!recorded.isEmpty())
+        emit lapsRecorded(recorded);
+}
+
+void StopwatchBank::reset(const QList<int> &indices)
+{
+    QList<int> changed;
+    for (int i : indices) {
+        if (!isValid(i))
+            continue;
+        if (running.testBit(i)) {
+            running.clearBit(i);
+            --runningTotal;
+        }
+        accumulated[i] = StopwatchTime::Duration::zero();
+        lastSplits[i] = StopwatchTime::Duration::zero();
+        laps[i].clear();
+        changed.append(i);
+    }
+    if (!changed.isEmpty())
+        emit stateChanged(changed);
+}
+
+void StopwatchBank::startAll()
+{
+    start(allIndices());
+}
+
+void StopwatchBank::stopAll()
+{
+    stop(allIndices());
+}
+
+bool StopwatchBank::load()
+{
+    if (!storage)
+        return false;
+    StopwatchBankSnapshot snap;
+    if (!storage->loadBank(snap))
+        return false;
+
+    const int n = snap.entries.size();
+    const Clock::time_point now = Clock::now();
+    names.clear();
+    accumulated.clear();
+    startStamps.clear();
+    lastSplits.clear();
+    laps.clear();
+    names.reserve(n);
+    accumulated.reserve(n);
+    startStamps.reserve(n);
+    lastSplits.reserve(n);
+    laps.reserve(n);
+    running.fill(false, n);
+    runningTotal = 0;
+
+    for (int i = 0; i < n; ++i) {
+        const StopwatchBankEntry &entry = snap.entries[i];
+        names.append(entry.name);
+        accumulated.append(std::max(StopwatchTime::Duration::zero(), entry.state.elapsed));
+        startStamps.append(now);
+        laps.append(entry.state.lapDurations);
+        StopwatchTime::Duration split = StopwatchTime::Duration::zero();
+        for (const StopwatchTime::Duration &d : entry.state.lapDurations)
+            split += d;
+        lastSplits.append(split);
+        if (entry.state.running) {
+            running.setBit(i);
+            ++runningTotal;
+        }
+    }
+    emit stopwatchesChanged();
+    return true;
+}
+
+bool StopwatchBank::save() const
+{
+    if (!storage)
+        return false;
+    const Clock::time_point now = Clock::now();
+    StopwatchBankSnapshot snap;
+    snap.entries.reserve(names.size());
+    for (int i = 0; i < names.size(); ++i) {
+        StopwatchBankEntry entry;
+        entry.name = names[i];
+        entry.state.elapsed = elapsedAt(i, now);
+        entry.state.running = running.testBit(i);
+        entry.state.lapDurations = laps[i];
+        snap.entries.append(entry);
+    }
+    return storage->saveBank(snap);
+}
+
+void StopwatchBank::setStorage(std::unique_ptr<IStopwatchStorage> storage)
+{
+    this->storage = std::move(storage);
+}
+
+bool StopwatchBank::isValid(int index) const
+{
+    return index >= 0 && index < names.size();
+}
+
+QList<int> StopwatchBank::allIndices() const
+{
+    QList<int> indices;
+    indices.reserve(names.size());
+    for (int i = 0; i < names.size(); ++i)
+        indices.append(i);
+    return indices;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file stopwatchbank.h
+ * @brief Declarations for stopwatchbank.
+ * @details Defines a model owning many independent stopwatches in a structure-of-arrays layout.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef STOPWATCHBANK_H
+#define STOPWATCHBANK_H
+
+#include <QObject>
+#include <QBitArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <chrono>
+#include <memory>
+#include "istopwatchstorage.h"
+#include "stopwatchtime.h"
+
+/**
+ * @brief StopwatchBank Data model holding N independent stopwatches.
+ * @details Each attribute lives in its own array indexed by stopwatch:
+ * names, accumulated time, start stamps, running bits, last split and lap
+ * segments. Bulk operations read the clock once, so every stopwatch in one
+ * call starts, stops or laps at the same instant.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+class StopwatchBank : public QObject
+{
+    Q_OBJECT
+public:
+    using Clock = std::chrono::steady_clock; /**< Monotonic clock behind the start stamps. */
+
+/**
+ * @brief Create StopwatchBank instance.
+ * @details Initializes an empty bank.
+ * @param parent Parent QObject.
+ * @param storage Storage backend instance; defaults to AppData/stopwatches.json on a background writer.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit StopwatchBank(QObject *parent = nullptr, std::unique_ptr<IStopwatchStorage> storage = {});
+
+/**
+ * @brief Get count.
+ * @details Returns the number of stopwatches.
+ * @return Count value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int count() const;
+/**
+ * @brief Add stopwatch.
+ * @details Appends a stopped stopwatch at zero.
+ * @param name Station name.
+ * @return Index of the new stopwatch.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int addStopwatch(const QString &name);
+/**
+ * @brief Remove stopwatch.
+ * @details Removes one stopwatch; later indices shift down by one.
+ * @param index Zero-based index.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void removeStopwatch(int index);
+/**
+ * @brief Get name.
+ * @details Returns the station name.
+ * @param index Zero-based index.
+ * @return Formatted string value, or an empty string when out of range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString name(int index) const;
+/**
+ * @brief Is running.
+ * @details Returns the running bit of one stopwatch.
+ * @param index Zero-based index.
+ * @return True if the stopwatch is running.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isRunning(int index) const;
+/**
+ * @brief Get running count.
+ * @details Returns how many stopwatches are running, kept up to date by every operation.
+ * @return Count value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int runningCount() const;
+/**
+ * @brief Get elapsed time.
+ * @details Computed on demand from the accumulated time plus the running segment.
+ * @param index Zero-based index.
+ * @return Elapsed duration, or zero when out of range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    StopwatchTime::Duration elapsed(int index) const;
+/**
+ * @brief Get elapsed time at an instant.
+ * @details Lets callers evaluate many stopwatches against one clock reading.
+ * @param index Zero-based index.
+ * @param now Clock reading.
+ * @return Elapsed duration, or zero when out of range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    StopwatchTime::Duration elapsedAt(int index, Clock::time_point now) const;
+/**
+ * @brief Get lap durations.
+ * @details Returns the lap segments of one stopwatch.
+ * @param index Zero-based index.
+ * @return List of values; empty when out of range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QList<StopwatchTime::Duration> lapDurations(int index) const;
+
+/**
+ * @brief Start stopwatches.
+ * @details Starts every listed stopwatch that is stopped, at one shared instant.
+ * @param indices Zero-based indices; invalid ones are skipped.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void start(const QList<int> &indices);
+/**
+ * @brief Stop stopwatches.
+ * @details Stops every listed stopwatch that is running, at one shared instant.
+ * @param indices Zero-based indices; invalid ones are skipped.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void stop(const QList<int> &indices);
+/**
+ * @brief Record laps.
+ * @details Records a lap on every listed running stopwatch, at one shared instant.
+ * @param indices Zero-based indices; invalid or stopped ones are skipped.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void lap(const QList<int> &indices);
+/**
+ * @brief Reset stopwatches.
+ * @details Stops the listed stopwatches and clears their time and laps.
+ * @param indices Zero-based indices; invalid ones are skipped.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void reset(const QList<int> &indices);
+/**
+ * @brief Start all.
+ * @details Starts every stopped stopwatch at one shared instant.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void startAll();
+/**
+ * @brief Stop all.
+ * @details Stops every running stopwatch at one shared instant.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void stopAll();
+
+/**
+ * @brief Load operation.
+ * @details Reads persisted state into the object.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool load();
+/**
+ * @brief Save operation.
+ * @details Writes current state to persistent storage.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool save() const;
+/**
+ * @brief Set storage backend.
+ * @details Replaces the storage backend.
+ * @param storage Storage backend instance.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setStorage(std::unique_ptr<IStopwatchStorage> storage);
+
+signals:
+/**
+ * @brief Emitted when stopwatches are added, removed or loaded.
+ * @details Signal emitted when the set of stopwatches changes.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void stopwatchesChanged();
+/**
+ * @brief Emitted when stopwatches start, stop or reset.
+ * @details Signal emitted once per bulk operation.
+ * @param indices Stopwatches whose state changed.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void stateChanged(const QList<int> &indices);
+/**
+ * @brief Emitted when laps are recorded.
+ * @details Signal emitted once per bulk lap operation.
+ * @param indices Stopwatches that recorded a lap.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void lapsRecorded(const QList<int> &indices);
+
+private:
+/**
+ * @brief Is valid index.
+ * @details Returns whether the index addresses a stopwatch.
+ * @param index Zero-based index.
+ * @return True if in range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isValid(int index) const;
+/**
+ * @brief All indices.
+ * @details Returns 0..count()-1.
+ * @return List of values.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QList<int> allIndices() const;
+
+    QStringList names;                              /**< Station names. */
+    QList<StopwatchTime::Duration> accumulated;     /**< Time accumulated before the current run. */
+    QList<Clock::time_point> startStamps;           /**< Monotonic start of the current run. */
+    QBitArray running;                              /**< Running bit per stopwatch. */
+    QList<StopwatchTime::Duration> lastSplits;      /**< Cumulative time at the last lap. */
+    QList<QList<StopwatchTime::Duration>> laps;     /**< Lap segments per stopwatch. */
+    int runningTotal = 0;                           /**< Number of set running bits. */
+    std::unique_ptr<IStopwatchStorage> storage;     /**< Owned storage backend. */
+};
+
+#endif // STOPWATCHBANK_H
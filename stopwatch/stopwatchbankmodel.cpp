@@ -0,0 +1,80 @@
+/**
+ * @file stopwatchbankmodel.cpp
+ * @brief Definitions for stopwatchbankmodel.
+ * @details Implements logic declared in the corresponding header for stopwatchbankmodel.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "stopwatchbankmodel.h"
+#include <QFont>
+
+StopwatchBankModel::StopwatchBankModel(StopwatchBank *bank, QObject *parent)
+    : QAbstractListModel(parent)
+    , bank(bank)
+{
+    connect(bank, &StopwatchBank::stopwatchesChanged, this, [this]() {
+        beginResetModel();
+        endResetModel();
+    });
+    connect(bank, &StopwatchBank::stateChanged, this, &StopwatchBankModel::onRowsChanged);
+    connect(bank, &StopwatchBank::lapsRecorded, this, &StopwatchBankModel::onRowsChanged);
+}
+
+int StopwatchBankModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : bank->count();
+}
+
+QVariant StopwatchBankModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= bank->count())
+        return {};
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return rowText(index.row());
+    case Qt::FontRole:
+        if (bank->isRunning(index.row())) {
+            QFont font;
+            font.setBold(true);
+            return font;
+        }
+        break;
+    }
+    return {};
+}
+
+QString StopwatchBankModel::rowText(int row) const
+{
+    const int lapCount = bank->lapDurations(row).size();
+    QString text = bank->name(row) + "  " + StopwatchTime::format(bank->elapsed(row));
+    if (lapCount > 0)
+        text += QString("  (%1 laps)").arg(lapCount);
+    return text;
+}
+
+void StopwatchBankModel::refreshRunning()
+{
+    if (bank->runningCount() == 0)
+        return;
+    const int n = bank->count();
+    int first = -1;
+    for (int row = 0; row <= n; ++row) {
+        const bool live = row < n && bank->isRunning(row);
+        if (live && first < 0) {
+            first = row;
+        } else if (!live && first >= 0) {
+            emit dataChanged(index(first), index(row - 1), {Qt::DisplayRole});
+            first = -1;
+        }
+    }
+}
+
+void StopwatchBankModel::onRowsChanged(const QList<int> &rows)
+{
+    for (int row : rows)
+        emit dataChanged(index(row), index(row), {Qt::DisplayRole, Qt::FontRole});
+}
@@ -0,0 +1,92 @@
+/**
+ * @file stopwatchbankmodel.h
+ * @brief Declarations for stopwatchbankmodel.
+ * @details Defines a list model presenting the stopwatches of a StopwatchBank.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef STOPWATCHBANKMODEL_H
+#define STOPWATCHBANKMODEL_H
+
+#include <QAbstractListModel>
+#include "stopwatchbank.h"
+
+/**
+ * @brief StopwatchBankModel list model over StopwatchBank.
+ * @details One row per stopwatch showing "name  elapsed  (laps)". Frame
+ * refreshes only report the rows that are running, so stopped rows are not
+ * repainted while other stations keep counting.
+ * @note Public API is documented per member.
+ * @warning The bank must outlive the model.
+ * @sa SmartClock
+ */
+class StopwatchBankModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+/**
+ * @brief Create StopwatchBankModel instance.
+ * @details Initializes instance state and follows the bank's signals.
+ * @param bank Stopwatch bank to present.
+ * @param parent Parent QObject.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit StopwatchBankModel(StopwatchBank *bank, QObject *parent = nullptr);
+
+/**
+ * @brief Row count.
+ * @details Returns the number of stopwatches.
+ * @param parent Parent index.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+/**
+ * @brief Data.
+ * @details Returns the row text and bolds running rows.
+ * @param index Row index.
+ * @param role Data role.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+/**
+ * @brief Row text.
+ * @details Formats one stopwatch for display.
+ * @param row Zero-based row.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString rowText(int row) const;
+
+public slots:
+/**
+ * @brief Refresh running rows.
+ * @details Emits dataChanged once per contiguous block of running rows; stopped rows are left alone.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void refreshRunning();
+
+private slots:
+/**
+ * @brief On rows changed.
+ * @details Emits dataChanged for the given rows after a start, stop, reset or lap.
+ * @param rows Zero-based rows.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onRowsChanged(const QList<int> &rows);
+
+private:
+    StopwatchBank *bank; /**< Source of stopwatch data. */
+};
+
+#endif // STOPWATCHBANKMODEL_H
@@ -0,0 +1,128 @@
+/**
+ * @file stopwatchbankwindow.cpp
+ * @brief Definitions for stopwatchbankwindow.
+ * @details Implements logic declared in the corresponding header for stopwatchbankwindow.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "stopwatchbankwindow.h"
+#include <QHBoxLayout>
+#include <QItemSelectionModel>
+#include <QVBoxLayout>
+#include <algorithm>
+
+StopwatchBankWindow::StopwatchBankWindow(QWidget *parent, StopwatchBank *bank)
+    : QDialog(parent)
+    , bank(bank ? bank : new StopwatchBank(this))
+    , model(new StopwatchBankModel(this->bank, this))
+    , list(new QListView(this))
+    , refresh(new RefreshScheduler(list, this))
+    , saver(new DebouncedSaver([b = this->bank]() { return b->save(); }, this))
+{
+    setWindowTitle("Stopwatch stations");
+
+    list->setModel(model);
+    list->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    list->setUniformItemSizes(true);
+
+    QPushButton *btnAdd = new QPushButton("Add", this);
+    btnRemove = new QPushButton("Remove", this);
+    btnStartStop = new QPushButton("Start", this);
+    btnLap = new QPushButton("Lap", this);
+    QPushButton *btnStartAll = new QPushButton("Start all", this);
+    QPushButton *btnStopAll = new QPushButton("Stop all", this);
+
+    QHBoxLayout *selectedLayout = new QHBoxLayout();
+    selectedLayout->addWidget(btnAdd);
+    selectedLayout->addWidget(btnRemove);
+    selectedLayout->addWidget(btnLap);
+    selectedLayout->addWidget(btnStartStop);
+
+    QHBoxLayout *allLayout = new QHBoxLayout();
+    allLayout->addWidget(btnStartAll);
+    allLayout->addWidget(btnStopAll);
+
+    QVBoxLayout *layoutMain = new QVBoxLayout(this);
+    layoutMain->addWidget(list);
+    layoutMain->addLayout(selectedLayout);
+    layoutMain->addLayout(allLayout);
+
+    refresh->setHiddenInterval(0);
+    connect(refresh, &RefreshScheduler::tick, model, &StopwatchBankModel::refreshRunning);
+
+    connect(btnAdd, &QPushButton::clicked, this, &StopwatchBankWindow::onAddClicked);
+    connect(btnRemove, &QPushButton::clicked, this, [this]() {
+        const QList<int> rows = selectedIndices();
+        for (auto it = rows.crbegin(); it != rows.crend(); ++it)
+            this->bank->removeStopwatch(*it);
+    });
+    connect(btnStartStop, &QPushButton::clicked, this, &StopwatchBankWindow::onStartStopClicked);
+    connect(btnLap, &QPushButton::clicked, this, [this]() { this->bank->lap(selectedIndices()); });
+    connect(btnStartAll, &QPushButton::clicked, this->bank, &StopwatchBank::startAll);
+    connect(btnStopAll, &QPushButton::clicked, this->bank, &StopwatchBank::stopAll);
+
+    connect(this->bank, &StopwatchBank::stopwatchesChanged, this, &StopwatchBankWindow::syncFromBank);
+    connect(this->bank, &StopwatchBank::stateChanged, this, &StopwatchBankWindow::syncFromBank);
+    connect(list->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &StopwatchBankWindow::syncFromBank);
+
+    if (!bank)
+        this->bank->load();
+    syncFromBank();
+
+    connect(this->bank, &StopwatchBank::stopwatchesChanged, saver, &DebouncedSaver::markDirty);
+    connect(this->bank, &StopwatchBank::stateChanged, saver, &DebouncedSaver::markDirty);
+    connect(this->bank, &StopwatchBank::lapsRecorded, saver, &DebouncedSaver::markDirty);
+    connect(this, &QObject::destroyed, saver, &DebouncedSaver::flush);
+}
+
+StopwatchBank *StopwatchBankWindow::stopwatchBank() const
+{
+    return bank;
+}
+
+StopwatchBankModel *StopwatchBankWindow::listModel() const
+{
+    return model;
+}
+
+void StopwatchBankWindow::onAddClicked()
+{
+    bank->addStopwatch(QString("Station %1").arg(bank->count() + 1));
+}
+
+void StopwatchBankWindow::onStartStopClicked()
+{
+    const QList<int> rows = selectedIndices();
+    const bool anyRunning = std::any_of(rows.cbegin(), rows.cend(),
+                                        [this](int row) { return bank->isRunning(row); });
+    if (anyRunning)
+        bank->stop(rows);
+    else
+        bank->start(rows);
+}
+
+void StopwatchBankWindow::syncFromBank()
+{
+    const QList<int> rows = selectedIndices();
+    const bool anyRunning = std::any_of(rows.cbegin(), rows.cend(),
+                                        [this](int row) { return bank->isRunning(row); });
+    btnStartStop->setEnabled(!rows.isEmpty());
+    btnStartStop->setText(anyRunning ? "Stop" : "Start");
+    btnLap->setEnabled(anyRunning);
+    btnRemove->setEnabled(!rows.isEmpty());
+
+    refresh->setActive(bank->runningCount() > 0);
+}
+
+QList<int> StopwatchBankWindow::selectedIndices() const
+{
+    QList<int> rows;
+    for (const QModelIndex &index : list->selectionModel()->selectedRows())
+        rows.append(index.row());
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file stopwatchbankwindow.h
+ * @brief Declarations for stopwatchbankwindow.
+ * @details Defines the window listing the stopwatches of a StopwatchBank.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef STOPWATCHBANKWINDOW_H
+#define STOPWATCHBANKWINDOW_H
+
+#include <QDialog>
+#include <QListView>
+#include <QPushButton>
+#include "stopwatchbank.h"
+#include "stopwatchbankmodel.h"
+#include "../refreshscheduler.h"
+#include "../storage/debouncedsaver.h"
+
+/**
+ * @brief StopwatchBankWindow Top-level window UI class.
+ * @details Shows several named stopwatches in one list. Selected rows can
+ * be started, stopped or lapped together; the list repaints only running
+ * rows, and only while at least one stopwatch runs.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+class StopwatchBankWindow : public QDialog
+{
+    Q_OBJECT
+
+public:
+/**
+ * @brief Create StopwatchBankWindow instance.
+ * @details Builds the list and buttons and loads the persisted bank.
+ * @param parent Parent QObject.
+ * @param bank Bank to show; when null the window creates and owns one on default storage.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit StopwatchBankWindow(QWidget *parent = nullptr, StopwatchBank *bank = nullptr);
+
+/**
+ * @brief Get bank.
+ * @details Returns the bank shown by the window.
+ * @return Pointer to the bank.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    StopwatchBank *stopwatchBank() const;
+/**
+ * @brief Get list model.
+ * @details Returns the model behind the list view.
+ * @return Pointer to the model.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    StopwatchBankModel *listModel() const;
+
+private slots:
+/**
+ * @brief On add clicked.
+ * @details Appends a new station named after its position.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onAddClicked();
+/**
+ * @brief On start stop clicked.
+ * @details Stops the selected stopwatches if any of them runs, otherwise starts them.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onStartStopClicked();
+/**
+ * @brief Sync from bank.
+ * @details Updates button states and activates the refresh driver while any stopwatch runs.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void syncFromBank();
+
+private:
+/**
+ * @brief Selected indices.
+ * @details Returns the selected rows in ascending order.
+ * @return List of values.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QList<int> selectedIndices() const;
+
+    StopwatchBank *bank; /**< Stopwatches shown by the window. */
+    StopwatchBankModel *model; /**< List model over the bank. */
+    QListView *list; /**< Station list. */
+    RefreshScheduler *refresh; /**< Frame driver for running rows. */
+    DebouncedSaver *saver; /**< Coalesces bank saves. */
+    QPushButton *btnStartStop; /**< Start/stop selected stations. */
+    QPushButton *btnLap; /**< Lap selected stations. */
+    QPushButton *btnRemove; /**< Remove selected stations. */
+};
+
+#endif // STOPWATCHBANKWINDOW_H
@@ -10,11 +10,13 @@
 
 #include "stopwatchmodel.h"
 #include "jsonstopwatchstorage.h"
+#include "../storage/asyncstorage.h"
 #include <algorithm>
+#include <cmath>
 
 StopwatchModel::StopwatchModel(QObject *parent, std::unique_ptr<IStopwatchStorage> storage)
     : QObject(parent)
-    , storage(storage ? std::move(storage) : std::make_unique<JsonStopwatchStorage>())
+    , storage(storage ? std::move(storage) : std::make_unique<AsyncStorage<IStopwatchStorage, StopwatchSnapshot>>(std::make_unique<JsonStopwatchStorage>()))
 {
 }
 
@@ -23,44 +25,91 @@ bool StopwatchModel::isRunning() const
     return running;
 }
 
-int StopwatchModel::elapsedMs() const
+qint64 StopwatchModel::elapsedMs() const
 {
-    return elapsed;
+    return StopwatchTime::toMs(elapsed());
 }
 
-QTime StopwatchModel::elapsedTime() const
+StopwatchTime::Duration StopwatchModel::elapsed() const
 {
-    return QTime(0, 0).addMSecs(elapsed);
+    if (!running)
+        return accumulated;
+    const auto run = std::chrono::steady_clock::now() - runStart;
+    return accumulated + std::chrono::duration_cast<StopwatchTime::Duration>(run);
 }
 
 QString StopwatchModel::formattedElapsed() const
 {
-    return elapsedTime().toString("mm:ss.zzz").left(8);
+    return StopwatchTime::format(elapsed());
 }
 
-const QList<int>& StopwatchModel::lapDurations() const
+const QList<StopwatchTime::Duration>& StopwatchModel::lapDurations() const
 {
     return laps;
 }
 
+const QList<StopwatchTime::Duration>& StopwatchModel::splitTimes() const
+{
+    return splits;
+}
+
+StopwatchTime::Duration StopwatchModel::lapDuration(int index) const
+{
+    return index >= 0 && index < laps.size() ? laps[index] : StopwatchTime::Duration::zero();
+}
+
+StopwatchTime::Duration StopwatchModel::splitTime(int index) const
+{
+    return index >= 0 && index < splits.size() ? splits[index] : StopwatchTime::Duration::zero();
+}
+
+LapStatistics StopwatchModel::lapStatistics() const
+{
+    LapStatistics stats;
+    stats.count = laps.size();
+    if (stats.count == 0)
+        return stats;
+    stats.meanUs = lapMean;
+    stats.best = laps[bestLap];
+    stats.worst = laps[worstLap];
+    stats.stdDevUs = std::sqrt(lapM2 / stats.count);
+    return stats;
+}
+
 QStringList StopwatchModel::lapTexts() const
 {
     QStringList out;
-    int accMs = 0;
-    for (int i = 0; i < laps.size(); ++i) {
-        accMs += laps[i];
-        QString lapTimeStr = QTime(0, 0).addMSecs(accMs).toString("mm:ss.zzz").left(8);
-        QString deltaStr = QTime(0, 0).addMSecs(laps[i]).toString("mm:ss.zzz").left(8);
-        out << QString("Lap %1: %2 (+%3)").arg(i + 1).arg(lapTimeStr).arg(deltaStr);
-    }
+    out.reserve(laps.size());
+    for (int i = 0; i < laps.size(); ++i)
+        out << lapText(i);
     return out;
 }
 
+QString StopwatchModel::lapText(int index) const
+{
+    if (index < 0 || index >= laps.size())
+        return {};
+    return QString("Lap %1: %2 (+%3)")
+        .arg(index + 1)
+        .arg(StopwatchTime::format(splits[index]), StopwatchTime::format(laps[index]));
+}
+
+int StopwatchModel::bestLapIndex() const
+{
+    return bestLap;
+}
+
+int StopwatchModel::worstLapIndex() const
+{
+    return worstLap;
+}
+
 void StopwatchModel::start()
 {
     if (running)
         return;
     running = true;
+    runStart = std::chrono::steady_clock::now();
     emit stateChanged();
 }
 
@@ -68,22 +117,24 @@ void StopwatchModel::stop()
 {
     if (!running)
         return;
+    accumulated = elapsed();
     running = false;
     emit stateChanged();
 }
 
-void StopwatchModel::tick(int ms)
+void StopwatchModel::tick(qint64 ms)
 {
     if (!running || ms <= 0)
         return;
-    elapsed = std::max(0, elapsed + ms);
+    accumulated += StopwatchTime::fromMs(ms);
 }
 
 void StopwatchModel::reset()
 {
     running = false;
-    elapsed = 0;
+    accumulated = StopwatchTime::Duration::zero();
     laps.clear();
+    clearLapIndex();
     emit stateChanged();
     emit lapsChanged();
 }
@@ -92,14 +143,10 @@ void StopwatchModel::addLap()
 {
     if (!running)
         return;
-    int sum = 0;
-    for (int d : laps)
-        sum += d;
-    int segMs = elapsed - sum;
-    if (segMs < 0)
-        segMs = 0;
-    laps.append(segMs);
-    emit lapsChanged();
+    const StopwatchTime::Duration lastSplit = splits.isEmpty() ? StopwatchTime::Duration::zero() : splits.last();
+    laps.append(std::max(StopwatchTime::Duration::zero(), elapsed() - lastSplit));
+    accumulateLap(laps.size() - 1);
+    emit lapAdded(laps.size() - 1);
 }
 
 bool StopwatchModel::load()
@@ -109,9 +156,15 @@ bool StopwatchModel::load()
     StopwatchSnapshot snap;
     if (!storage->load(snap))
         return false;
-    elapsed = std::max(0, snap.elapsedMs);
+    accumulated = std::max(StopwatchTime::Duration::zero(), snap.elapsed);
     running = snap.running;
+    if (running)
+        runStart = std::chrono::steady_clock::now();
     laps = snap.lapDurations;
+    clearLapIndex();
+    splits.reserve(laps.size());
+    for (int i = 0; i < laps.size(); ++i)
+        accumulateLap(i);
     emit stateChanged();
     emit lapsChanged();
     return true;
@@ -122,7 +175,7 @@ bool StopwatchModel::save() const
     if (!storage)
         return false;
     StopwatchSnapshot snap;
-    snap.elapsedMs = elapsed;
+    snap.elapsed = elapsed();
     snap.running = running;
     snap.lapDurations = laps;
     return storage->save(snap);
@@ -132,3 +185,29 @@ void StopwatchModel::setStorage(std::unique_ptr<IStopwatchStorage> storage)
 {
     this->storage = std::move(storage);
 }
+
+void StopwatchModel::accumulateLap(int index)
+{
+    const StopwatchTime::Duration seg = laps[index];
+    splits.append((splits.isEmpty() ? StopwatchTime::Duration::zero() : splits.last()) + seg);
+
+    if (bestLap < 0 || seg < laps[bestLap])
+        bestLap = index;
+    if (worstLap < 0 || seg > laps[worstLap])
+        worstLap = index;
+
+    const double us = double(seg.count());
+    const double n = index + 1;
+    const double delta = us - lapMean;
+    lapMean += delta / n;
+    lapM2 += delta * (us - lapMean);
+}
+
+void StopwatchModel::clearLapIndex()
+{
+    splits.clear();
+    bestLap = -1;
+    worstLap = -1;
+    lapMean = 0.0;
+    lapM2 = 0.0;
+}
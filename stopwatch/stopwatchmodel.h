@@ -14,9 +14,25 @@
 #include <QObject>
 #include <QList>
 #include <QStringList>
-#include <QTime>
+#include <chrono>
 #include <memory>
 #include "istopwatchstorage.h"
+#include "stopwatchtime.h"
+
+/**
+ * @brief LapStatistics Summary of recorded lap segments.
+ * @details Maintained incrementally by StopwatchModel as laps are added.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+struct LapStatistics {
+    int count = 0;                          /**< Number of laps. */
+    double meanUs = 0.0;                    /**< Mean segment duration (microseconds). */
+    StopwatchTime::Duration best{0};        /**< Shortest segment; zero when empty. */
+    StopwatchTime::Duration worst{0};       /**< Longest segment; zero when empty. */
+    double stdDevUs = 0.0;                  /**< Population standard deviation of segments (microseconds). */
+};
 
 /**
  * @brief StopwatchModel Data model holding state and exposing operations for the UI.
@@ -49,23 +65,23 @@ public:
     bool isRunning() const;
 /**
  * @brief Get elapsed time in milliseconds.
- * @details Performs the operation and updates state as needed.
+ * @details Computed on demand from the accumulated time plus the running monotonic segment.
  * @return Elapsed time in milliseconds.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    int elapsedMs() const;
+    qint64 elapsedMs() const;
 /**
- * @brief Get elapsed time as QTime.
- * @details Performs the operation and updates state as needed.
- * @return Elapsed time as QTime.
+ * @brief Get elapsed time.
+ * @details Computed on demand at microsecond resolution; does not wrap at 24 h.
+ * @return Elapsed duration.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    QTime elapsedTime() const;
+    StopwatchTime::Duration elapsed() const;
 /**
  * @brief Get formatted elapsed time string.
- * @details Performs the operation and updates state as needed.
+ * @details Formats with StopwatchTime::format(), adding hours and days when needed.
  * @return Formatted string value.
  * @note Validate inputs where applicable.
  * @sa SmartClock
@@ -78,7 +94,41 @@ public:
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    const QList<int>& lapDurations() const;
+    const QList<StopwatchTime::Duration>& lapDurations() const;
+/**
+ * @brief Get split times.
+ * @details Returns the cumulative time at each lap, kept next to the segment durations.
+ * @return List of values; splitTimes()[i] is the sum of lapDurations()[0..i].
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    const QList<StopwatchTime::Duration>& splitTimes() const;
+/**
+ * @brief Get lap duration.
+ * @details Returns one lap segment in O(1).
+ * @param index Zero-based lap index.
+ * @return Segment duration, or zero when out of range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    StopwatchTime::Duration lapDuration(int index) const;
+/**
+ * @brief Get split time.
+ * @details Returns the cumulative time at the end of a lap in O(1).
+ * @param index Zero-based lap index.
+ * @return Cumulative duration, or zero when out of range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    StopwatchTime::Duration splitTime(int index) const;
+/**
+ * @brief Get lap statistics.
+ * @details Returns mean, best, worst and standard deviation of the lap segments without rescanning them.
+ * @return Statistics snapshot.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    LapStatistics lapStatistics() const;
 /**
  * @brief Get formatted lap strings.
  * @details Performs the operation and updates state as needed.
@@ -87,6 +137,31 @@ public:
  * @sa SmartClock
  */
     QStringList lapTexts() const;
+/**
+ * @brief Get formatted lap string.
+ * @details Formats a single lap as "Lap N: cumulative (+segment)".
+ * @param index Zero-based lap index.
+ * @return Formatted string value, or an empty string when out of range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString lapText(int index) const;
+/**
+ * @brief Get best lap index.
+ * @details Returns the shortest lap, tracked as laps are added; the first one wins ties.
+ * @return Zero-based lap index, or -1 when there are no laps.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int bestLapIndex() const;
+/**
+ * @brief Get worst lap index.
+ * @details Returns the longest lap, tracked as laps are added; the first one wins ties.
+ * @return Zero-based lap index, or -1 when there are no laps.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int worstLapIndex() const;
 
 /**
  * @brief Start operation.
@@ -104,12 +179,12 @@ public:
     void stop();
 /**
  * @brief Advance operation.
- * @details Advances time-based state by the provided delta.
+ * @details Adds a manual offset on top of the monotonic clock; the display refresh no longer calls this.
  * @param ms Time delta in milliseconds.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    void tick(int ms);
+    void tick(qint64 ms);
 /**
  * @brief Reset operation.
  * @details Transitions the state machine and notifies listeners.
@@ -119,7 +194,7 @@ public:
     void reset();
 /**
  * @brief Add lap.
- * @details Modifies the associated collection and notifies listeners.
+ * @details Appends the current segment, updates best/worst and emits lapAdded().
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
@@ -160,17 +235,47 @@ signals:
     void stateChanged();
 /**
  * @brief Emitted when laps change.
- * @details Signal emitted when the associated state changes.
+ * @details Signal emitted when the whole lap list is replaced (reset or load).
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
     void lapsChanged();
+/**
+ * @brief Emitted when a lap is appended.
+ * @details Signal emitted by addLap(); listeners append one row instead of rebuilding.
+ * @param index Zero-based index of the new lap.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void lapAdded(int index);
 
 private:
-    int elapsed = 0;                                /**< Total elapsed time (milliseconds). */
+    StopwatchTime::Duration accumulated{0};         /**< Time accumulated before the current run. */
     bool running = false;                           /**< True while stopwatch is running. */
-    QList<int> laps;                                /**< Lap segment durations (milliseconds). */
+    std::chrono::steady_clock::time_point runStart; /**< Monotonic start of the current run. */
+    QList<StopwatchTime::Duration> laps;            /**< Lap segment durations. */
+    QList<StopwatchTime::Duration> splits;          /**< Cumulative time at each lap. */
+    int bestLap = -1;                               /**< Index of the shortest lap, or -1. */
+    int worstLap = -1;                              /**< Index of the longest lap, or -1. */
+    double lapMean = 0.0;                           /**< Running mean of lap segments in microseconds (Welford). */
+    double lapM2 = 0.0;                             /**< Running sum of squared deviations (Welford). */
     std::unique_ptr<IStopwatchStorage> storage;     /**< Owned storage backend. */
+
+/**
+ * @brief Accumulate lap.
+ * @details Folds one lap into the split times, best/worst indices and running statistics.
+ * @param index Zero-based lap index.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void accumulateLap(int index);
+/**
+ * @brief Clear lap index.
+ * @details Drops split times and statistics derived from the laps.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void clearLapIndex();
 };
 
 #endif // STOPWATCHMODEL_H
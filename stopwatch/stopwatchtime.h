@@ -0,0 +1,83 @@
+/**
+ * @file stopwatchtime.h
+ * @brief Declarations for stopwatchtime.
+ * @details Defines the 64-bit microsecond time base shared by the stopwatch model, storage and views.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef STOPWATCHTIME_H
+#define STOPWATCHTIME_H
+
+#include <QString>
+#include <chrono>
+
+/**
+ * @brief StopwatchTime Stopwatch time base.
+ * @details Durations are signed 64-bit microsecond counts, which cover
+ * about 292,000 years, so multi-day runs neither overflow nor wrap at 24 h
+ * the way QTime does.
+ * @sa SmartClock
+ */
+namespace StopwatchTime {
+
+using Duration = std::chrono::microseconds; /**< Stopwatch duration (int64 microseconds). */
+
+/**
+ * @brief From milliseconds.
+ * @details Converts a millisecond count to a Duration.
+ * @param ms Milliseconds.
+ * @return Duration value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline Duration fromMs(qint64 ms)
+{
+    return std::chrono::duration_cast<Duration>(std::chrono::milliseconds(ms));
+}
+
+/**
+ * @brief To milliseconds.
+ * @details Converts a Duration to whole milliseconds, truncating.
+ * @param d Duration value.
+ * @return Milliseconds.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline qint64 toMs(Duration d)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+}
+
+/**
+ * @brief Format duration.
+ * @details Formats as "mm:ss.cc" below one hour, "h:mm:ss.cc" below one day
+ * and "Nd hh:mm:ss.cc" beyond; hundredths are truncated, negative values show as zero.
+ * @param d Duration value.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline QString format(Duration d)
+{
+    const qint64 totalCs = d.count() > 0 ? d.count() / 10000 : 0;
+    const qint64 cs = totalCs % 100;
+    const qint64 totalSec = totalCs / 100;
+    const qint64 sec = totalSec % 60;
+    const qint64 min = (totalSec / 60) % 60;
+    const qint64 hours = (totalSec / 3600) % 24;
+    const qint64 days = totalSec / 86400;
+
+    const auto two = [](qint64 v) { return QString::number(v).rightJustified(2, QLatin1Char('0')); };
+    const QString tail = two(min) + QLatin1Char(':') + two(sec) + QLatin1Char('.') + two(cs);
+    if (days > 0)
+        return QString::number(days) + QLatin1String("d ") + two(hours) + QLatin1Char(':') + tail;
+    if (hours > 0)
+        return QString::number(hours) + QLatin1Char(':') + tail;
+    return tail;
+}
+
+} // namespace StopwatchTime
+
+#endif // STOPWATCHTIME_H
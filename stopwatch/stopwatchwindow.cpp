@@ -77,7 +77,7 @@ public:
 StopwatchWindow::StopwatchWindow(QWidget *parent)
     : QDialog(parent)
     , ui(new Ui::StopwatchWindow)
-    , timer(new QTimer(this))
+    , refresh(new RefreshScheduler(this, this))
     , model(new StopwatchModel(this))
 {
     ui->setupUi(this);
@@ -87,9 +87,12 @@ StopwatchWindow::StopwatchWindow(QWidget *parent)
     ui->listLaps->setVisible(false);
     ui->labelTime->setText("00:00.00");
 
-    connect(timer, &QTimer::timeout, this, &StopwatchWindow::updateDisplay);
+    refresh->setHiddenInterval(0);
+    connect(refresh, &RefreshScheduler::tick, this, &StopwatchWindow::updateDisplay);
     connect(ui->btnStartStop, &QPushButton::clicked, this, &StopwatchWindow::onStartStopClicked);
     connect(ui->btnLap, &QPushButton::clicked, this, &StopwatchWindow::onLapClicked);
+    connect(model, &StopwatchModel::lapAdded, this, &StopwatchWindow::onLapAdded);
+    connect(model, &StopwatchModel::lapsChanged, this, &StopwatchWindow::rebuildLaps);
 
     analogDial = new AnalogStopwatchDial(this);
     analogDial->setFixedSize(250, 250);
@@ -113,7 +116,21 @@ StopwatchWindow::StopwatchWindow(QWidget *parent)
     btnSwitch->setToolTip("Switch stopwatch view");
     btnSwitch->setStyleSheet("QPushButton { border: none; } QPushButton:hover { background-color: #f0f0f0; border-radius: 6px; }");
 
-    layoutMain->insertWidget(1, btnSwitch, 0, Qt::AlignHCenter);
+    QPushButton *btnStations = new QPushButton("Stations", this);
+    btnStations->setToolTip("Run several stopwatches side by side");
+    connect(btnStations, &QPushButton::clicked, this, [this]() {
+        if (!bankWindow)
+            bankWindow = new StopwatchBankWindow(this);
+        bankWindow->show();
+        bankWindow->raise();
+    });
+
+    QHBoxLayout *toolsLayout = new QHBoxLayout();
+    toolsLayout->addStretch();
+    toolsLayout->addWidget(btnSwitch);
+    toolsLayout->addWidget(btnStations);
+    toolsLayout->addStretch();
+    layoutMain->insertLayout(1, toolsLayout);
 
     QHBoxLayout *buttonsLayout = new QHBoxLayout();
     buttonsLayout->addWidget(ui->btnLap);
@@ -125,7 +142,7 @@ StopwatchWindow::StopwatchWindow(QWidget *parent)
     analogMode = settings.value("analogMode", false).toBool();
     stackedView->setCurrentIndex(analogMode ? 1 : 0);
     if (analogMode)
-        analogDial->setElapsed(model->elapsedTime());
+        analogDial->setElapsed(model->elapsed());
 
     QGraphicsOpacityEffect *fadeEffect = new QGraphicsOpacityEffect(this);
     stackedView->setGraphicsEffect(fadeEffect);
@@ -146,7 +163,7 @@ StopwatchWindow::StopwatchWindow(QWidget *parent)
         connect(fadeOut, &QPropertyAnimation::finished, this, [=]() mutable {
             stackedView->setCurrentIndex(analogMode ? 1 : 0);
             if (analogMode)
-                analogDial->setElapsed(model->elapsedTime());
+                analogDial->setElapsed(model->elapsed());
             fadeIn->start(QAbstractAnimation::DeleteWhenStopped);
         });
 
@@ -169,27 +186,17 @@ void StopwatchWindow::syncFromModel()
 {
     ui->labelTime->setText(model->formattedElapsed());
     if (analogMode)
-        analogDial->setElapsed(model->elapsedTime());
+        analogDial->setElapsed(model->elapsed());
 
-    ui->listLaps->clear();
-    const QStringList texts = model->lapTexts();
-    for (const QString &text : texts)
-        ui->listLaps->insertItem(0, text);
-    ui->listLaps->setVisible(!texts.isEmpty());
+    if (ui->listLaps->count() != model->lapDurations().size())
+        rebuildLaps();
 
     const bool hasData = model->elapsedMs() > 0 || !model->lapDurations().isEmpty();
     ui->btnLap->setEnabled(model->isRunning() || hasData);
     ui->btnLap->setText(model->isRunning() ? "Lap" : (hasData ? "Reset" : "Lap"));
     ui->btnStartStop->setText(model->isRunning() ? "Stop" : "Start");
 
-    if (model->isRunning()) {
-        if (!timer->isActive())
-            timer->start(10);
-    } else if (timer->isActive()) {
-        timer->stop();
-    }
-
-    updateLapColors();
+    refresh->setActive(model->isRunning());
 }
 
 void StopwatchWindow::onStartStopClicked()
@@ -199,10 +206,9 @@ void StopwatchWindow::onStartStopClicked()
 
 void StopwatchWindow::updateDisplay()
 {
-    model->tick(10);
     ui->labelTime->setText(model->formattedElapsed());
     if (analogMode)
-        analogDial->setElapsed(model->elapsedTime());
+        analogDial->setElapsed(model->elapsed());
 }
 
 void StopwatchWindow::onLapClicked()
@@ -210,44 +216,60 @@ void StopwatchWindow::onLapClicked()
     emit lapRequested();
 }
 
-void StopwatchWindow::updateLapColors()
+void StopwatchWindow::onLapAdded(int index)
 {
-    const auto &lapDurations = model->lapDurations();
-    if (lapDurations.isEmpty())
-        return;
+    ui->listLaps->insertItem(0, model->lapText(index));
+    ui->listLaps->setVisible(true);
+    updateLapFlags();
+}
 
-    int minIndex = 0, maxIndex = 0;
-    int minVal = lapDurations[0], maxVal = lapDurations[0];
+void StopwatchWindow::rebuildLaps()
+{
+    const QStringList texts = model->lapTexts();
+    QStringList newestFirst;
+    newestFirst.reserve(texts.size());
+    for (auto it = texts.crbegin(); it != texts.crend(); ++it)
+        newestFirst << *it;
 
-    for (int i = 1; i < lapDurations.size(); ++i) {
-        if (lapDurations[i] < minVal) { minVal = lapDurations[i]; minIndex = i; }
-        if (lapDurations[i] > maxVal) { maxVal = lapDurations[i]; maxIndex = i; }
-    }
+    ui->listLaps->clear();
+    ui->listLaps->addItems(newestFirst);
+    ui->listLaps->setVisible(!texts.isEmpty());
 
-    for (int i = 0; i < ui->listLaps->count(); ++i) {
-        if (auto *it = ui->listLaps->item(i)) {
-            it->setData(RoleLapFlag, 0);
-        }
-    }
+    shownBestLap = -1;
+    shownWorstLap = -1;
+    updateLapFlags();
+}
+
+void StopwatchWindow::updateLapFlags()
+{
+    const int best = model->bestLapIndex();
+    const int worst = model->worstLapIndex();
+    if (best == shownBestLap && worst == shownWorstLap)
+        return;
 
-    const int count = ui->listLaps->count();
-    const int invMin = count - 1 - minIndex;
-    const int invMax = count - 1 - maxIndex;
+    setLapFlag(shownBestLap, 0);
+    setLapFlag(shownWorstLap, 0);
+    setLapFlag(best, 1);
+    setLapFlag(worst, 2);
+    shownBestLap = best;
+    shownWorstLap = worst;
+}
 
-    if (invMin >= 0 && invMin < count)
-        ui->listLaps->item(invMin)->setData(RoleLapFlag, 1);
-    if (invMax >= 0 && invMax < count)
-        ui->listLaps->item(invMax)->setData(RoleLapFlag, 2);
-    ui->listLaps->viewport()->update();
+void StopwatchWindow::setLapFlag(int lapIndex, int flag)
+{
+    if (lapIndex < 0)
+        return;
+    // Newest lap is shown first.
+    const int row = ui->listLaps->count() - 1 - lapIndex;
+    if (QListWidgetItem *item = ui->listLaps->item(row))
+        item->setData(RoleLapFlag, flag);
 }
 
 QString StopwatchWindow::getCurrentLapTimeString() const
 {
     const auto &lapDurations = model->lapDurations();
-    if (!lapDurations.isEmpty()) {
-        const int segMs = lapDurations.last();
-        return QTime(0,0).addMSecs(segMs).toString("mm:ss.zzz").left(8);
-    }
+    if (!lapDurations.isEmpty())
+        return StopwatchTime::format(lapDurations.last());
     return "-";
 }
 
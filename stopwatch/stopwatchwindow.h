@@ -19,6 +19,8 @@
 #include <QGraphicsOpacityEffect>
 #include <QPropertyAnimation>
 #include "analogstopwatchdial.h"
+#include "stopwatchbankwindow.h"
+#include "../refreshscheduler.h"
 #include "stopwatchmodel.h"
 #include "../controllers/stopwatchcontroller.h"
 
@@ -125,10 +127,25 @@ private slots:
  * @sa SmartClock
  */
     void onLapClicked();
+/**
+ * @brief On lap added.
+ * @details Prepends one row for the new lap and moves the highlights.
+ * @param index Zero-based lap index.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onLapAdded(int index);
+/**
+ * @brief Rebuild laps.
+ * @details Refills the lap list after the model replaced all laps (reset or load).
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void rebuildLaps();
 
 private:
     Ui::StopwatchWindow *ui;
-    QTimer *timer;
+    RefreshScheduler *refresh; /**< Drives display updates at the screen rate while visible. */
     StopwatchModel *model;
     StopwatchController *controller;
 
@@ -136,13 +153,25 @@ private:
     bool analogMode = false; /**< Internal state value. */
 
 /**
- * @brief Update lap colors.
- * @details Performs the operation and updates state as needed.
+ * @brief Update lap flags.
+ * @details Moves the best/worst highlight to the model's current extremes, touching at most four rows.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void updateLapFlags();
+/**
+ * @brief Set lap flag.
+ * @details Sets the highlight flag of the row showing the given lap.
+ * @param lapIndex Zero-based lap index; -1 is ignored.
+ * @param flag 0 for none, 1 for best, 2 for worst.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    void updateLapColors();
+    void setLapFlag(int lapIndex, int flag);
+    int shownBestLap = -1; /**< Lap currently highlighted as best, or -1. */
+    int shownWorstLap = -1; /**< Lap currently highlighted as worst, or -1. */
     QStackedWidget *stackedView;
+    StopwatchBankWindow *bankWindow = nullptr; /**< Multi-station window, created on first use. */
 
     friend class StopwatchWindowTest_LapAndResetWork_Test;
 };
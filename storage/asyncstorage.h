@@ -0,0 +1,206 @@
+/**
+ * @file asyncstorage.h
+ * @brief Declarations for asyncstorage.
+ * @details Defines types and functions related to asyncstorage.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef ASYNCSTORAGE_H
+#define ASYNCSTORAGE_H
+
+#include <QDebug>
+#include <QFuture>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <utility>
+#include "storageworker.h"
+
+/**
+ * @brief SyncSaveScope RAII guard that makes AsyncStorage saves wait.
+ * @details While a scope is open on a thread, AsyncStorage::save() calls made on that
+ * thread block until the worker has written the snapshot and return its real result.
+ * DebouncedSaver::flush() opens one, so shutdown and explicit saves see write errors.
+ * @note Scopes nest.
+ * @warning Only open it where blocking the calling thread on disk I/O is acceptable.
+ * @sa SmartClock
+ */
+class SyncSaveScope
+{
+public:
+/**
+ * @brief Create SyncSaveScope instance.
+ * @details Makes saves on this thread synchronous until the scope closes.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    SyncSaveScope() { ++depth; }
+/**
+ * @brief Destroy SyncSaveScope instance.
+ * @details Closes the scope.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ~SyncSaveScope() { --depth; }
+    SyncSaveScope(const SyncSaveScope&) = delete;
+    SyncSaveScope& operator=(const SyncSaveScope&) = delete;
+
+/**
+ * @brief Is active.
+ * @details Returns whether a scope is open on the calling thread.
+ * @return True if saves should wait for their result.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static bool isActive() { return depth > 0; }
+
+private:
+    static inline thread_local int depth = 0; /**< Open scopes on this thread. */
+};
+
+/**
+ * @brief AsyncStorage adapter running a storage backend off the GUI thread.
+ * @details Wraps any of ITimerStorage, IAlarmStorage, IClockStorage or IStopwatchStorage and forwards calls to a StorageWorker,
+ * by default the one shared by all storages.
+ * @note Implements the wrapped interface, so models use it like any other storage.
+ * @warning The wrapped storage is only touched from the worker thread once wrapped.
+ * @sa SmartClock
+ */
+template <typename Interface, typename Snapshot>
+class AsyncStorage : public Interface
+{
+public:
+/**
+ * @brief Create AsyncStorage instance.
+ * @details Takes ownership of the storage to run on the worker thread.
+ * @param inner Wrapped storage.
+ * @param worker Worker running the jobs; must outlive this adapter.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit AsyncStorage(std::unique_ptr<Interface> inner, StorageWorker &worker = StorageWorker::shared())
+        : inner(std::move(inner))
+        , worker(worker)
+    {
+    }
+
+/**
+ * @brief Destroy AsyncStorage instance.
+ * @details Waits for queued jobs on the worker before releasing the wrapped storage.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ~AsyncStorage() override
+    {
+        worker.drain();
+    }
+
+/**
+ * @brief Save asynchronously.
+ * @details Copies the snapshot and writes it on the worker thread.
+ * @param in Input snapshot.
+ * @return Future holding the result of the wrapped save.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QFuture<bool> saveAsync(const Snapshot &in)
+    {
+        Interface *storage = inner.get();
+        return submitSave([storage, in]() { return storage && storage->save(in); });
+    }
+
+/**
+ * @brief Load asynchronously.
+ * @details Reads the snapshot on the worker thread after any queued saves.
+ * @return Future holding the snapshot, or no value on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QFuture<std::optional<Snapshot>> loadAsync()
+    {
+        Interface *storage = inner.get();
+        return worker.submit([storage]() -> std::optional<Snapshot> {
+            Snapshot out;
+            if (!storage || !storage->load(out))
+                return std::nullopt;
+            return out;
+        });
+    }
+
+/**
+ * @brief Load snapshot from storage.
+ * @details Blocks until the worker has read the snapshot, so it observes every earlier save.
+ * @param out Output snapshot to populate.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool load(Snapshot &out) override
+    {
+        const std::optional<Snapshot> loaded = loadAsync().result();
+        if (!loaded)
+            return false;
+        out = *loaded;
+        return true;
+    }
+
+/**
+ * @brief Save snapshot to storage.
+ * @details Queues the write. Inside a SyncSaveScope it waits and returns the write's result;
+ * otherwise it returns at once and reports whether the previous background write succeeded,
+ * so a failure surfaces on the next save at the latest.
+ * @param in Input snapshot.
+ * @return Result as described above; false without a wrapped storage.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool save(const Snapshot &in) override
+    {
+        if (!inner)
+            return false;
+        const bool earlierOk = !saveFailed.load();
+        const QFuture<bool> done = saveAsync(in);
+        return SyncSaveScope::isActive() ? done.result() : earlierOk;
+    }
+
+/**
+ * @brief Wait for idle.
+ * @details Blocks until every job queued on the worker so far has finished, including other storages' jobs.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void waitForIdle()
+    {
+        worker.drain();
+    }
+
+protected:
+/**
+ * @brief Submit save.
+ * @details Runs a write on the worker thread and records whether it failed.
+ * @param write Callable performing the write; returns true on success.
+ * @return Future holding the result of the write.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    template <typename Fn>
+    QFuture<bool> submitSave(Fn write)
+    {
+        std::atomic<bool> *failed = &saveFailed;
+        return worker.submit([write, failed]() {
+            const bool ok = write();
+            failed->store(!ok);
+            if (!ok)
+                qWarning() << "AsyncStorage: background save failed";
+            return ok;
+        });
+    }
+
+    std::unique_ptr<Interface> inner; /**< Wrapped storage, used on the worker thread. */
+    std::atomic<bool> saveFailed{false}; /**< True if the most recent finished write failed. */
+    StorageWorker &worker; /**< Worker thread running the wrapped storage. */
+};
+
+#endif // ASYNCSTORAGE_H
@@ -0,0 +1,67 @@
+/**
+ * @file atomicfile.cpp
+ * @brief Definitions for atomicfile.
+ * @details Implements logic declared in the corresponding header for atomicfile.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "atomicfile.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// QSaveFile syncs the file itself; the rename only survives a power cut once the directory is synced too.
+void syncDirectory(const QString &path)
+{
+#ifdef Q_OS_UNIX
+    const QByteArray dir = QFile::encodeName(QFileInfo(path).absolutePath());
+    const int fd = ::open(dir.constData(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    Q_UNUSED(path);
+#endif
+}
+
+} // namespace
+
+bool AtomicFile::write(const QString &path, const QByteArray &data, bool keepBackup)
+{
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+
+    if (f.write(data) != data.size()) {
+        f.cancelWriting();
+        return false;
+    }
+
+    if (keepBackup && QFile::exists(path)) {
+        const QString bak = backupPath(path);
+        QFile::remove(bak);
+        QFile::copy(path, bak);
+    }
+
+    if (!f.commit())
+        return false;
+
+    syncDirectory(path);
+    return true;
+}
+
+QString AtomicFile::backupPath(const QString &path)
+{
+    return path + ".bak";
+}
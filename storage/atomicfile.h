@@ -0,0 +1,48 @@
+/**
+ * @file atomicfile.h
+ * @brief Declarations for atomicfile.
+ * @details Defines types and functions related to atomicfile.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef ATOMICFILE_H
+#define ATOMICFILE_H
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * @brief AtomicFile crash-safe file writer shared by storage backends.
+ * @details Writes through QSaveFile, so the target is either the old or the new content, never a truncated mix.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+class AtomicFile
+{
+public:
+/**
+ * @brief Write data atomically.
+ * @details Writes to a temporary file, syncs it to disk and renames it over the target.
+ * @param path Filesystem path.
+ * @param data Bytes to write.
+ * @param keepBackup True to copy the previous content to backupPath() before replacing it.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static bool write(const QString &path, const QByteArray &data, bool keepBackup = false);
+/**
+ * @brief Backup path.
+ * @details Returns the rolling backup location for the given file.
+ * @param path Filesystem path.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QString backupPath(const QString &path);
+};
+
+#endif // ATOMICFILE_H
@@ -0,0 +1,86 @@
+/**
+ * @file binaryformat.h
+ * @brief Declarations for binaryformat.
+ * @details Defines helpers shared by the binary storage backends.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Changing the encoding requires a format version bump in every backend.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef BINARYFORMAT_H
+#define BINARYFORMAT_H
+
+#include <QDataStream>
+#include <QDateTime>
+#include <limits>
+
+namespace BinaryFormat {
+
+constexpr QDataStream::Version kStreamVersion = QDataStream::Qt_6_0; /**< Fixed stream encoding for all files. */
+constexpr qint64 kInvalidTimestamp = std::numeric_limits<qint64>::min(); /**< Marker for an invalid QDateTime. */
+
+/**
+ * @brief Write header.
+ * @details Writes the file magic and format version.
+ * @param out Output stream.
+ * @param magic File type marker.
+ * @param version Format version.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline void writeHeader(QDataStream &out, quint32 magic, quint16 version)
+{
+    out.setVersion(kStreamVersion);
+    out << magic << version;
+}
+
+/**
+ * @brief Read header.
+ * @details Checks the file magic and accepts versions up to maxVersion.
+ * @param in Input stream.
+ * @param magic Expected file type marker.
+ * @param maxVersion Newest version this build understands.
+ * @param version Output format version.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline bool readHeader(QDataStream &in, quint32 magic, quint16 maxVersion, quint16 &version)
+{
+    in.setVersion(kStreamVersion);
+    quint32 fileMagic = 0;
+    in >> fileMagic >> version;
+    return in.status() == QDataStream::Ok && fileMagic == magic && version >= 1 && version <= maxVersion;
+}
+
+/**
+ * @brief Write timestamp.
+ * @details Stores a QDateTime as milliseconds since the epoch.
+ * @param out Output stream.
+ * @param value Timestamp to write.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline void writeTimestamp(QDataStream &out, const QDateTime &value)
+{
+    out << (value.isValid() ? value.toMSecsSinceEpoch() : kInvalidTimestamp);
+}
+
+/**
+ * @brief Read timestamp.
+ * @details Reads milliseconds since the epoch written by writeTimestamp().
+ * @param in Input stream.
+ * @return Local-time QDateTime, or an invalid one for the marker.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+inline QDateTime readTimestamp(QDataStream &in)
+{
+    qint64 ms = kInvalidTimestamp;
+    in >> ms;
+    return ms == kInvalidTimestamp ? QDateTime() : QDateTime::fromMSecsSinceEpoch(ms);
+}
+
+} // namespace BinaryFormat
+
+#endif // BINARYFORMAT_H
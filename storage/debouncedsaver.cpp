@@ -0,0 +1,64 @@
+/**
+ * @file debouncedsaver.cpp
+ * @brief Definitions for debouncedsaver.
+ * @details Implements logic declared in the corresponding header for debouncedsaver.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "debouncedsaver.h"
+#include "asyncstorage.h"
+#include <utility>
+
+DebouncedSaver::DebouncedSaver(SaveFunction save, QObject *parent)
+    : QObject(parent)
+    , save(std::move(save))
+{
+    timer.setSingleShot(true);
+    timer.setInterval(kDefaultDelayMs);
+    connect(&timer, &QTimer::timeout, this, &DebouncedSaver::write);
+}
+
+void DebouncedSaver::setDelay(int ms)
+{
+    timer.setInterval(qMax(0, ms));
+    if (dirty)
+        timer.start();
+}
+
+int DebouncedSaver::delay() const
+{
+    return timer.interval();
+}
+
+bool DebouncedSaver::isPending() const
+{
+    return dirty;
+}
+
+void DebouncedSaver::markDirty()
+{
+    dirty = true;
+    timer.start();
+}
+
+bool DebouncedSaver::flush()
+{
+    // Callers flush before exiting or to answer a request, so wait for the write itself.
+    SyncSaveScope wait;
+    return write();
+}
+
+bool DebouncedSaver::write()
+{
+    timer.stop();
+    if (!dirty)
+        return true;
+
+    dirty = false;
+    const bool ok = save ? save() : false;
+    emit flushed(ok);
+    return ok;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file debouncedsaver.h
+ * @brief Declarations for debouncedsaver.
+ * @details Defines types and functions related to debouncedsaver.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef DEBOUNCEDSAVER_H
+#define DEBOUNCEDSAVER_H
+
+#include <QObject>
+#include <QTimer>
+#include <functional>
+
+/**
+ * @brief DebouncedSaver write-behind persistence helper.
+ * @details Collects markDirty() calls and runs the save function once after a quiet period.
+ * @note Public API is documented per member.
+ * @warning The save function must outlive pending writes; call flush() before its target is destroyed.
+ * @sa SmartClock
+ */
+class DebouncedSaver : public QObject
+{
+    Q_OBJECT
+public:
+    using SaveFunction = std::function<bool()>; /**< Callback that persists the model. */
+
+    static constexpr int kDefaultDelayMs = 500; /**< Default quiet period in milliseconds. */
+
+/**
+ * @brief Create DebouncedSaver instance.
+ * @details Initializes instance state.
+ * @param save Callback that writes the model to storage.
+ * @param parent Parent QObject.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit DebouncedSaver(SaveFunction save, QObject *parent = nullptr);
+
+/**
+ * @brief Set delay.
+ * @details Changes the quiet period; a pending write is re-armed with the new value.
+ * @param ms Quiet period in milliseconds.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setDelay(int ms);
+/**
+ * @brief Delay.
+ * @details Returns the quiet period in milliseconds.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int delay() const;
+/**
+ * @brief Is pending.
+ * @details Returns whether unsaved changes are waiting for the quiet period to pass.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isPending() const;
+
+public slots:
+/**
+ * @brief Mark dirty.
+ * @details Records a change and restarts the quiet period.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void markDirty();
+/**
+ * @brief Flush.
+ * @details Writes pending changes immediately and waits for asynchronous storages to finish the write (see SyncSaveScope); does nothing when clean.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool flush();
+
+signals:
+/**
+ * @brief Flushed.
+ * @details Emitted after each write.
+ * @param ok True when the save function succeeded. For a debounced write to an asynchronous storage, this reports the previous background write.
+ * @sa SmartClock
+ */
+    void flushed(bool ok);
+
+private slots:
+/**
+ * @brief Write.
+ * @details Runs the save function for pending changes without waiting for asynchronous storages; the quiet-period timer calls it.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool write();
+
+private:
+    SaveFunction save; /**< Callback that persists the model. */
+    QTimer timer; /**< Single-shot quiet-period timer. */
+    bool dirty = false; /**< True while changes are unsaved. */
+};
+
+#endif // DEBOUNCEDSAVER_H
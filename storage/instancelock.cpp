@@ -0,0 +1,40 @@
+/**
+ * @file instancelock.cpp
+ * @brief Definitions for instancelock.
+ * @details Implements logic declared in the corresponding header for instancelock.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "instancelock.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+InstanceLock::InstanceLock(const QString &path)
+    : lockPath(path.isEmpty() ? defaultPath() : path)
+    , file(lockPath)
+{
+    // The lock is held for the whole run, so it must never expire by age;
+    // QLockFile still takes over a lock whose owner process has died.
+    file.setStaleLockTime(0);
+}
+
+bool InstanceLock::tryLock()
+{
+    QDir().mkpath(QFileInfo(lockPath).absolutePath());
+    return file.tryLock(0);
+}
+
+QString InstanceLock::path() const
+{
+    return lockPath;
+}
+
+QString InstanceLock::defaultPath()
+{
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return base + "/smartclock.lock";
+}
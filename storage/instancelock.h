@@ -0,0 +1,64 @@
+/**
+ * @file instancelock.h
+ * @brief Declarations for instancelock.
+ * @details Defines types and functions related to instancelock.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef INSTANCELOCK_H
+#define INSTANCELOCK_H
+
+#include <QLockFile>
+#include <QString>
+
+/**
+ * @brief InstanceLock keeps the GUI and smartclockd off the same data files.
+ * @details Both processes load and save the same AppData files, and each one's debounced save would overwrite the other's changes, so whichever starts first holds this lock until it exits.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+class InstanceLock
+{
+public:
+/**
+ * @brief Construct an InstanceLock.
+ * @details Does not take the lock; call tryLock().
+ * @param path Lock file path; empty selects the file in AppDataLocation.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit InstanceLock(const QString &path = QString());
+/**
+ * @brief Try to take the lock.
+ * @details Creates the parent directory if needed. A lock left behind by a process that no longer runs is taken over.
+ * @return True when this process now holds the lock; false while another process holds it.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool tryLock();
+/**
+ * @brief Lock file path.
+ * @details Returns the file this lock guards.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString path() const;
+/**
+ * @brief Default lock file path.
+ * @details Returns smartclock.lock in AppDataLocation, next to the timer and alarm files.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QString defaultPath();
+
+private:
+    QString lockPath; /**< Lock file path. */
+    QLockFile file; /**< Held for the lifetime of this object once locked. */
+};
+
+#endif // INSTANCELOCK_H
@@ -0,0 +1,49 @@
+/**
+ * @file storageworker.cpp
+ * @brief Definitions for storageworker.
+ * @details Implements logic declared in the corresponding header for storageworker.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "storageworker.h"
+
+StorageWorker::StorageWorker()
+{
+    thread.setObjectName("SmartClockStorage");
+}
+
+StorageWorker::~StorageWorker()
+{
+    if (!receiver)
+        return;
+    drain();
+    thread.quit();
+    thread.wait();
+    delete receiver;
+}
+
+StorageWorker &StorageWorker::shared()
+{
+    static StorageWorker instance;
+    return instance;
+}
+
+void StorageWorker::drain()
+{
+    if (!receiver)
+        return;
+    submit([]() {}).waitForFinished();
+}
+
+QObject *StorageWorker::context()
+{
+    if (!receiver) {
+        receiver = new QObject;
+        receiver->moveToThread(&thread);
+        thread.start();
+    }
+    return receiver;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file storageworker.h
+ * @brief Declarations for storageworker.
+ * @details Defines types and functions related to storageworker.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef STORAGEWORKER_H
+#define STORAGEWORKER_H
+
+#include <QFuture>
+#include <QMetaObject>
+#include <QObject>
+#include <QPromise>
+#include <QThread>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief StorageWorker dedicated thread for storage I/O.
+ * @details Runs submitted jobs one at a time, in submission order, on a thread owned by the worker.
+ * Storage backends normally share the one returned by shared(), so the application runs a single storage thread.
+ * @note Public API is documented per member.
+ * @warning Submit jobs from a single thread; the destructor waits for queued jobs to finish.
+ * @sa SmartClock
+ */
+class StorageWorker
+{
+public:
+/**
+ * @brief Create StorageWorker instance.
+ * @details The thread is started lazily on the first submitted job.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    StorageWorker();
+/**
+ * @brief Destroy StorageWorker instance.
+ * @details Finishes queued jobs and stops the thread.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ~StorageWorker();
+
+    StorageWorker(const StorageWorker &) = delete;
+    StorageWorker &operator=(const StorageWorker &) = delete;
+
+/**
+ * @brief Shared worker.
+ * @details Returns the process-wide worker used by every AsyncStorage and the timer history journal.
+ * Writes are serialized anyway, so one thread serves them all.
+ * @return Reference to the shared worker; it stops after main() returns.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static StorageWorker &shared();
+
+/**
+ * @brief Submit a job.
+ * @details Queues fn on the worker thread and returns a future for its result.
+ * @param fn Callable to run; must be copyable.
+ * @return Future that finishes when fn has run.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    template <typename Fn>
+    QFuture<std::invoke_result_t<Fn>> submit(Fn fn)
+    {
+        using Result = std::invoke_result_t<Fn>;
+        auto promise = std::make_shared<QPromise<Result>>();
+        QFuture<Result> future = promise->future();
+        promise->start();
+        QMetaObject::invokeMethod(context(), [promise, fn]() mutable {
+            if constexpr (std::is_void_v<Result>) {
+                fn();
+            } else {
+                promise->addResult(fn());
+            }
+            promise->finish();
+        }, Qt::QueuedConnection);
+        return future;
+    }
+
+/**
+ * @brief Drain.
+ * @details Blocks until every job submitted so far has finished.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void drain();
+
+private:
+/**
+ * @brief Context.
+ * @details Returns the object living on the worker thread, starting the thread if needed.
+ * @return Pointer to the result object.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QObject *context();
+
+    QThread thread; /**< Thread running the jobs. */
+    QObject *receiver = nullptr; /**< Job target with worker-thread affinity. */
+};
+
+#endif // STORAGEWORKER_H
@@ -10,11 +10,15 @@
 
 #include <gtest/gtest.h>
 #include <QSignalSpy>
+#include <QTest>
 #include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
 #include "../alarm/alarmwindow.h"
 #include "../timer/timerwindow.h"
 #include "../clock/clockwindow.h"
 #include "../stopwatch/stopwatchwindow.h"
+#include "../storage/debouncedsaver.h"
 
 TEST(AlarmControllerTest, AddToggleRemoveAndSnoozeViaViewSignals) {
     AlarmWindow w;
@@ -45,6 +49,34 @@ TEST(AlarmControllerTest, AddToggleRemoveAndSnoozeViaViewSignals) {
     EXPECT_EQ(manager->getAlarms().size(), 0);
 }
 
+TEST(AlarmControllerTest, ImportAndExportCalendarViaViewSignals) {
+    AlarmWindow w;
+    AlarmManager *manager = w.findChild<AlarmManager*>();
+    ASSERT_TRUE(manager);
+    const int before = manager->alarmCount();
+
+    QTemporaryDir dir;
+    const QString in = dir.path() + "/in.ics";
+    QFile f(in);
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    f.write("BEGIN:VCALENDAR\r\nBEGIN:VEVENT\r\nSUMMARY:Imported\r\nDTSTART:20260105T070000\r\n"
+            "RRULE:FREQ=DAILY\r\nEND:VEVENT\r\nEND:VCALENDAR\r\n");
+    f.close();
+
+    emit w.importRequested(in);
+    ASSERT_EQ(manager->alarmCount(), before + 1);
+    EXPECT_GE(manager->findByName("Imported"), 0);
+
+    const QString out = dir.path() + "/out.ics";
+    emit w.exportRequested(out);
+    QFile exported(out);
+    ASSERT_TRUE(exported.open(QIODevice::ReadOnly));
+    EXPECT_TRUE(exported.readAll().contains("SUMMARY:Imported"));
+
+    emit w.removeAlarmsRequested(QList<int>{manager->alarmCount() - 1});
+    EXPECT_EQ(manager->alarmCount(), before);
+}
+
 TEST(TimerControllerTest, AddEditStartPauseAndDeleteViaViewSignals) {
     TimerWindow w;
     TimerManager *manager = w.getManager();
@@ -67,6 +99,31 @@ TEST(TimerControllerTest, AddEditStartPauseAndDeleteViaViewSignals) {
     EXPECT_EQ(manager->getTimers().size(), 0);
 }
 
+TEST(TimerControllerTest, BulkDeleteCausesSingleWrite) {
+    TimerWindow w;
+    TimerManager *manager = w.getManager();
+    DebouncedSaver *saver = w.findChild<DebouncedSaver*>();
+    ASSERT_TRUE(manager);
+    ASSERT_TRUE(saver);
+    saver->setDelay(20);
+
+    for (int i = 0; i < 50; ++i)
+        emit w.addTimerRequested(QString("T%1").arg(i), 30, "Normal", "Default");
+    saver->flush();
+
+    QSignalSpy spy(saver, &DebouncedSaver::flushed);
+    QList<int> rows;
+    for (int i = 0; i < manager->getTimers().size(); ++i)
+        rows.append(i);
+    emit w.deleteTimersRequested(rows);
+    EXPECT_EQ(manager->getTimers().size(), 0);
+    EXPECT_TRUE(saver->isPending());
+
+    ASSERT_TRUE(spy.wait(1000));
+    QTest::qWait(100);
+    EXPECT_EQ(spy.count(), 1);
+}
+
 TEST(ClockControllerTest, AddRemoveAndToggleFormatViaViewSignals) {
     ClockWindow w;
     ClockModel *model = w.findChild<ClockModel*>();
@@ -17,8 +17,15 @@
 #include <QJsonArray>
 #include <QSignalSpy>
 #include <QMetaObject>
+#include <QElapsedTimer>
+#include <QTimeZone>
 #include "../alarm/alarmmanager.h"
 #include "../alarm/jsonalarmstorage.h"
+#include "../alarm/binaryalarmstorage.h"
+#include "../alarm/recurrencerule.h"
+#include "../alarm/icsalarmstorage.h"
+#include <QBuffer>
+#include <QFileInfo>
 
 static AlarmData makeAlarm(const QString& name,
                            const QTime& t,
@@ -53,6 +60,88 @@ TEST(AlarmManagerLogicTest, AddRemoveToggleBasics) {
     EXPECT_NE(before, after);
 }
 
+TEST(AlarmManagerLogicTest, ZeroCopyAccessorsAndQueries) {
+    AlarmManager m;
+    m.addAlarm(makeAlarm("A", QTime(6,0)));
+    m.addAlarm(makeAlarm("B", QTime(7,0), RepeatMode::Never, {}, false));
+
+    const QList<AlarmData> &list = m.alarmList();
+    EXPECT_EQ(&list, &m.alarmList());
+    EXPECT_EQ(m.alarmCount(), 2);
+    EXPECT_EQ(&m.alarmAt(1), &list[1]);
+    EXPECT_EQ(m.countEnabled(), 1);
+    EXPECT_EQ(m.findByName("B"), 1);
+    EXPECT_EQ(m.findByName("C"), -1);
+}
+
+TEST(AlarmManagerLogicTest, IdsSurviveRestartInBothFormats) {
+    QTemporaryDir dir;
+    for (const QString &format : { QString("json"), QString("bin") }) {
+        const QString path = dir.path() + "/alarms." + format;
+        auto storage = [&]() -> std::unique_ptr<IAlarmStorage> {
+            if (format == "json")
+                return std::make_unique<JsonAlarmStorage>(path);
+            return std::make_unique<BinaryAlarmStorage>(path);
+        };
+
+        quint64 idB = 0;
+        quint64 idC = 0;
+        {
+            AlarmManager m(nullptr, storage());
+            m.addAlarm(makeAlarm("A", QTime(6,0)));
+            m.addAlarm(makeAlarm("B", QTime(7,0)));
+            m.addAlarm(makeAlarm("C", QTime(8,0)));
+            idB = m.alarmAt(1).id;
+            idC = m.alarmAt(2).id;
+            EXPECT_TRUE(m.removeAlarmById(m.alarmAt(0).id));
+            ASSERT_TRUE(m.save());
+        }
+        {
+            AlarmManager m(nullptr, storage());
+            ASSERT_TRUE(m.load());
+            ASSERT_EQ(m.alarmCount(), 2);
+            EXPECT_EQ(m.alarmAt(0).id, idB) << format.toStdString();
+            EXPECT_EQ(m.alarmAt(1).id, idC) << format.toStdString();
+
+            EXPECT_TRUE(m.removeAlarmById(idB));
+            m.addAlarm(makeAlarm("D", QTime(9,0)));
+            EXPECT_GT(m.alarmAt(1).id, idC);
+            ASSERT_TRUE(m.save());
+        }
+        AlarmManager m(nullptr, storage());
+        ASSERT_TRUE(m.load());
+        EXPECT_EQ(m.indexOfId(idC), 0);
+        EXPECT_EQ(m.indexOfId(idB), -1);
+    }
+}
+
+TEST(AlarmManagerLogicTest, IdLookupsFollowShiftedSlots) {
+    AlarmManager m;
+    m.addAlarm(makeAlarm("A", QTime(6,0)));
+    m.addAlarm(makeAlarm("B", QTime(7,0)));
+    m.addAlarm(makeAlarm("B", QTime(7,0)));
+    const quint64 idFirstB = m.alarmAt(1).id;
+    const quint64 idSecondB = m.alarmAt(2).id;
+    ASSERT_NE(idFirstB, idSecondB);
+
+    EXPECT_TRUE(m.removeAlarmById(m.alarmAt(0).id));
+    EXPECT_EQ(m.indexOfId(idSecondB), 1);
+    EXPECT_EQ(m.findByName("B"), 0);
+
+    const QDateTime firstTrigger = m.alarmAt(0).nextTrigger;
+    const AlarmData snoozed = m.alarmAt(1);
+    m.snoozeAlarm(snoozed, 5);
+    EXPECT_EQ(m.alarmAt(0).nextTrigger, firstTrigger);
+    EXPECT_GT(m.alarmAt(1).nextTrigger, QDateTime::currentDateTime().addSecs(4 * 60));
+    EXPECT_LE(m.alarmAt(1).nextTrigger, QDateTime::currentDateTime().addSecs(5 * 60));
+
+    EXPECT_TRUE(m.toggleAlarmById(idSecondB));
+    EXPECT_FALSE(m.alarmAt(1).enabled);
+    EXPECT_TRUE(m.alarmAt(0).enabled);
+    EXPECT_FALSE(m.toggleAlarmById(123456));
+    EXPECT_FALSE(m.removeAlarmById(123456));
+}
+
 TEST(AlarmManagerLogicTest, ToggleAlarmInvalidIndexDoesNothing) {
     AlarmManager m;
     m.addAlarm(makeAlarm("A", QTime(6,0)));
@@ -273,6 +362,30 @@ TEST(AlarmManagerLogicTest, CheckAlarmsSkipsDisabled) {
     EXPECT_EQ(spy.count(), 0);
 }
 
+TEST(AlarmManagerLogicTest, WakeUpFiresAtEarliestDeadlineWithoutPolling) {
+    AlarmManager m;
+    AlarmData a = makeAlarm("Soon", QTime::currentTime(), RepeatMode::Never);
+    a.nextTrigger = QDateTime::currentDateTime().addMSecs(150);
+    m.addAlarm(a);
+
+    QSignalSpy spy(&m, &AlarmManager::alarmTriggered);
+    EXPECT_TRUE(spy.wait(2000));
+    EXPECT_EQ(spy.count(), 1);
+    EXPECT_FALSE(m.getAlarms().first().enabled);
+}
+
+TEST(AlarmManagerLogicTest, DisabledAlarmDoesNotWakeUp) {
+    AlarmManager m;
+    AlarmData a = makeAlarm("Off", QTime::currentTime(), RepeatMode::Never);
+    a.nextTrigger = QDateTime::currentDateTime().addMSecs(150);
+    m.addAlarm(a);
+    m.toggleAlarm(0);
+
+    QSignalSpy spy(&m, &AlarmManager::alarmTriggered);
+    EXPECT_FALSE(spy.wait(400));
+    EXPECT_EQ(spy.count(), 0);
+}
+
 TEST(AlarmRepeatModeTest, FromStringParsesCommonValues) {
     EXPECT_EQ(repeatModeFromString("Never"), RepeatMode::Never);
     EXPECT_EQ(repeatModeFromString("once"), RepeatMode::Once);
@@ -366,4 +479,587 @@ TEST(JsonAlarmStorageTest, SaveAndLoadValidData) {
 TEST(AlarmRepeatModeTest, OnceConversions) {
     EXPECT_EQ(repeatModeFromString("Once"), RepeatMode::Once);
     EXPECT_EQ(repeatModeToString(RepeatMode::Once), "Once");
-}
\ No newline at end of file
+}
+
+TEST(AlarmRepeatModeTest, WeekdayMaskConversions) {
+    EXPECT_EQ(weekdayMaskFromDays({"Mon", "Wed", "Sun", "Bogus"}), quint8(0x45));
+    EXPECT_EQ(daysFromWeekdayMask(0x45), QStringList({"Mon", "Wed", "Sun"}));
+    EXPECT_EQ(weekdayMaskFor(RepeatMode::EveryDay, {}), kEveryDayMask);
+    EXPECT_EQ(weekdayMaskFor(RepeatMode::Weekdays, {"Sun"}), kWeekdaysMask);
+    EXPECT_EQ(weekdayMaskFor(RepeatMode::Weekends, {}), kWeekendsMask);
+    EXPECT_EQ(weekdayMaskFor(RepeatMode::SpecificDays, {"Tue"}), quint8(0x02));
+    EXPECT_EQ(weekdayMaskFor(RepeatMode::Once, {"Tue"}), quint8(0));
+}
+TEST(BinaryAlarmStorageTest, RoundTripKeepsAllFields) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/alarms.bin";
+
+    AlarmData a = makeAlarm("Gym", QTime(6, 15, 30), RepeatMode::SpecificDays, {"Tue", "Thu"}, true, true, "beep.wav");
+    a.nextTrigger = QDateTime::fromMSecsSinceEpoch(1700000000456);
+    AlarmData b = makeAlarm("Off", QTime(), RepeatMode::Once, {}, false);
+
+    BinaryAlarmStorage storage(path);
+    ASSERT_TRUE(storage.save({a, b}));
+
+    QList<AlarmData> out;
+    ASSERT_TRUE(storage.load(out));
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[0].name, "Gym");
+    EXPECT_EQ(out[0].time, QTime(6, 15, 30));
+    EXPECT_EQ(out[0].repeatMode, RepeatMode::SpecificDays);
+    EXPECT_EQ(out[0].days, QStringList({"Tue", "Thu"}));
+    EXPECT_EQ(out[0].soundPath, "beep.wav");
+    EXPECT_TRUE(out[0].snooze);
+    EXPECT_EQ(out[0].nextTrigger.toMSecsSinceEpoch(), 1700000000456);
+    EXPECT_FALSE(out[1].time.isValid());
+    EXPECT_EQ(out[1].repeatMode, RepeatMode::Once);
+    EXPECT_FALSE(out[1].enabled);
+    EXPECT_FALSE(out[1].nextTrigger.isValid());
+}
+
+TEST(BinaryAlarmStorageTest, MigratesLegacyJsonOnFirstLoad) {
+    QTemporaryDir dir;
+    const QString jsonPath = dir.path() + "/alarms.json";
+    const QString binPath = dir.path() + "/alarms.bin";
+
+    JsonAlarmStorage json(jsonPath);
+    ASSERT_TRUE(json.save({makeAlarm("Legacy", QTime(7, 0), RepeatMode::EveryDay)}));
+
+    BinaryAlarmStorage storage(binPath, jsonPath);
+    QList<AlarmData> out;
+    ASSERT_TRUE(storage.load(out));
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].name, "Legacy");
+    EXPECT_EQ(out[0].repeatMode, RepeatMode::EveryDay);
+    EXPECT_TRUE(QFile::exists(binPath));
+}
+
+TEST(BinaryAlarmStorageTest, MissingFilesReturnFalse) {
+    QTemporaryDir dir;
+    BinaryAlarmStorage storage(dir.path() + "/alarms.bin");
+    QList<AlarmData> out;
+    EXPECT_FALSE(storage.load(out));
+}
+
+TEST(AlarmManagerLogicTest, WeekdayMaskDrivesNextTrigger) {
+    AlarmManager m;
+    for (int dow = 1; dow <= 7; ++dow) {
+        AlarmData a = makeAlarm(QString("D%1").arg(dow), QTime(0, 0, 1), RepeatMode::SpecificDays,
+                                {weekdayNames()[dow - 1]});
+        m.addAlarm(a);
+        const AlarmData &stored = m.alarmAt(m.alarmCount() - 1);
+        EXPECT_EQ(stored.weekdayMask, quint8(1u << (dow - 1)));
+        EXPECT_EQ(stored.nextTrigger.date().dayOfWeek(), dow);
+        EXPECT_GT(stored.nextTrigger, QDateTime::currentDateTime());
+        EXPECT_LE(stored.nextTrigger, QDateTime::currentDateTime().addDays(7));
+    }
+
+    AlarmData maskOnly = makeAlarm("MaskOnly", QTime(8, 0), RepeatMode::SpecificDays);
+    maskOnly.weekdayMask = 0x14;
+    m.addAlarm(maskOnly);
+    const AlarmData &stored = m.alarmAt(m.alarmCount() - 1);
+    EXPECT_EQ(stored.days, QStringList({"Wed", "Fri"}));
+    const int dow = stored.nextTrigger.date().dayOfWeek();
+    EXPECT_TRUE(dow == 3 || dow == 5);
+}
+
+TEST(BinaryAlarmStorageTest, RoundTripKeepsWeekdayMask) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/alarms.bin";
+
+    AlarmData a = makeAlarm("Mask", QTime(6, 0), RepeatMode::SpecificDays);
+    a.weekdayMask = 0x41;
+    BinaryAlarmStorage storage(path);
+    ASSERT_TRUE(storage.save({a}));
+    QList<AlarmData> out;
+    ASSERT_TRUE(storage.load(out));
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].weekdayMask, quint8(0x41));
+}
+
+TEST(BinaryAlarmStorageTest, MigratedAlarmsWithoutMaskGetOneFromTheirDays) {
+    QTemporaryDir dir;
+    const QString legacyPath = dir.path() + "/alarms.json";
+
+    // Alarms saved before the mask existed load with weekdayMask 0.
+    JsonAlarmStorage json(legacyPath);
+    ASSERT_TRUE(json.save({makeAlarm("Old", QTime(7, 0), RepeatMode::SpecificDays, {"Sat"})}));
+
+    AlarmManager m(nullptr, std::make_unique<BinaryAlarmStorage>(dir.path() + "/alarms.bin", legacyPath));
+    ASSERT_TRUE(m.load());
+    ASSERT_EQ(m.alarmCount(), 1);
+    EXPECT_EQ(m.alarmAt(0).days, QStringList({"Sat"}));
+    EXPECT_EQ(m.alarmAt(0).weekdayMask, quint8(0x20));
+}
+
+TEST(JsonAlarmStorageTest, RoundTripKeepsWeekdayMask) {
+    QTemporaryDir dir;
+    JsonAlarmStorage storage(dir.path() + "/alarms.json");
+    AlarmData a = makeAlarm("Json", QTime(6, 0), RepeatMode::SpecificDays, {"Mon", "Tue"});
+    a.weekdayMask = weekdayMaskFromDays(a.days);
+    ASSERT_TRUE(storage.save({a}));
+
+    QList<AlarmData> out;
+    ASSERT_TRUE(storage.load(out));
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].weekdayMask, quint8(0x03));
+    EXPECT_EQ(out[0].days, QStringList({"Mon", "Tue"}));
+}
+
+TEST(RecurrenceRuleTest, EveryOtherTuesday) {
+    const RecurrenceRule rule = RecurrenceRule::parse("DTSTART:20260106T070000\nRRULE:FREQ=WEEKLY;INTERVAL=2;BYDAY=TU");
+    ASSERT_TRUE(rule.isValid());
+
+    const QDateTime first(QDate(2026, 1, 6), QTime(7, 0));
+    EXPECT_EQ(rule.next(first.addSecs(-1)), first);
+    EXPECT_EQ(rule.next(first), QDateTime(QDate(2026, 1, 20), QTime(7, 0)));
+    EXPECT_EQ(rule.next(QDateTime(QDate(2026, 1, 14), QTime(12, 0))), QDateTime(QDate(2026, 1, 20), QTime(7, 0)));
+    EXPECT_EQ(rule.next(QDateTime(QDate(2026, 12, 30), QTime(0, 0))), QDateTime(QDate(2027, 1, 5), QTime(7, 0)));
+}
+
+TEST(RecurrenceRuleTest, SecondTuesdayOfTheMonth) {
+    const RecurrenceRule rule = RecurrenceRule::parse("DTSTART:20260101T090000\nRRULE:FREQ=MONTHLY;BYDAY=2TU");
+    ASSERT_TRUE(rule.isValid());
+
+    const QDateTime jan = rule.next(QDateTime(QDate(2026, 1, 1), QTime(0, 0)));
+    EXPECT_EQ(jan, QDateTime(QDate(2026, 1, 13), QTime(9, 0)));
+    EXPECT_EQ(rule.next(jan), QDateTime(QDate(2026, 2, 10), QTime(9, 0)));
+}
+
+TEST(RecurrenceRuleTest, LastWeekdayOfTheMonth) {
+    const RecurrenceRule rule = RecurrenceRule::parse(
+        "DTSTART:20260101T080000\nRRULE:FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1");
+    ASSERT_TRUE(rule.isValid());
+
+    const QList<QDateTime> got = rule.occurrences(QDateTime(QDate(2026, 1, 1), QTime(0, 0)),
+                                                  QDateTime(QDate(2026, 5, 31), QTime(23, 59)));
+    const QList<QDateTime> expected = {
+        QDateTime(QDate(2026, 1, 30), QTime(8, 0)),
+        QDateTime(QDate(2026, 2, 27), QTime(8, 0)),
+        QDateTime(QDate(2026, 3, 31), QTime(8, 0)),
+        QDateTime(QDate(2026, 4, 30), QTime(8, 0)),
+        QDateTime(QDate(2026, 5, 29), QTime(8, 0)),
+    };
+    EXPECT_EQ(got, expected);
+}
+
+TEST(RecurrenceRuleTest, EveryNinetyMinutesDuringTheDay) {
+    const RecurrenceRule rule = RecurrenceRule::parse(
+        "DTSTART:20260105T080000\nRRULE:FREQ=MINUTELY;INTERVAL=90;BYHOUR=8,9,10,11,12,13,14,15,16,17");
+    ASSERT_TRUE(rule.isValid());
+
+    const QDate day(2026, 1, 5);
+    const QList<QDateTime> got = rule.occurrences(QDateTime(day, QTime(0, 0)), QDateTime(day, QTime(23, 59)));
+    QList<QDateTime> expected;
+    for (const QTime &t : {QTime(8, 0), QTime(9, 30), QTime(11, 0), QTime(12, 30),
+                           QTime(14, 0), QTime(15, 30), QTime(17, 0)})
+        expected.append(QDateTime(day, t));
+    EXPECT_EQ(got, expected);
+    EXPECT_EQ(rule.next(QDateTime(day, QTime(17, 0))), QDateTime(day.addDays(1), QTime(8, 0)));
+}
+
+TEST(RecurrenceRuleTest, CountAndUntilEndTheRule) {
+    const RecurrenceRule counted = RecurrenceRule::parse("DTSTART:20260101T060000\nRRULE:FREQ=DAILY;COUNT=3");
+    ASSERT_TRUE(counted.isValid());
+    EXPECT_EQ(counted.next(QDateTime(QDate(2026, 1, 2), QTime(6, 0))), QDateTime(QDate(2026, 1, 3), QTime(6, 0)));
+    EXPECT_FALSE(counted.next(QDateTime(QDate(2026, 1, 3), QTime(6, 0))).isValid());
+
+    const RecurrenceRule until = RecurrenceRule::parse("DTSTART:20260101T060000\nRRULE:FREQ=DAILY;UNTIL=20260105");
+    ASSERT_TRUE(until.isValid());
+    EXPECT_EQ(until.occurrences(QDateTime(QDate(2026, 1, 1), QTime(0, 0)),
+                                QDateTime(QDate(2026, 2, 1), QTime(0, 0))).size(), 5);
+}
+
+TEST(RecurrenceRuleTest, CountResumesFromCursor) {
+    const RecurrenceRule rule = RecurrenceRule::parse("DTSTART:20260101T060000\nRRULE:FREQ=DAILY;COUNT=3");
+    ASSERT_TRUE(rule.isValid());
+    RecurrenceRule::Cursor cursor;
+    EXPECT_EQ(rule.next(QDateTime(QDate(2025, 12, 31), QTime(0, 0)), cursor), QDateTime(QDate(2026, 1, 1), QTime(6, 0)));
+    EXPECT_EQ(cursor.index, 1);
+    EXPECT_EQ(rule.next(QDateTime(QDate(2026, 1, 1), QTime(6, 0)), cursor), QDateTime(QDate(2026, 1, 2), QTime(6, 0)));
+    EXPECT_EQ(rule.next(QDateTime(QDate(2026, 1, 2), QTime(6, 0)), cursor), QDateTime(QDate(2026, 1, 3), QTime(6, 0)));
+    EXPECT_EQ(cursor.index, 3);
+    EXPECT_FALSE(rule.next(QDateTime(QDate(2026, 1, 3), QTime(6, 0)), cursor).isValid());
+
+    // A cursor past the reference instant is ignored rather than trusted.
+    EXPECT_EQ(rule.next(QDateTime(QDate(2025, 12, 31), QTime(0, 0)), cursor), QDateTime(QDate(2026, 1, 1), QTime(6, 0)));
+    EXPECT_EQ(cursor.index, 1);
+
+    // The cursor is what is trusted for the position: one that claims the
+    // last occurrence was taken ends the rule without recounting.
+    RecurrenceRule::Cursor spent{QDateTime(QDate(2026, 1, 1), QTime(6, 0)), 3};
+    EXPECT_FALSE(rule.next(QDateTime(QDate(2026, 1, 1), QTime(7, 0)), spent).isValid());
+}
+
+TEST(RecurrenceRuleTest, HourlyByMinuteExpandsWithinEachHour) {
+    const RecurrenceRule rule = RecurrenceRule::parse("DTSTART:20260105T090000\nRRULE:FREQ=HOURLY;BYMINUTE=30");
+    ASSERT_TRUE(rule.isValid());
+    const QDate day(2026, 1, 5);
+    EXPECT_EQ(rule.next(QDateTime(day, QTime(8, 0))), QDateTime(day, QTime(9, 30)));
+    EXPECT_EQ(rule.next(QDateTime(day, QTime(9, 30))), QDateTime(day, QTime(10, 30)));
+    EXPECT_EQ(rule.next(QDateTime(day, QTime(23, 45))), QDateTime(day.addDays(1), QTime(0, 30)));
+
+    const RecurrenceRule twice = RecurrenceRule::parse(
+        "DTSTART:20260105T090000\nRRULE:FREQ=HOURLY;INTERVAL=2;BYMINUTE=0,30;BYHOUR=9,10,11");
+    ASSERT_TRUE(twice.isValid());
+    const QList<QDateTime> expected = {QDateTime(day, QTime(9, 0)), QDateTime(day, QTime(9, 30)),
+                                       QDateTime(day, QTime(11, 0)), QDateTime(day, QTime(11, 30)),
+                                       QDateTime(day.addDays(1), QTime(9, 0))};
+    EXPECT_EQ(twice.occurrences(QDateTime(day, QTime(0, 0)), QDateTime(day.addDays(1), QTime(9, 10))), expected);
+}
+
+TEST(RecurrenceRuleTest, RejectsUnsupportedOrMalformedRules) {
+    QString error;
+    EXPECT_FALSE(RecurrenceRule::parse("FREQ=YEARLY", &error).isValid());
+    EXPECT_FALSE(error.isEmpty());
+    EXPECT_FALSE(RecurrenceRule::parse("BYDAY=MO").isValid());
+    EXPECT_FALSE(RecurrenceRule::parse("FREQ=WEEKLY;BYDAY=2TU").isValid());
+    EXPECT_FALSE(RecurrenceRule::parse("FREQ=DAILY;BYSECOND=5").isValid());
+    EXPECT_FALSE(RecurrenceRule::parse("FREQ=DAILY;BYHOUR=24").isValid());
+    EXPECT_FALSE(RecurrenceRule::parse("FREQ=DAILY;COUNT=2;UNTIL=20260105").isValid());
+
+    EXPECT_TRUE(RecurrenceRule::parse("RRULE:freq=daily;byday=mo,fr", &error).isValid());
+    EXPECT_TRUE(error.isEmpty());
+}
+
+TEST(RecurrenceRuleTest, ToStringRoundTrips) {
+    const RecurrenceRule rule = RecurrenceRule::parse(
+        "DTSTART:20260101T080000Z\nRRULE:FREQ=MONTHLY;INTERVAL=2;BYDAY=FR,-1MO;BYMONTHDAY=1,-1;BYHOUR=8,20;BYSETPOS=1,-1");
+    ASSERT_TRUE(rule.isValid());
+    EXPECT_EQ(rule.start().timeSpec(), Qt::UTC);
+
+    const RecurrenceRule again = RecurrenceRule::parse(rule.toString());
+    ASSERT_TRUE(again.isValid());
+    EXPECT_EQ(again.toString(), rule.toString());
+    EXPECT_EQ(rule.rruleText(), "FREQ=MONTHLY;INTERVAL=2;BYDAY=FR,-1MO;BYMONTHDAY=1,-1;BYHOUR=8,20;BYSETPOS=1,-1");
+}
+
+TEST(AlarmManagerLogicTest, RecurrenceRuleDrivesNextTrigger) {
+    AlarmManager m;
+    AlarmData a = makeAlarm("Payday", QTime(9, 0));
+    a.recurrence = "FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1";
+    a.nextTrigger = QDateTime::currentDateTime().addSecs(-1);
+    m.addAlarm(a);
+    EXPECT_TRUE(m.alarmAt(0).recurrence.startsWith("DTSTART:"));
+
+    QSignalSpy spy(&m, &AlarmManager::alarmTriggered);
+    EXPECT_TRUE(QMetaObject::invokeMethod(&m, "checkAlarms", Qt::DirectConnection));
+    EXPECT_EQ(spy.count(), 1);
+
+    const AlarmData &stored = m.alarmAt(0);
+    EXPECT_TRUE(stored.enabled);
+    ASSERT_TRUE(stored.nextTrigger.isValid());
+    EXPECT_GT(stored.nextTrigger, QDateTime::currentDateTime());
+    EXPECT_EQ(stored.nextTrigger.time(), QTime(9, 0));
+    const QDate d = stored.nextTrigger.date();
+    EXPECT_LE(d.dayOfWeek(), 5);
+    for (QDate later = d.addDays(1); later.month() == d.month(); later = later.addDays(1))
+        EXPECT_GT(later.dayOfWeek(), 5);
+}
+
+TEST(BinaryAlarmStorageTest, RoundTripKeepsRecurrence) {
+    QTemporaryDir dir;
+    BinaryAlarmStorage storage(dir.path() + "/alarms.bin");
+    AlarmData a = makeAlarm("Rule", QTime(7, 0));
+    a.recurrence = "DTSTART:20260106T070000\nRRULE:FREQ=WEEKLY;INTERVAL=2;BYDAY=TU;COUNT=5";
+    a.ruleCursor = {QDateTime(QDate(2026, 1, 20), QTime(7, 0)), 2};
+    a.uid = "gym@example.com";
+    ASSERT_TRUE(storage.save({a}));
+
+    QList<AlarmData> out;
+    ASSERT_TRUE(storage.load(out));
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].recurrence, a.recurrence);
+    EXPECT_EQ(out[0].ruleCursor.occurrence, a.ruleCursor.occurrence);
+    EXPECT_EQ(out[0].ruleCursor.index, 2);
+    EXPECT_EQ(out[0].uid, a.uid);
+
+    JsonAlarmStorage json(dir.path() + "/alarms.json");
+    ASSERT_TRUE(json.save({a}));
+    ASSERT_TRUE(json.load(out));
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].recurrence, a.recurrence);
+    EXPECT_EQ(out[0].ruleCursor.occurrence, a.ruleCursor.occurrence);
+    EXPECT_EQ(out[0].ruleCursor.index, 2);
+    EXPECT_EQ(out[0].uid, a.uid);
+}
+
+TEST(RecurrenceRuleTest, Expands10000RulesOverAYear) {
+    const QStringList patterns = {
+        "FREQ=WEEKLY;INTERVAL=2;BYDAY=TU",
+        "FREQ=MONTHLY;BYDAY=2TU",
+        "FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1",
+        "FREQ=MINUTELY;INTERVAL=90;BYHOUR=8,9,10,11,12,13,14,15,16,17",
+        "FREQ=DAILY;BYDAY=MO,TU,WE,TH,FR",
+    };
+    constexpr int kRules = 10000;
+    // UTC keeps the figure about the engine rather than time zone lookups.
+    const QDateTime from(QDate(2026, 1, 1), QTime(0, 0), Qt::UTC);
+    const QDateTime to(QDate(2026, 12, 31), QTime(23, 59, 59), Qt::UTC);
+
+    QElapsedTimer clock;
+    clock.start();
+    QList<RecurrenceRule> rules;
+    rules.reserve(kRules);
+    for (int i = 0; i < kRules; ++i) {
+        RecurrenceRule rule = RecurrenceRule::parse(patterns[i % patterns.size()]);
+        rule.setStart(from.addDays(i % 28).addSecs(6 * 3600 + (i % 60) * 60));
+        rules.append(rule);
+    }
+    const qint64 parseNs = clock.nsecsElapsed();
+
+    clock.restart();
+    qint64 total = 0;
+    for (const RecurrenceRule &rule : rules)
+        total += rule.occurrences(from, to).size();
+    const qint64 expandNs = clock.nsecsElapsed();
+
+    for (int i = 0; i < 50; ++i) {
+        const QList<QDateTime> expanded = rules[i].occurrences(from, to);
+        ASSERT_FALSE(expanded.isEmpty());
+        for (int k = 1; k < expanded.size(); ++k)
+            ASSERT_EQ(rules[i].next(expanded[k - 1]), expanded[k]);
+    }
+
+    EXPECT_GT(total, kRules);
+    RecordProperty("parse_ms", int(parseNs / 1000000));
+    RecordProperty("expand_ms", int(expandNs / 1000000));
+}
+
+TEST(IcsAlarmStorageTest, ReadsEventsAlarmsAndRules) {
+    QByteArray ics =
+        "BEGIN:VCALENDAR\r\n"
+        "VERSION:2.0\r\n"
+        "BEGIN:VTIMEZONE\r\n"
+        "TZID:Europe/Berlin\r\n"
+        "BEGIN:STANDARD\r\n"
+        "DTSTART:19701025T030000\r\n"
+        "END:STANDARD\r\n"
+        "END:VTIMEZONE\r\n"
+        "BEGIN:VEVENT\r\n"
+        "UID:standup@example.com\r\n"
+        "SUMMARY:Stand\\, up\r\n"
+        " \\; sync\r\n"
+        "DTSTART;TZID=Europe/Berlin:20260105T083000\r\n"
+        "RRULE:FREQ=WEEKLY;BYDAY=MO,TU,WE,TH,FR\r\n"
+        "BEGIN:VALARM\r\n"
+        "ACTION:AUDIO\r\n"
+        "TRIGGER:-PT15M\r\n"
+        "END:VALARM\r\n"
+        "BEGIN:VALARM\r\n"
+        "TRIGGER:-PT1H\r\n"
+        "END:VALARM\r\n"
+        "END:VEVENT\r\n"
+        "BEGIN:VEVENT\r\n"
+        "SUMMARY:Review\r\n"
+        "DTSTART:20260113T090000\r\n"
+        "RRULE:FREQ=MONTHLY;BYDAY=2TU\r\n"
+        "END:VEVENT\r\n"
+        "BEGIN:VEVENT\r\n"
+        "SUMMARY:Launch\r\n"
+        "DTSTART:20990101T120000\r\n"
+        "END:VEVENT\r\n"
+        "BEGIN:VEVENT\r\n"
+        "SUMMARY:Cancelled\r\n"
+        "STATUS:CANCELLED\r\n"
+        "DTSTART:20260105T083000\r\n"
+        "END:VEVENT\r\n"
+        "BEGIN:VEVENT\r\n"
+        "SUMMARY:Birthday\r\n"
+        "DTSTART:20260105T083000\r\n"
+        "RRULE:FREQ=YEARLY\r\n"
+        "END:VEVENT\r\n"
+        "END:VCALENDAR\r\n";
+    QBuffer buffer(&ics);
+    ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+
+    QList<AlarmData> out;
+    int skipped = 0;
+    ASSERT_TRUE(IcsAlarmStorage::read(buffer, [&out](const AlarmData &a) { out.append(a); }, &skipped));
+    EXPECT_EQ(skipped, 2);
+    ASSERT_EQ(out.size(), 3);
+
+    EXPECT_EQ(out[0].name, "Stand, up; sync");
+    EXPECT_EQ(out[0].uid, "standup@example.com");
+    const QDateTime berlin(QDate(2026, 1, 5), QTime(8, 15), QTimeZone("Europe/Berlin"));
+    EXPECT_EQ(out[0].time, berlin.toLocalTime().time());
+    EXPECT_EQ(out[0].repeatMode, RepeatMode::Weekdays);
+    EXPECT_TRUE(out[0].recurrence.isEmpty());
+
+    EXPECT_EQ(out[1].name, "Review");
+    EXPECT_TRUE(out[1].recurrence.contains("BYDAY=2TU"));
+
+    EXPECT_EQ(out[2].repeatMode, RepeatMode::Once);
+    EXPECT_EQ(out[2].nextTrigger, QDateTime(QDate(2099, 1, 1), QTime(12, 0)));
+    EXPECT_TRUE(out[2].enabled);
+}
+
+TEST(IcsAlarmStorageTest, TzidTimesAreConvertedToLocal) {
+    QByteArray ics =
+        "BEGIN:VCALENDAR\r\n"
+        "BEGIN:VEVENT\r\n"
+        "SUMMARY:New York\r\n"
+        "DTSTART;VALUE=DATE-TIME;TZID=\"America/New_York\":20990601T090000\r\n"
+        "END:VEVENT\r\n"
+        "BEGIN:VEVENT\r\n"
+        "SUMMARY:Nowhere\r\n"
+        "DTSTART;TZID=Nowhere/Special:20990601T090000\r\n"
+        "END:VEVENT\r\n"
+        "BEGIN:VEVENT\r\n"
+        "SUMMARY:Utc\r\n"
+        "DTSTART;TZID=Asia/Tokyo:20990601T090000Z\r\n"
+        "END:VEVENT\r\n"
+        "BEGIN:VEVENT\r\n"
+        "SUMMARY:Moved\r\n"
+        "RECURRENCE-ID:20990602T090000\r\n"
+        "DTSTART:20990602T100000\r\n"
+        "END:VEVENT\r\n"
+        "END:VCALENDAR\r\n";
+    QBuffer buffer(&ics);
+    ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+
+    QList<AlarmData> out;
+    int skipped = 0;
+    ASSERT_TRUE(IcsAlarmStorage::read(buffer, [&out](const AlarmData &a) { out.append(a); }, &skipped));
+    EXPECT_EQ(skipped, 1);
+    ASSERT_EQ(out.size(), 3);
+
+    const QDateTime newYork(QDate(2099, 6, 1), QTime(9, 0), QTimeZone("America/New_York"));
+    EXPECT_EQ(out[0].nextTrigger, newYork);
+    EXPECT_EQ(out[0].time, newYork.toLocalTime().time());
+    // Unknown zones fall back to floating time.
+    EXPECT_EQ(out[1].nextTrigger, QDateTime(QDate(2099, 6, 1), QTime(9, 0)));
+    // A UTC value keeps its own zone whatever TZID says.
+    EXPECT_EQ(out[2].nextTrigger, QDateTime(QDate(2099, 6, 1), QTime(9, 0), Qt::UTC));
+}
+
+TEST(IcsAlarmStorageTest, SaveAndLoadRoundTrip) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/alarms.ics";
+
+    AlarmData weekly = makeAlarm("Gym", QTime(6, 30), RepeatMode::SpecificDays, {"Mon", "Thu"}, true, true,
+                                 "/tmp/bell.wav");
+    weekly.weekdayMask = weekdayMaskFromDays(weekly.days);
+    AlarmData custom = makeAlarm(QString(90, QChar(0x00E9)) + ";,\\ long", QTime(8, 0), RepeatMode::Never, {}, false);
+    custom.recurrence = "DTSTART:20260101T080000\nRRULE:FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1";
+    custom.rule = RecurrenceRule::parse(custom.recurrence);
+
+    IcsAlarmStorage storage(path);
+    ASSERT_TRUE(storage.save({weekly, custom}));
+
+    QFile f(path);
+    ASSERT_TRUE(f.open(QIODevice::ReadOnly));
+    while (!f.atEnd())
+        EXPECT_LE(f.readLine().size(), 77);
+    f.close();
+
+    QList<AlarmData> out;
+    ASSERT_TRUE(storage.load(out));
+    EXPECT_EQ(storage.skippedEvents(), 0);
+    ASSERT_EQ(out.size(), 2);
+
+    EXPECT_EQ(out[0].name, "Gym");
+    EXPECT_EQ(out[0].time, QTime(6, 30));
+    EXPECT_EQ(out[0].repeatMode, RepeatMode::SpecificDays);
+    EXPECT_EQ(out[0].days, QStringList({"Mon", "Thu"}));
+    EXPECT_EQ(out[0].soundPath, "/tmp/bell.wav");
+    EXPECT_TRUE(out[0].snooze);
+    EXPECT_TRUE(out[0].enabled);
+
+    EXPECT_EQ(out[1].name, custom.name);
+    EXPECT_EQ(out[1].recurrence, custom.recurrence);
+    EXPECT_FALSE(out[1].enabled);
+}
+
+TEST(IcsAlarmStorageTest, LoadRejectsNonCalendarFiles) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/notes.txt";
+    QFile f(path);
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    f.write("just some text\n");
+    f.close();
+
+    QList<AlarmData> out;
+    EXPECT_FALSE(IcsAlarmStorage(path).load(out));
+    EXPECT_FALSE(IcsAlarmStorage(dir.path() + "/missing.ics").load(out));
+}
+
+TEST(AlarmManagerLogicTest, ImportFromIcsAddsAllEventsInOneUpdate) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/import.ics";
+    constexpr int kEvents = 20000;
+    {
+        QFile f(path);
+        ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+        f.write("BEGIN:VCALENDAR\r\nVERSION:2.0\r\n");
+        for (int i = 0; i < kEvents; ++i) {
+            f.write(QString("BEGIN:VEVENT\r\nUID:%1@example.com\r\nSUMMARY:Event %1 with a description\r\n"
+                            " that is folded onto a second line\r\nDTSTART:20260105T%2\r\n"
+                            "RRULE:FREQ=WEEKLY;INTERVAL=2;BYDAY=TU\r\nBEGIN:VALARM\r\nACTION:DISPLAY\r\n"
+                            "TRIGGER:-PT10M\r\nEND:VALARM\r\nEND:VEVENT\r\n")
+                        .arg(i).arg(QTime(8 + i % 10, i % 60).toString("HHmmss"))
+                        .toUtf8());
+        }
+        f.write("END:VCALENDAR\r\n");
+    }
+    const qint64 bytes = QFileInfo(path).size();
+
+    AlarmManager m;
+    QSignalSpy spy(&m, &AlarmManager::alarmsUpdated);
+    QElapsedTimer clock;
+    clock.start();
+    EXPECT_EQ(m.importFromIcs(path), kEvents);
+    const qint64 importMs = clock.elapsed();
+
+    EXPECT_EQ(spy.count(), 1);
+    ASSERT_EQ(m.alarmCount(), kEvents);
+    EXPECT_TRUE(m.alarmAt(0).rule.isValid());
+    EXPECT_TRUE(m.alarmAt(0).nextTrigger.isValid());
+    EXPECT_EQ(m.alarmAt(0).time, QTime(7, 50));
+    EXPECT_EQ(m.importFromIcs(dir.path() + "/missing.ics"), -1);
+
+    RecordProperty("import_ms", int(importMs));
+    RecordProperty("import_kib", int(bytes / 1024));
+}
+
+TEST(AlarmManagerLogicTest, ReimportUpdatesAlarmsByUid) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/import.ics";
+    auto writeCalendar = [&path](const QString &summary) {
+        QFile f(path);
+        ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+        f.write(QString("BEGIN:VCALENDAR\r\n"
+                        "BEGIN:VEVENT\r\nUID:gym@example.com\r\nSUMMARY:%1\r\nDTSTART:20260105T070000\r\n"
+                        "RRULE:FREQ=DAILY\r\nEND:VEVENT\r\n"
+                        "BEGIN:VEVENT\r\nSUMMARY:Broken\r\nDTSTART:20260105T070000\r\nRRULE:FREQ=YEARLY\r\n"
+                        "END:VEVENT\r\n"
+                        "END:VCALENDAR\r\n").arg(summary).toUtf8());
+    };
+
+    AlarmManager m(nullptr, std::make_unique<JsonAlarmStorage>(dir.path() + "/alarms.json"));
+    m.addAlarm(makeAlarm("Local", QTime(6, 0)));
+    writeCalendar("Gym");
+    int skipped = 0;
+    EXPECT_EQ(m.importFromIcs(path, &skipped), 1);
+    EXPECT_EQ(skipped, 1);
+    ASSERT_EQ(m.alarmCount(), 2);
+    const quint64 gymId = m.alarmAt(1).id;
+
+    writeCalendar("Gym, later");
+    EXPECT_EQ(m.importFromIcs(path), 1);
+    ASSERT_EQ(m.alarmCount(), 2);
+    EXPECT_EQ(m.alarmAt(1).id, gymId);
+    EXPECT_EQ(m.alarmAt(1).name, "Gym, later");
+    EXPECT_EQ(m.findByName("Gym, later"), 1);
+
+    // A file exported from here names local alarms by their stable id.
+    const QString exported = dir.path() + "/export.ics";
+    ASSERT_TRUE(m.exportToIcs(exported));
+    QFile f(exported);
+    ASSERT_TRUE(f.open(QIODevice::ReadOnly));
+    const QByteArray text = f.readAll();
+    EXPECT_TRUE(text.contains("UID:alarm-" + QByteArray::number(m.alarmAt(0).id) + "@smartclock\r\n"));
+    EXPECT_TRUE(text.contains("UID:gym@example.com\r\n"));
+    EXPECT_EQ(m.importFromIcs(exported), 2);
+    EXPECT_EQ(m.alarmCount(), 2);
+}
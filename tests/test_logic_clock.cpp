@@ -14,6 +14,9 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QDateTime>
+#include <QLocale>
+#include <QTimeZone>
 #include "../clock/clockmodel.h"
 #include "../clock/jsonclockstorage.h"
 
@@ -171,3 +174,48 @@ TEST(JsonClockStorageTest, DeleteNonexistentFileDoesNotCrash) {
     ClockSnapshot out;
     EXPECT_FALSE(storage.load(out));
 }
+
+namespace {
+
+QString referenceTimeText(const QString &zone, qint64 nowMs, bool format12)
+{
+    QTimeZone tz(zone.toUtf8());
+    QDateTime nowTz = QDateTime::fromMSecsSinceEpoch(nowMs, QTimeZone::utc()).toTimeZone(tz);
+    QLocale en(QLocale::English);
+    QString fmt = format12 ? "hh:mm:ss AP" : "HH:mm:ss";
+    return QString("%1 - %2").arg(QString::fromUtf8(tz.id()), en.toString(nowTz.time(), fmt));
+}
+
+} // namespace
+
+TEST(ClockModelTest, CachedTimeTextMatchesDirectConversion) {
+    ClockModel model;
+    const QStringList zones{"UTC", "America/New_York", "Asia/Tokyo", "Asia/Kolkata", "Australia/Adelaide"};
+    const qint64 base = QDateTime(QDate(2024, 7, 1), QTime(23, 59, 58), QTimeZone::utc()).toMSecsSinceEpoch();
+
+    for (bool twelve : {false, true}) {
+        model.setFormat12h(twelve);
+        for (const QString &zone : zones) {
+            for (qint64 step = 0; step < 4; ++step) {
+                const qint64 now = base + step * 1000;
+                EXPECT_EQ(model.timeTextFor(ClockInfo{zone}, now), referenceTimeText(zone, now, twelve));
+            }
+        }
+    }
+}
+
+TEST(ClockModelTest, CachedOffsetFollowsDstTransition) {
+    ClockModel model;
+    const ClockInfo berlin{"Europe/Berlin"};
+    // Central European Summer Time starts at 01:00 UTC on 2024-03-31.
+    const qint64 switchMs = QDateTime(QDate(2024, 3, 31), QTime(1, 0), QTimeZone::utc()).toMSecsSinceEpoch();
+
+    EXPECT_TRUE(model.timeTextFor(berlin, switchMs - 1000).endsWith("01:59:59"));
+    EXPECT_TRUE(model.timeTextFor(berlin, switchMs).endsWith("03:00:00"));
+    EXPECT_TRUE(model.timeTextFor(berlin, switchMs - 1000).endsWith("01:59:59"));
+}
+
+TEST(ClockModelTest, UnknownZoneYieldsEmptyText) {
+    ClockModel model;
+    EXPECT_EQ(model.timeTextFor(ClockInfo{"Not/AZone"}, 0), referenceTimeText("Not/AZone", 0, false));
+}
@@ -0,0 +1,348 @@
+/**
+ * @file test_logic_daemon.cpp
+ * @brief Definitions for test_logic_daemon.
+ * @details Implements logic declared in the corresponding header for test_logic_daemon.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include <gtest/gtest.h>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QMetaObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QUuid>
+#include "../daemon/controlserver.h"
+#include "../daemon/smartclockdaemon.h"
+#include "../alarm/jsonalarmstorage.h"
+#include "../stopwatch/jsonstopwatchstorage.h"
+#include "../timer/jsontimerstorage.h"
+
+static QString uniqueSocketName() {
+    return "smartclockd-test-" + QUuid::createUuid().toString(QUuid::Id128).left(12);
+}
+
+static SmartClockDaemon::Options testOptions(const QString &socketName) {
+    SmartClockDaemon::Options options;
+    options.socketName = socketName;
+    options.saveDelayMs = 10;
+    return options;
+}
+
+// The server shares this thread, so spin the event loop instead of blocking.
+static QList<QByteArray> readLines(QLocalSocket &socket, int count, int timeoutMs = 3000) {
+    QByteArray buffer;
+    QElapsedTimer clock;
+    clock.start();
+    while (buffer.count('\n') < count && clock.elapsed() < timeoutMs) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        buffer += socket.readAll();
+    }
+    QList<QByteArray> lines = buffer.split('\n');
+    lines.removeLast();
+    return lines;
+}
+
+TEST(ControlServerTest, SplitArgumentsHonoursQuotes) {
+    const QList<QByteArray> tokens = ControlServer::splitArguments("add  \"Tea time\" 180 \"say \\\"hi\\\"\"\r");
+    ASSERT_EQ(tokens.size(), 4);
+    EXPECT_EQ(tokens[0], "add");
+    EXPECT_EQ(tokens[1], "Tea time");
+    EXPECT_EQ(tokens[2], "180");
+    EXPECT_EQ(tokens[3], "say \"hi\"");
+
+    EXPECT_EQ(ControlServer::quote("plain"), "plain");
+    EXPECT_EQ(ControlServer::splitArguments(ControlServer::quote("a \"b\" \\c")).value(0), "a \"b\" \\c");
+    EXPECT_EQ(ControlServer::splitArguments(ControlServer::quote("")).value(0), "");
+}
+
+TEST(ControlServerTest, QuoteKeepsMultiLineValuesOnOneLine) {
+    const QByteArray name = "Line one\nLine two\r\n\x01";
+    const QByteArray quoted = ControlServer::quote(name);
+    EXPECT_FALSE(quoted.contains('\n'));
+    EXPECT_FALSE(quoted.contains('\r'));
+    EXPECT_EQ(ControlServer::splitArguments("x " + quoted + " y"), QList<QByteArray>({"x", name, "y"}));
+    EXPECT_EQ(ControlServer::quote("a\x01"), "\"a\x01\"");
+
+    QTemporaryDir dir;
+    SmartClockDaemon daemon(testOptions(uniqueSocketName()),
+                            std::make_unique<JsonTimerStorage>(dir.path() + "/timers.json"),
+                            std::make_unique<JsonAlarmStorage>(dir.path() + "/alarms.json"));
+    ASSERT_TRUE(daemon.start());
+    QLocalSocket client;
+    client.connectToServer(daemon.controlServer()->serverName());
+    ASSERT_TRUE(client.waitForConnected(1000));
+    client.write("timer add \"Tea\\nTime\" 60\ntimer get 1\nping\n");
+    client.flush();
+
+    const QList<QByteArray> lines = readLines(client, 3);
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[0], "OK 1");
+    EXPECT_EQ(lines[1], "OK id=1 state=paused remaining=60 duration=60 name=\"Tea\\nTime\"");
+    EXPECT_EQ(lines[2], "OK pong");
+    EXPECT_EQ(daemon.timers()->timerAt(0).name, "Tea\nTime");
+}
+
+TEST(ControlServerTest, ExecuteReportsUnknownAndEmptyRequests) {
+    ControlServer server;
+    server.registerCommand("echo", [](const QList<QByteArray> &args) {
+        return ControlServer::Reply{true, args.join(' ')};
+    });
+    EXPECT_EQ(server.execute("ECHO a b"), "OK a b");
+    EXPECT_EQ(server.execute("echo"), "OK");
+    EXPECT_EQ(server.execute("   "), "ERR empty request");
+    EXPECT_EQ(server.execute("nope"), "ERR unknown command nope");
+}
+
+TEST(SmartClockDaemonTest, AnswersPipelinedRequestsInOrder) {
+    QTemporaryDir dir;
+    SmartClockDaemon daemon(testOptions(uniqueSocketName()),
+                            std::make_unique<JsonTimerStorage>(dir.path() + "/timers.json"),
+                            std::make_unique<JsonAlarmStorage>(dir.path() + "/alarms.json"));
+    ASSERT_TRUE(daemon.start());
+    daemon.timers()->addTimer("Tea", 180);
+
+    QLocalSocket client;
+    client.connectToServer(daemon.controlServer()->serverName());
+    ASSERT_TRUE(client.waitForConnected(1000));
+    client.write("ping\nstatus\nbogus\n");
+    client.flush();
+
+    const QList<QByteArray> lines = readLines(client, 3);
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[0], "OK pong");
+    EXPECT_EQ(lines[1], "OK timers=1 running=0 alarms=0 enabled=0");
+    EXPECT_EQ(lines[2], "ERR unknown command bogus");
+}
+
+TEST(SmartClockDaemonTest, SecondInstanceCannotTakeALiveSocket) {
+    QTemporaryDir dir;
+    const QString name = uniqueSocketName();
+    SmartClockDaemon first(testOptions(name),
+                           std::make_unique<JsonTimerStorage>(dir.path() + "/timers.json"),
+                           std::make_unique<JsonAlarmStorage>(dir.path() + "/alarms.json"));
+    SmartClockDaemon second(testOptions(name),
+                            std::make_unique<JsonTimerStorage>(dir.path() + "/timers.json"),
+                            std::make_unique<JsonAlarmStorage>(dir.path() + "/alarms.json"));
+    ASSERT_TRUE(first.start());
+    EXPECT_FALSE(second.start());
+}
+
+TEST(SmartClockDaemonTest, QuitCommandRequestsExit) {
+    QTemporaryDir dir;
+    SmartClockDaemon daemon(testOptions(uniqueSocketName()),
+                            std::make_unique<JsonTimerStorage>(dir.path() + "/timers.json"),
+                            std::make_unique<JsonAlarmStorage>(dir.path() + "/alarms.json"));
+    QSignalSpy spy(&daemon, &SmartClockDaemon::quitRequested);
+    EXPECT_EQ(daemon.controlServer()->execute("quit"), "OK");
+    EXPECT_EQ(spy.count(), 0);
+    EXPECT_TRUE(spy.wait(1000));
+}
+
+TEST(SmartClockDaemonTest, FiredAlarmRunsActionAndPersists) {
+    QTemporaryDir dir;
+    const QString alarmPath = dir.path() + "/alarms.json";
+    SmartClockDaemon::Options options = testOptions(uniqueSocketName());
+    options.control = false;
+    SmartClockDaemon daemon(options,
+                            std::make_unique<JsonTimerStorage>(dir.path() + "/timers.json"),
+                            std::make_unique<JsonAlarmStorage>(alarmPath));
+    ASSERT_TRUE(daemon.start());
+
+    AlarmData a;
+    a.name = "Wake";
+    a.time = QTime::currentTime();
+    a.snooze = false;
+    a.enabled = true;
+    a.nextTrigger = QDateTime::currentDateTime().addSecs(-1);
+    daemon.alarms()->addAlarm(a);
+
+    QSignalSpy spy(&daemon, &SmartClockDaemon::actionFired);
+    EXPECT_TRUE(QMetaObject::invokeMethod(daemon.alarms(), "checkAlarms", Qt::DirectConnection));
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_EQ(spy.at(0).at(0).toString(), "alarm");
+    EXPECT_EQ(spy.at(0).at(1).toString(), "Wake");
+
+    daemon.shutdown();
+    QList<AlarmData> saved;
+    ASSERT_TRUE(JsonAlarmStorage(alarmPath).load(saved));
+    ASSERT_EQ(saved.size(), 1);
+    EXPECT_FALSE(saved.first().enabled);
+}
+
+TEST(SmartClockDaemonTest, StartupLoadsStateQuickly) {
+    QTemporaryDir dir;
+    const QString timerPath = dir.path() + "/timers.json";
+    const QString alarmPath = dir.path() + "/alarms.json";
+    {
+        TimerManager timers(nullptr, std::make_unique<JsonTimerStorage>(timerPath));
+        for (int i = 0; i < 200; ++i)
+            timers.addTimer(QString("T%1").arg(i), 60 + i);
+        ASSERT_TRUE(timers.save());
+        AlarmManager alarms(nullptr, std::make_unique<JsonAlarmStorage>(alarmPath));
+        for (int i = 0; i < 200; ++i) {
+            AlarmData a;
+            a.name = QString("A%1").arg(i);
+            a.time = QTime(6 + i % 12, i % 60);
+            a.repeatMode = RepeatMode::EveryDay;
+            a.snooze = false;
+            a.enabled = true;
+            alarms.addAlarm(a);
+        }
+        ASSERT_TRUE(alarms.save());
+    }
+
+    QElapsedTimer clock;
+    clock.start();
+    SmartClockDaemon daemon(testOptions(uniqueSocketName()),
+                            std::make_unique<JsonTimerStorage>(timerPath),
+                            std::make_unique<JsonAlarmStorage>(alarmPath));
+    ASSERT_TRUE(daemon.start());
+    const qint64 startMs = clock.elapsed();
+
+    EXPECT_EQ(daemon.timers()->timerCount(), 200);
+    EXPECT_EQ(daemon.alarms()->alarmCount(), 200);
+
+    RecordProperty("startup_ms", int(startMs));
+}
+
+static std::unique_ptr<SmartClockDaemon> makeDaemon(const QTemporaryDir &dir, const QString &socketName) {
+    return std::make_unique<SmartClockDaemon>(testOptions(socketName),
+                                              std::make_unique<JsonTimerStorage>(dir.path() + "/timers.json"),
+                                              std::make_unique<JsonAlarmStorage>(dir.path() + "/alarms.json"),
+                                              std::make_unique<JsonStopwatchStorage>(dir.path() + "/stopwatch.json"));
+}
+
+TEST(SmartClockDaemonTest, ControlCommandsDriveTimersAlarmsAndStopwatch) {
+    QTemporaryDir dir;
+    auto daemon = makeDaemon(dir, uniqueSocketName());
+    ASSERT_TRUE(daemon->start());
+    ControlServer *server = daemon->controlServer();
+
+    EXPECT_EQ(server->execute("timer add \"Tea time\" 180"), "OK 1");
+    EXPECT_EQ(server->execute("timer add Eggs 300 Kitchen Breakfast"), "OK 2");
+    EXPECT_EQ(server->execute("timer list"), "OK 1 2");
+    EXPECT_EQ(server->execute("timer start 1 2"), "OK");
+    EXPECT_TRUE(server->execute("timer get 1").startsWith("OK id=1 state=running remaining=1"));
+    EXPECT_EQ(server->execute("timer pause 2"), "OK");
+    EXPECT_EQ(server->execute("timer get 2"), "OK id=2 state=paused remaining=300 duration=300 name=Eggs");
+    EXPECT_TRUE(server->execute("timer get 1").endsWith("name=\"Tea time\""));
+    EXPECT_EQ(server->execute("timer start 1 99"), "ERR unknown timer 99");
+    EXPECT_EQ(server->execute("timer add Bad -5").left(10), "ERR usage:");
+    EXPECT_EQ(server->execute("timer remove 1"), "OK");
+    EXPECT_EQ(server->execute("timer list"), "OK 2");
+    EXPECT_EQ(daemon->timers()->timerAt(0).type, "Kitchen");
+    EXPECT_EQ(daemon->timers()->timerAt(0).groupName, "Breakfast");
+
+    EXPECT_EQ(server->execute("alarm add Wake 7:30 Weekdays"), "OK 1");
+    EXPECT_EQ(server->execute("alarm add Gym 18:00 \"FREQ=WEEKLY;BYDAY=MO,TH\""), "OK 2");
+    EXPECT_EQ(daemon->alarms()->alarmAt(0).repeatMode, RepeatMode::Weekdays);
+    EXPECT_TRUE(daemon->alarms()->alarmAt(1).rule.isValid());
+    EXPECT_TRUE(server->execute("alarm get 1").startsWith("OK id=1 enabled=1 time=07:30:00 next=2"));
+    EXPECT_EQ(server->execute("alarm disable 1"), "OK");
+    EXPECT_EQ(server->execute("alarm disable 1"), "OK");
+    EXPECT_EQ(server->execute("alarm get 1"), "OK id=1 enabled=0 time=07:30:00 next=- name=Wake");
+    EXPECT_EQ(server->execute("alarm enable 1"), "OK");
+    EXPECT_TRUE(daemon->alarms()->alarmAt(0).enabled);
+    EXPECT_TRUE(server->execute("alarm add Bad 7:30 FREQ=YEARLY").startsWith("ERR invalid rule"));
+    EXPECT_EQ(server->execute("alarm add Bad 7:30 Sometimes"), "ERR unknown repeat Sometimes");
+    EXPECT_EQ(server->execute("alarm add Bad 25:00").left(10), "ERR usage:");
+    EXPECT_EQ(server->execute("alarm remove 2"), "OK");
+    EXPECT_EQ(server->execute("alarm list"), "OK 1");
+
+    EXPECT_EQ(server->execute("stopwatch lap"), "ERR stopwatch is not running");
+    EXPECT_EQ(server->execute("stopwatch start"), "OK");
+    EXPECT_EQ(server->execute("stopwatch lap"), "OK 1");
+    EXPECT_EQ(server->execute("stopwatch pause"), "OK");
+    EXPECT_TRUE(server->execute("stopwatch get").startsWith("OK running=0 elapsed_ms="));
+    EXPECT_TRUE(server->execute("stopwatch get").endsWith(" laps=1"));
+    EXPECT_EQ(server->execute("stopwatch reset"), "OK");
+    EXPECT_EQ(server->execute("stopwatch get"), "OK running=0 elapsed_ms=0 laps=0");
+    EXPECT_EQ(server->execute("stopwatch fly"), "ERR unknown stopwatch command fly");
+
+    EXPECT_EQ(server->execute("save"), "OK");
+    TimerManager reloaded(nullptr, std::make_unique<JsonTimerStorage>(dir.path() + "/timers.json"));
+    ASSERT_TRUE(reloaded.load());
+    EXPECT_EQ(reloaded.timerCount(), 1);
+}
+
+TEST(SmartClockDaemonTest, SubscribersReceiveOnlyTheirTopics) {
+    QTemporaryDir dir;
+    auto daemon = makeDaemon(dir, uniqueSocketName());
+    ASSERT_TRUE(daemon->start());
+
+    QLocalSocket alarms;
+    QLocalSocket timers;
+    alarms.connectToServer(daemon->controlServer()->serverName());
+    timers.connectToServer(daemon->controlServer()->serverName());
+    ASSERT_TRUE(alarms.waitForConnected(1000));
+    ASSERT_TRUE(timers.waitForConnected(1000));
+    alarms.write("subscribe\n");
+    timers.write("subscribe timer\nunsubscribe alarm\n");
+    alarms.flush();
+    timers.flush();
+    EXPECT_EQ(readLines(alarms, 1), QList<QByteArray>({"OK"}));
+    EXPECT_EQ(readLines(timers, 2), QList<QByteArray>({"OK", "OK"}));
+    EXPECT_EQ(daemon->controlServer()->subscriberCount(), 2);
+
+    AlarmData a;
+    a.name = "Stand up";
+    a.time = QTime::currentTime();
+    a.snooze = false;
+    a.enabled = true;
+    a.nextTrigger = QDateTime::currentDateTime().addSecs(-1);
+    daemon->alarms()->addAlarm(a);
+    EXPECT_TRUE(QMetaObject::invokeMethod(daemon->alarms(), "checkAlarms", Qt::DirectConnection));
+
+    EXPECT_EQ(readLines(alarms, 1), QList<QByteArray>({"! alarm triggered 1 \"Stand up\""}));
+
+    // The timer-only client sees the timer event and nothing from the alarm.
+    timers.write("timer add Tick 1\ntimer start 1\n");
+    timers.flush();
+    const QList<QByteArray> lines = readLines(timers, 3, 5000);
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[0], "OK 1");
+    EXPECT_EQ(lines[1], "OK");
+    EXPECT_EQ(lines[2], "! timer finished 1 Tick");
+}
+
+TEST(SmartClockDaemonTest, PipelinedCommandsAreBatched) {
+    constexpr int kCommands = 20000;
+    QTemporaryDir dir;
+    auto daemon = makeDaemon(dir, uniqueSocketName());
+    ASSERT_TRUE(daemon->start());
+    QSignalSpy changes(daemon->timers(), &TimerManager::timersUpdated);
+
+    QByteArray requests;
+    for (int i = 0; i < kCommands / 2; ++i)
+        requests += "timer add T" + QByteArray::number(i) + " 60\n";
+    for (int i = 0; i < kCommands / 2; ++i)
+        requests += "timer get " + QByteArray::number(i + 1) + '\n';
+
+    QLocalSocket client;
+    client.connectToServer(daemon->controlServer()->serverName());
+    ASSERT_TRUE(client.waitForConnected(1000));
+
+    QElapsedTimer clock;
+    clock.start();
+    client.write(requests);
+    const QList<QByteArray> lines = readLines(client, kCommands, 30000);
+    const qint64 elapsedMs = clock.elapsed();
+
+    ASSERT_EQ(lines.size(), kCommands);
+    EXPECT_EQ(lines.first(), "OK 1");
+    EXPECT_EQ(lines.at(kCommands / 2 - 1), "OK " + QByteArray::number(kCommands / 2));
+    EXPECT_EQ(lines.last(), "OK id=" + QByteArray::number(kCommands / 2)
+                                + " state=paused remaining=60 duration=60 name=T" + QByteArray::number(kCommands / 2 - 1));
+    EXPECT_EQ(daemon->timers()->timerCount(), kCommands / 2);
+    EXPECT_LT(changes.count(), kCommands / 100);
+
+    const qint64 perSecond = kCommands * 1000 / qMax<qint64>(1, elapsedMs);
+    RecordProperty("commands_per_s", int(perSecond));
+    RecordProperty("model_notifications", int(changes.count()));
+}
@@ -11,8 +11,14 @@
 #include <gtest/gtest.h>
 #include <QTemporaryDir>
 #include <QFile>
+#include <QThread>
+#include <QSignalSpy>
 #include "../stopwatch/stopwatchmodel.h"
+#include "../stopwatch/stopwatchbank.h"
 #include "../stopwatch/jsonstopwatchstorage.h"
+#include "../stopwatch/stopwatchtime.h"
+
+using namespace std::chrono_literals;
 
 namespace {
 
@@ -60,6 +66,22 @@ TEST(StopwatchModelTest, StartStopAndTickUpdatesElapsed) {
     EXPECT_GE(model.elapsedMs(), 150);
 }
 
+TEST(StopwatchModelTest, ElapsedFollowsMonotonicClockWithoutTicks) {
+    StopwatchModel model;
+    model.start();
+    QThread::msleep(50);
+    EXPECT_GE(model.elapsedMs(), 50);
+
+    model.stop();
+    const qint64 frozen = model.elapsedMs();
+    QThread::msleep(20);
+    EXPECT_EQ(model.elapsedMs(), frozen);
+
+    model.start();
+    QThread::msleep(20);
+    EXPECT_GE(model.elapsedMs(), frozen + 20);
+}
+
 TEST(StopwatchModelTest, AddLapWhileRunningAddsEntry) {
     StopwatchModel model;
     model.start();
@@ -79,6 +101,86 @@ TEST(StopwatchModelTest, ResetClearsState) {
     EXPECT_TRUE(model.lapDurations().isEmpty());
 }
 
+TEST(StopwatchModelTest, AddLapEmitsLapAddedAndTracksExtremes) {
+    StopwatchModel model(nullptr, std::make_unique<MemoryStopwatchStorage>(nullptr));
+    QSignalSpy added(&model, &StopwatchModel::lapAdded);
+    QSignalSpy replaced(&model, &StopwatchModel::lapsChanged);
+    EXPECT_EQ(model.bestLapIndex(), -1);
+    EXPECT_EQ(model.worstLapIndex(), -1);
+
+    model.start();
+    const int segments[] = { 1000, 3000, 500, 2000 };
+    for (int ms : segments) {
+        model.tick(ms);
+        model.addLap();
+    }
+
+    ASSERT_EQ(added.count(), 4);
+    for (int i = 0; i < added.count(); ++i)
+        EXPECT_EQ(added.at(i).at(0).toInt(), i);
+    EXPECT_EQ(replaced.count(), 0);
+    EXPECT_EQ(model.bestLapIndex(), 2);
+    EXPECT_EQ(model.worstLapIndex(), 1);
+    EXPECT_TRUE(model.lapText(0).startsWith("Lap 1: "));
+    EXPECT_EQ(model.lapText(3), model.lapTexts().last());
+    EXPECT_TRUE(model.lapText(4).isEmpty());
+
+    model.reset();
+    EXPECT_EQ(replaced.count(), 1);
+    EXPECT_EQ(model.bestLapIndex(), -1);
+    EXPECT_EQ(model.worstLapIndex(), -1);
+}
+
+TEST(StopwatchModelTest, LoadRecomputesLapExtremes) {
+    MemoryStopwatchData data;
+    data.has = true;
+    data.snapshot.lapDurations = { 400ms, 200ms, 900ms, 200ms };
+    StopwatchModel model(nullptr, std::make_unique<MemoryStopwatchStorage>(&data));
+    ASSERT_TRUE(model.load());
+    EXPECT_EQ(model.bestLapIndex(), 1);
+    EXPECT_EQ(model.worstLapIndex(), 2);
+}
+
+TEST(StopwatchModelTest, SplitsAndStatisticsFollowLaps) {
+    MemoryStopwatchData data;
+    data.has = true;
+    data.snapshot.lapDurations = { 400ms, 200ms, 900ms, 200ms };
+    StopwatchModel model(nullptr, std::make_unique<MemoryStopwatchStorage>(&data));
+    ASSERT_TRUE(model.load());
+
+    EXPECT_EQ(model.splitTimes(), QList<StopwatchTime::Duration>({ 400ms, 600ms, 1500ms, 1700ms }));
+    EXPECT_EQ(model.splitTime(2), 1500ms);
+    EXPECT_EQ(model.lapDuration(2), 900ms);
+    EXPECT_EQ(model.splitTime(4), 0ms);
+
+    LapStatistics stats = model.lapStatistics();
+    EXPECT_EQ(stats.count, 4);
+    EXPECT_DOUBLE_EQ(stats.meanUs, 425000.0);
+    EXPECT_EQ(stats.best, 200ms);
+    EXPECT_EQ(stats.worst, 900ms);
+    EXPECT_NEAR(stats.stdDevUs, 286138.1, 0.1);
+
+    model.reset();
+    stats = model.lapStatistics();
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_TRUE(model.splitTimes().isEmpty());
+}
+
+TEST(StopwatchModelTest, AddLapUsesLastSplit) {
+    StopwatchModel model(nullptr, std::make_unique<MemoryStopwatchStorage>(nullptr));
+    model.start();
+    model.tick(1000);
+    model.addLap();
+    model.tick(2000);
+    model.addLap();
+
+    ASSERT_EQ(model.splitTimes().size(), 2);
+    EXPECT_EQ(model.splitTime(1), model.splitTime(0) + model.lapDuration(1));
+    EXPECT_GE(model.lapDuration(1), 2000ms);
+    EXPECT_LE(model.splitTime(1), model.elapsed());
+    EXPECT_EQ(model.lapStatistics().count, 2);
+}
+
 TEST(StopwatchModelTest, SaveLoadRoundTrip) {
     MemoryStopwatchData data;
     StopwatchModel model(nullptr, std::make_unique<MemoryStopwatchStorage>(&data));
@@ -102,17 +204,18 @@ TEST(JsonStopwatchStorageTest, SavesAndLoadsSnapshot) {
 
     JsonStopwatchStorage storage(path);
     StopwatchSnapshot in;
-    in.elapsedMs = 1234;
+    in.elapsed = 1234567us;
     in.running = true;
-    in.lapDurations.append(400);
-    in.lapDurations.append(834);
+    in.lapDurations.append(400ms);
+    in.lapDurations.append(834567us);
     ASSERT_TRUE(storage.save(in));
 
     StopwatchSnapshot out;
     ASSERT_TRUE(storage.load(out));
-    EXPECT_EQ(out.elapsedMs, 1234);
+    EXPECT_EQ(out.elapsed, 1234567us);
     EXPECT_TRUE(out.running);
-    EXPECT_EQ(out.lapDurations.size(), 2);
+    ASSERT_EQ(out.lapDurations.size(), 2);
+    EXPECT_EQ(out.lapDurations[1], 834567us);
 }
 
 TEST(JsonStopwatchStorageTest, SaveDefaultRemovesFile) {
@@ -145,7 +248,199 @@ TEST(JsonStopwatchStorageTest, LoadsCorruptedJsonGracefully) {
     JsonStopwatchStorage storage(path);
     StopwatchSnapshot out;
     EXPECT_TRUE(storage.load(out));
-    EXPECT_EQ(out.elapsedMs, 0);
+    EXPECT_EQ(out.elapsed, 0us);
     EXPECT_FALSE(out.running);
     EXPECT_EQ(out.lapDurations.size(), 0);
 }
+
+TEST(JsonStopwatchStorageTest, LoadsLegacyMillisecondFile) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.path() + "/stopwatch.json";
+
+    QFile f(path);
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    f.write("{\"elapsed_ms\":1500,\"running\":false,\"durations\":[700,800]}");
+    f.close();
+
+    JsonStopwatchStorage storage(path);
+    StopwatchSnapshot out;
+    ASSERT_TRUE(storage.load(out));
+    EXPECT_EQ(out.elapsed, 1500ms);
+    EXPECT_EQ(out.lapDurations, QList<StopwatchTime::Duration>({ 700ms, 800ms }));
+}
+
+TEST(StopwatchTimeTest, FormatsHoursAndDays) {
+    EXPECT_EQ(StopwatchTime::format(0us), "00:00.00");
+    EXPECT_EQ(StopwatchTime::format(-5s), "00:00.00");
+    EXPECT_EQ(StopwatchTime::format(61s + 239999us), "01:01.23");
+    EXPECT_EQ(StopwatchTime::format(1h + 2min + 3s), "1:02:03.00");
+    EXPECT_EQ(StopwatchTime::format(24h * 3 + 4h + 5min + 6s + 70ms), "3d 04:05:06.07");
+}
+
+TEST(StopwatchModelTest, ElapsedDoesNotWrapAfterADay) {
+    MemoryStopwatchData data;
+    data.has = true;
+    data.snapshot.elapsed = 24h * 2 + 1h;
+    StopwatchModel model(nullptr, std::make_unique<MemoryStopwatchStorage>(&data));
+    ASSERT_TRUE(model.load());
+
+    EXPECT_EQ(model.elapsed(), 24h * 2 + 1h);
+    EXPECT_EQ(model.elapsedMs(), qint64(49) * 3600 * 1000);
+    EXPECT_EQ(model.formattedElapsed(), "2d 01:00:00.00");
+
+    model.start();
+    model.tick(1500);
+    model.addLap();
+    EXPECT_GE(model.lapDuration(0), 24h * 2 + 1h + 1500ms);
+    EXPECT_TRUE(model.lapText(0).startsWith("Lap 1: 2d 01:00:01."));
+}
+
+TEST(StopwatchBankTest, BulkOperationsAffectOnlyListedStopwatches) {
+    StopwatchBank bank(nullptr, std::make_unique<MemoryStopwatchStorage>(nullptr));
+    EXPECT_EQ(bank.addStopwatch("A"), 0);
+    EXPECT_EQ(bank.addStopwatch("B"), 1);
+    EXPECT_EQ(bank.addStopwatch("C"), 2);
+
+    QSignalSpy stateSpy(&bank, &StopwatchBank::stateChanged);
+    bank.start({ 0, 2, 7 });
+    ASSERT_EQ(stateSpy.count(), 1);
+    EXPECT_EQ(stateSpy.takeFirst().at(0).value<QList<int>>(), QList<int>({ 0, 2 }));
+    EXPECT_TRUE(bank.isRunning(0));
+    EXPECT_FALSE(bank.isRunning(1));
+    EXPECT_TRUE(bank.isRunning(2));
+    EXPECT_EQ(bank.runningCount(), 2);
+
+    QThread::msleep(30);
+    bank.stop({ 0 });
+    EXPECT_EQ(bank.runningCount(), 1);
+    EXPECT_GE(bank.elapsed(0), 30ms);
+    EXPECT_EQ(bank.elapsed(1), 0us);
+
+    const StopwatchTime::Duration frozen = bank.elapsed(0);
+    QThread::msleep(10);
+    EXPECT_EQ(bank.elapsed(0), frozen);
+    EXPECT_GT(bank.elapsed(2), frozen);
+
+    bank.stopAll();
+    EXPECT_EQ(bank.runningCount(), 0);
+    bank.startAll();
+    EXPECT_EQ(bank.runningCount(), 3);
+}
+
+TEST(StopwatchBankTest, LapRecordsOnRunningStopwatchesOnly) {
+    StopwatchBank bank(nullptr, std::make_unique<MemoryStopwatchStorage>(nullptr));
+    bank.addStopwatch("A");
+    bank.addStopwatch("B");
+    bank.start({ 0 });
+    QThread::msleep(10);
+
+    QSignalSpy lapSpy(&bank, &StopwatchBank::lapsRecorded);
+    bank.lap({ 0, 1 });
+    ASSERT_EQ(lapSpy.count(), 1);
+    EXPECT_EQ(lapSpy.takeFirst().at(0).value<QList<int>>(), QList<int>({ 0 }));
+    ASSERT_EQ(bank.lapDurations(0).size(), 1);
+    EXPECT_TRUE(bank.lapDurations(1).isEmpty());
+
+    QThread::msleep(10);
+    bank.lap({ 0 });
+    bank.stop({ 0 });
+    const QList<StopwatchTime::Duration> laps = bank.lapDurations(0);
+    ASSERT_EQ(laps.size(), 2);
+    EXPECT_LE(laps[0] + laps[1], bank.elapsed(0));
+
+    bank.reset({ 0 });
+    EXPECT_EQ(bank.elapsed(0), 0us);
+    EXPECT_TRUE(bank.lapDurations(0).isEmpty());
+}
+
+TEST(StopwatchBankTest, RemoveKeepsRunningBitsAligned) {
+    StopwatchBank bank(nullptr, std::make_unique<MemoryStopwatchStorage>(nullptr));
+    bank.addStopwatch("A");
+    bank.addStopwatch("B");
+    bank.addStopwatch("C");
+    bank.start({ 0, 2 });
+
+    bank.removeStopwatch(0);
+    ASSERT_EQ(bank.count(), 2);
+    EXPECT_EQ(bank.name(0), "B");
+    EXPECT_FALSE(bank.isRunning(0));
+    EXPECT_TRUE(bank.isRunning(1));
+    EXPECT_EQ(bank.runningCount(), 1);
+}
+
+TEST(StopwatchBankTest, BankFileSitsNextToTheStopwatchFile) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    JsonStopwatchStorage storage(dir.path() + "/stopwatch.json");
+
+    StopwatchSnapshot single;
+    single.elapsed = 5s;
+    ASSERT_TRUE(storage.save(single));
+    StopwatchBankSnapshot bank;
+    bank.entries.append({ "Lane 1", StopwatchSnapshot{} });
+    bank.entries.last().state.elapsed = 7s;
+    ASSERT_TRUE(storage.saveBank(bank));
+
+    EXPECT_TRUE(QFile::exists(dir.path() + "/stopwatch.bank.json"));
+    StopwatchSnapshot singleOut;
+    ASSERT_TRUE(storage.load(singleOut));
+    EXPECT_EQ(singleOut.elapsed, 5s);
+    StopwatchBankSnapshot bankOut;
+    ASSERT_TRUE(storage.loadBank(bankOut));
+    ASSERT_EQ(bankOut.entries.size(), 1);
+    EXPECT_EQ(bankOut.entries[0].name, "Lane 1");
+    EXPECT_EQ(bankOut.entries[0].state.elapsed, 7s);
+}
+
+TEST(StopwatchBankTest, JsonBankRoundTrip) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.path() + "/stopwatches.json";
+
+    StopwatchBank bank(nullptr, std::make_unique<JsonStopwatchStorage>(path));
+    bank.addStopwatch("Lane 1");
+    bank.addStopwatch("Lane 2");
+    bank.start({ 0, 1 });
+    QThread::msleep(10);
+    bank.lap({ 1 });
+    bank.stop({ 0 });
+    ASSERT_TRUE(bank.save());
+
+    StopwatchBank reload(nullptr, std::make_unique<JsonStopwatchStorage>(path));
+    ASSERT_TRUE(reload.load());
+    ASSERT_EQ(reload.count(), 2);
+    EXPECT_EQ(reload.name(1), "Lane 2");
+    EXPECT_FALSE(reload.isRunning(0));
+    EXPECT_TRUE(reload.isRunning(1));
+    EXPECT_EQ(reload.runningCount(), 1);
+    EXPECT_EQ(reload.elapsed(0), bank.elapsed(0));
+    EXPECT_EQ(reload.lapDurations(1), bank.lapDurations(1));
+
+    reload.removeStopwatch(1);
+    reload.removeStopwatch(0);
+    ASSERT_TRUE(reload.save());
+    EXPECT_FALSE(QFile::exists(dir.path() + "/stopwatches.bank.json"));
+}
+
+TEST(StopwatchBankTest, StorageNamedLikeTheBankKeepsBothStates) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    JsonStopwatchStorage storage(dir.path() + "/stopwatches.json");
+
+    StopwatchSnapshot single;
+    single.elapsed = 3s;
+    ASSERT_TRUE(storage.save(single));
+    StopwatchBankSnapshot bank;
+    bank.entries.append({ "Lane 1", StopwatchSnapshot{} });
+    bank.entries.last().state.elapsed = 9s;
+    ASSERT_TRUE(storage.saveBank(bank));
+
+    StopwatchSnapshot singleOut;
+    ASSERT_TRUE(storage.load(singleOut));
+    EXPECT_EQ(singleOut.elapsed, 3s);
+    StopwatchBankSnapshot bankOut;
+    ASSERT_TRUE(storage.loadBank(bankOut));
+    ASSERT_EQ(bankOut.entries.size(), 1);
+    EXPECT_EQ(bankOut.entries[0].state.elapsed, 9s);
+}
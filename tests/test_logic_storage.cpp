@@ -0,0 +1,311 @@
+/**
+ * @file test_logic_storage.cpp
+ * @brief Definitions for test_logic_storage.
+ * @details Implements logic declared in the corresponding header for test_logic_storage.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <QThread>
+#include "../storage/atomicfile.h"
+#include "../storage/debouncedsaver.h"
+#include "../storage/asyncstorage.h"
+#include "../storage/instancelock.h"
+#include "../timer/timermanager.h"
+#include "../timer/jsontimerstorage.h"
+
+namespace {
+
+QByteArray readAll(const QString &path)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return {};
+    return f.readAll();
+}
+
+struct MemoryTimerData {
+    TimerSnapshot snapshot;
+    QThread *saveThread = nullptr;
+    int saveDelayMs = 0;
+    bool failSaves = false;
+};
+
+class MemoryTimerStorage : public ITimerStorage {
+public:
+    explicit MemoryTimerStorage(MemoryTimerData *data) : data(data) {}
+    bool load(TimerSnapshot &out) override {
+        out = data->snapshot;
+        return true;
+    }
+    bool save(const TimerSnapshot &in) override {
+        if (data->saveDelayMs > 0)
+            QThread::msleep(data->saveDelayMs);
+        data->saveThread = QThread::currentThread();
+        if (data->failSaves)
+            return false;
+        data->snapshot = in;
+        return true;
+    }
+private:
+    MemoryTimerData *data = nullptr;
+};
+
+using AsyncTimerStorage = AsyncStorage<ITimerStorage, TimerSnapshot>;
+
+} // namespace
+
+TEST(AtomicFileTest, WriteCreatesAndReplacesFile) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.path() + "/data.json";
+
+    ASSERT_TRUE(AtomicFile::write(path, "first"));
+    EXPECT_EQ(readAll(path), QByteArray("first"));
+
+    ASSERT_TRUE(AtomicFile::write(path, "second"));
+    EXPECT_EQ(readAll(path), QByteArray("second"));
+    EXPECT_FALSE(QFile::exists(AtomicFile::backupPath(path)));
+}
+
+TEST(AtomicFileTest, WriteLeavesNoTemporaryFilesBehind) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.path() + "/data.json";
+
+    ASSERT_TRUE(AtomicFile::write(path, "payload"));
+    const QStringList entries = QDir(dir.path()).entryList(QDir::Files);
+    EXPECT_EQ(entries, QStringList{"data.json"});
+}
+
+TEST(AtomicFileTest, KeepBackupRollsPreviousContent) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.path() + "/data.json";
+    const QString bak = AtomicFile::backupPath(path);
+
+    ASSERT_TRUE(AtomicFile::write(path, "v1", true));
+    EXPECT_FALSE(QFile::exists(bak));
+
+    ASSERT_TRUE(AtomicFile::write(path, "v2", true));
+    EXPECT_EQ(readAll(bak), QByteArray("v1"));
+
+    ASSERT_TRUE(AtomicFile::write(path, "v3", true));
+    EXPECT_EQ(readAll(bak), QByteArray("v2"));
+    EXPECT_EQ(readAll(path), QByteArray("v3"));
+}
+
+TEST(AtomicFileTest, WriteIntoMissingDirectoryFails) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.path() + "/missing/data.json";
+
+    EXPECT_FALSE(AtomicFile::write(path, "payload"));
+    EXPECT_FALSE(QFile::exists(path));
+}
+
+TEST(AtomicFileTest, JsonStorageKeepsBackupWhenEnabled) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.path() + "/timers.json";
+
+    JsonTimerStorage storage(path);
+    storage.setBackupEnabled(true);
+
+    TimerSnapshot snap;
+    ASSERT_TRUE(storage.save(snap));
+    ASSERT_TRUE(storage.save(snap));
+    EXPECT_TRUE(QFile::exists(AtomicFile::backupPath(path)));
+
+    TimerSnapshot out;
+    EXPECT_TRUE(storage.load(out));
+    EXPECT_TRUE(out.timers.isEmpty());
+}
+
+TEST(InstanceLockTest, SecondHolderIsRefusedUntilTheFirstReleases) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.path() + "/data/smartclock.lock";
+
+    auto first = std::make_unique<InstanceLock>(path);
+    ASSERT_TRUE(first->tryLock());
+    EXPECT_TRUE(QFile::exists(path));
+
+    InstanceLock second(path);
+    EXPECT_FALSE(second.tryLock());
+
+    first.reset();
+    EXPECT_TRUE(second.tryLock());
+}
+
+TEST(DebouncedSaverTest, CoalescesBurstIntoSingleWrite) {
+    int writes = 0;
+    DebouncedSaver saver([&writes]() { ++writes; return true; });
+    saver.setDelay(50);
+    QSignalSpy spy(&saver, &DebouncedSaver::flushed);
+
+    for (int i = 0; i < 500; ++i)
+        saver.markDirty();
+    EXPECT_TRUE(saver.isPending());
+    EXPECT_EQ(writes, 0);
+
+    ASSERT_TRUE(spy.wait(1000));
+    EXPECT_EQ(writes, 1);
+    EXPECT_FALSE(saver.isPending());
+}
+
+TEST(DebouncedSaverTest, FlushWritesImmediatelyOnlyWhenDirty) {
+    int writes = 0;
+    DebouncedSaver saver([&writes]() { ++writes; return true; });
+    saver.setDelay(60 * 1000);
+
+    EXPECT_TRUE(saver.flush());
+    EXPECT_EQ(writes, 0);
+
+    saver.markDirty();
+    EXPECT_TRUE(saver.flush());
+    EXPECT_EQ(writes, 1);
+    EXPECT_FALSE(saver.isPending());
+
+    EXPECT_TRUE(saver.flush());
+    EXPECT_EQ(writes, 1);
+}
+
+TEST(DebouncedSaverTest, FlushReportsFailedWrite) {
+    DebouncedSaver saver([]() { return false; });
+    QSignalSpy spy(&saver, &DebouncedSaver::flushed);
+
+    saver.markDirty();
+    EXPECT_FALSE(saver.flush());
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_FALSE(spy.takeFirst().at(0).toBool());
+}
+
+TEST(AsyncStorageTest, SaveRunsOnWorkerThreadWithoutBlocking) {
+    MemoryTimerData data;
+    data.saveDelayMs = 300;
+    AsyncTimerStorage storage(std::make_unique<MemoryTimerStorage>(&data));
+
+    TimerSnapshot snap;
+    snap.recommendations.insert("A", "B");
+
+    QElapsedTimer clock;
+    clock.start();
+    EXPECT_TRUE(storage.save(snap));
+    EXPECT_LT(clock.elapsed(), 200);
+
+    storage.waitForIdle();
+    EXPECT_NE(data.saveThread, nullptr);
+    EXPECT_NE(data.saveThread, QThread::currentThread());
+    EXPECT_EQ(data.snapshot.recommendations.value("A"), "B");
+}
+
+TEST(AsyncStorageTest, StoragesShareOneWorkerThread) {
+    MemoryTimerData first;
+    MemoryTimerData second;
+    AsyncTimerStorage a(std::make_unique<MemoryTimerStorage>(&first));
+    AsyncTimerStorage b(std::make_unique<MemoryTimerStorage>(&second));
+
+    TimerSnapshot snap;
+    a.save(snap);
+    b.save(snap);
+    a.waitForIdle();
+
+    ASSERT_NE(first.saveThread, nullptr);
+    EXPECT_EQ(first.saveThread, second.saveThread);
+    EXPECT_NE(first.saveThread, QThread::currentThread());
+}
+
+TEST(AsyncStorageTest, LoadObservesEarlierSaves) {
+    MemoryTimerData data;
+    data.saveDelayMs = 50;
+    AsyncTimerStorage storage(std::make_unique<MemoryTimerStorage>(&data));
+
+    TimerSnapshot snap;
+    snap.recommendations.insert("X", "Y");
+    storage.save(snap);
+
+    TimerSnapshot out;
+    EXPECT_TRUE(storage.load(out));
+    EXPECT_EQ(out.recommendations.value("X"), "Y");
+}
+
+TEST(AsyncStorageTest, FuturesReportResults) {
+    MemoryTimerData data;
+    AsyncTimerStorage storage(std::make_unique<MemoryTimerStorage>(&data));
+
+    TimerSnapshot snap;
+    snap.recommendations.insert("K", "V");
+    EXPECT_TRUE(storage.saveAsync(snap).result());
+
+    const std::optional<TimerSnapshot> loaded = storage.loadAsync().result();
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->recommendations.value("K"), "V");
+}
+
+TEST(AsyncStorageTest, DestructionWaitsForQueuedSaves) {
+    MemoryTimerData data;
+    data.saveDelayMs = 100;
+    {
+        AsyncTimerStorage storage(std::make_unique<MemoryTimerStorage>(&data));
+        TimerSnapshot snap;
+        snap.recommendations.insert("Q", "R");
+        storage.save(snap);
+    }
+    EXPECT_EQ(data.snapshot.recommendations.value("Q"), "R");
+}
+
+TEST(AsyncStorageTest, FailedBackgroundWritesAreReported) {
+    MemoryTimerData data;
+    data.failSaves = true;
+    AsyncTimerStorage storage(std::make_unique<MemoryTimerStorage>(&data));
+    TimerSnapshot snap;
+
+    // Without a scope the failure shows up on the next save.
+    EXPECT_TRUE(storage.save(snap));
+    storage.waitForIdle();
+    EXPECT_FALSE(storage.save(snap));
+    storage.waitForIdle();
+
+    {
+        SyncSaveScope wait;
+        EXPECT_FALSE(storage.save(snap));
+        data.failSaves = false;
+        EXPECT_TRUE(storage.save(snap));
+    }
+    EXPECT_TRUE(storage.save(snap));
+}
+
+TEST(AsyncStorageTest, SaverFlushWaitsForTheWrite) {
+    MemoryTimerData data;
+    data.failSaves = true;
+    TimerManager m(nullptr, std::make_unique<AsyncTimerStorage>(std::make_unique<MemoryTimerStorage>(&data)));
+    DebouncedSaver saver([&m]() { return m.save(); });
+    QSignalSpy spy(&saver, &DebouncedSaver::flushed);
+
+    saver.markDirty();
+    EXPECT_FALSE(saver.flush());
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_FALSE(spy.takeFirst().at(0).toBool());
+}
+
+TEST(AsyncStorageTest, TimerManagerRoundTripThroughAdapter) {
+    MemoryTimerData data;
+    TimerManager m(nullptr, std::make_unique<AsyncTimerStorage>(std::make_unique<MemoryTimerStorage>(&data)));
+    m.addTimer("Tea", 120, "Normal", "Kitchen");
+    EXPECT_TRUE(m.save());
+
+    TimerManager reload(nullptr, std::make_unique<AsyncTimerStorage>(std::make_unique<MemoryTimerStorage>(&data)));
+    m.setStorage(nullptr);
+    EXPECT_TRUE(reload.load());
+    ASSERT_EQ(reload.getTimers().size(), 1);
+    EXPECT_EQ(reload.getTimers().first().name, "Tea");
+}
@@ -15,8 +15,13 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QSignalSpy>
+#include <QThread>
+#include <QMetaObject>
 #include "../timer/timermanager.h"
 #include "../timer/jsontimerstorage.h"
+#include "../timer/binarytimerstorage.h"
+#include "../timer/timerhistoryjournal.h"
 
 class TimerManagerLogicTest : public ::testing::Test {
 protected:
@@ -109,6 +114,81 @@ TEST_F(TimerManagerLogicTest, GetNextTimerFindsShortestRunning) {
     EXPECT_EQ(manager->getNextTimer().name, "Short");
 }
 
+TEST_F(TimerManagerLogicTest, GetNextTimerSkipsPausedTimers) {
+    manager->addTimer("Long", 100);
+    manager->addTimer("Short", 5);
+    manager->startTimer(0);
+    manager->startTimer(1);
+    manager->pauseTimer(1);
+    EXPECT_EQ(manager->getNextTimer().name, "Long");
+
+    manager->pauseTimer(0);
+    EXPECT_TRUE(manager->getNextTimer().name.isEmpty());
+}
+
+TEST_F(TimerManagerLogicTest, GetNextTimerFollowsRemovedRows) {
+    manager->addTimer("Long", 100);
+    manager->addTimer("Mid", 50);
+    manager->addTimer("Short", 5);
+    manager->startTimer(0);
+    manager->startTimer(1);
+    manager->startTimer(2);
+
+    manager->removeTimer(0);
+    EXPECT_EQ(manager->getNextTimer().name, "Short");
+    manager->removeTimer(1);
+    EXPECT_EQ(manager->getNextTimer().name, "Mid");
+}
+
+TEST_F(TimerManagerLogicTest, TickFinishesOnlyDueTimers) {
+    manager->addTimer("Quick", 1);
+    manager->addTimer("Slow", 60);
+    manager->startTimer(0);
+    manager->startTimer(1);
+
+    QSignalSpy spy(manager, &TimerManager::timerFinished);
+    QThread::msleep(1100);
+    EXPECT_TRUE(QMetaObject::invokeMethod(manager, "updateTimers", Qt::DirectConnection));
+
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_EQ(spy.first().first().toString(), "Quick");
+    EXPECT_EQ(manager->getTimers()[0].status, TimerStatus::Finished);
+    EXPECT_EQ(manager->getTimers()[0].remaining, 0);
+    EXPECT_EQ(manager->getTimers()[1].status, TimerStatus::Running);
+    EXPECT_LT(manager->getTimers()[1].remaining, 60);
+    EXPECT_EQ(manager->getNextTimer().name, "Slow");
+}
+
+TEST_F(TimerManagerLogicTest, FinishNotifiesChangesBeforeListenersReenter) {
+    manager->addTimer("Quick", 1);
+    manager->addTimer("Other", 1);
+    manager->addTimer("Slow", 60);
+    manager->startTimers({ 0, 1, 2 });
+
+    QList<QList<int>> changes;
+    QStringList finished;
+    QObject::connect(manager, &TimerManager::timersChanged, manager, [&](const QList<int> &indices) {
+        changes.append(indices);
+    });
+    // Stands in for a listener whose nested event loop lets the user delete timers.
+    QObject::connect(manager, &TimerManager::timerFinished, manager, [&](const QString &name) {
+        finished << name;
+        if (finished.size() == 1) {
+            EXPECT_EQ(changes.size(), 1);
+            manager->removeTimers({ 0, 1 });
+        }
+    });
+    QThread::msleep(1100);
+    EXPECT_TRUE(QMetaObject::invokeMethod(manager, "updateTimers", Qt::DirectConnection));
+
+    EXPECT_EQ(finished, QStringList({ "Quick", "Other" }));
+    ASSERT_EQ(changes.size(), 2);
+    EXPECT_EQ(changes[0], QList<int>({ 0, 1, 2 }));
+    EXPECT_TRUE(changes[1].isEmpty());
+    ASSERT_EQ(manager->timerCount(), 1);
+    EXPECT_EQ(manager->timerAt(0).name, "Slow");
+}
+
 TEST_F(TimerManagerLogicTest, HasTimerReturnsFalseWhenMissing) {
     manager->addTimer("Exists", 10);
     EXPECT_FALSE(manager->hasTimer("Missing"));
@@ -140,6 +220,217 @@ TEST_F(TimerManagerLogicTest, StartGroupStartsMatchingTimers) {
     EXPECT_FALSE(manager->getTimers()[2].running);
 }
 
+TEST_F(TimerManagerLogicTest, BatchStartPauseEmitOneNotification) {
+    for (int i = 0; i < 5; ++i)
+        manager->addTimer(QString("T%1").arg(i), 60);
+
+    QSignalSpy updated(manager, &TimerManager::timersUpdated);
+    QSignalSpy changed(manager, &TimerManager::timersChanged);
+    manager->startTimers({ 3, 1, 9, 1 });
+    ASSERT_EQ(updated.count(), 1);
+    ASSERT_EQ(changed.count(), 1);
+    EXPECT_EQ(changed.takeFirst().at(0).value<QList<int>>(), QList<int>({ 1, 3 }));
+    EXPECT_TRUE(manager->getTimers()[1].running);
+    EXPECT_TRUE(manager->getTimers()[3].running);
+    EXPECT_FALSE(manager->getTimers()[0].running);
+
+    updated.clear();
+    manager->pauseTimers({ 0, 1, 2 });
+    EXPECT_EQ(updated.count(), 1);
+    ASSERT_EQ(changed.count(), 1);
+    EXPECT_EQ(changed.takeFirst().at(0).value<QList<int>>(), QList<int>({ 1 }));
+
+    updated.clear();
+    manager->pauseTimers({ 0, 2 });
+    EXPECT_EQ(updated.count(), 0);
+}
+
+TEST_F(TimerManagerLogicTest, StartingARunningTimerKeepsItsDeadline) {
+    manager->addTimer("Tea", 60);
+    manager->startTimer(0);
+    const QDateTime started = manager->timerAt(0).lastUpdated;
+    const int remaining = manager->timerAt(0).remaining;
+
+    QSignalSpy changed(manager, &TimerManager::timersChanged);
+    QThread::msleep(20);
+    manager->startTimer(0);
+    manager->startGroup("Default");
+
+    EXPECT_EQ(changed.count(), 0);
+    EXPECT_EQ(manager->timerAt(0).lastUpdated, started);
+    EXPECT_EQ(manager->timerAt(0).remaining, remaining);
+}
+
+TEST_F(TimerManagerLogicTest, RemoveTimersCompactsInOnePass) {
+    for (int i = 0; i < 6; ++i)
+        manager->addTimer(QString("T%1").arg(i), 60);
+    manager->startTimers({ 4, 5 });
+
+    QSignalSpy updated(manager, &TimerManager::timersUpdated);
+    manager->removeTimers({ 0, 4, 2, 2, 17 });
+    EXPECT_EQ(updated.count(), 1);
+
+    const auto timers = manager->getTimers();
+    ASSERT_EQ(timers.size(), 3);
+    EXPECT_EQ(timers[0].name, "T1");
+    EXPECT_EQ(timers[1].name, "T3");
+    EXPECT_EQ(timers[2].name, "T5");
+    EXPECT_TRUE(timers[2].running);
+    EXPECT_EQ(manager->getNextTimer().name, "T5");
+}
+
+TEST_F(TimerManagerLogicTest, UpdateScopeCoalescesNotifications) {
+    for (int i = 0; i < 4; ++i)
+        manager->addTimer(QString("T%1").arg(i), 60);
+    manager->startTimer(0);
+
+    QSignalSpy updated(manager, &TimerManager::timersUpdated);
+    QSignalSpy changed(manager, &TimerManager::timersChanged);
+    {
+        TimerManager::UpdateScope outer(manager);
+        manager->pauseTimers({ 0 });
+        {
+            TimerManager::UpdateScope inner(manager);
+            manager->startTimers({ 2 });
+            manager->startTimer(3);
+        }
+        EXPECT_EQ(updated.count(), 0);
+    }
+    ASSERT_EQ(updated.count(), 1);
+    ASSERT_EQ(changed.count(), 1);
+    EXPECT_EQ(changed.takeFirst().at(0).value<QList<int>>(), QList<int>({ 0, 2, 3 }));
+
+    updated.clear();
+    {
+        TimerManager::UpdateScope batch(manager);
+        manager->startTimers({ 1 });
+        manager->removeTimers({ 0 });
+    }
+    ASSERT_EQ(changed.count(), 1);
+    EXPECT_TRUE(changed.takeFirst().at(0).value<QList<int>>().isEmpty());
+    EXPECT_EQ(updated.count(), 1);
+}
+
+TEST_F(TimerManagerLogicTest, ZeroCopyAccessorsAndQueries) {
+    manager->addTimer("A", 30);
+    manager->addTimer("B", 30);
+    manager->addTimer("C", 1);
+    manager->startTimers({ 0, 2 });
+    manager->pauseTimer(0);
+
+    const QList<TimerData> &list = manager->timerList();
+    EXPECT_EQ(&list, &manager->timerList());
+    EXPECT_EQ(manager->timerCount(), 3);
+    EXPECT_EQ(&manager->timerAt(1), &list[1]);
+    EXPECT_EQ(manager->countByStatus(TimerStatus::Running), 1);
+    EXPECT_EQ(manager->countByStatus(TimerStatus::Paused), 2);
+    EXPECT_EQ(manager->countByStatus(TimerStatus::Finished), 0);
+
+    EXPECT_EQ(manager->findByName("B"), 1);
+    EXPECT_EQ(manager->findByName("missing"), -1);
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    EXPECT_EQ(manager->remainingSeconds(1, nowMs), 30);
+    EXPECT_EQ(manager->remainingSeconds(2, nowMs + 5000), 0);
+    EXPECT_EQ(manager->remainingSeconds(7, nowMs), 0);
+}
+
+TEST_F(TimerManagerLogicTest, IdsStayStableAcrossRemovals) {
+    manager->addTimer("A", 30);
+    manager->addTimer("B", 30);
+    manager->addTimer("C", 30);
+    const quint64 idB = manager->timerAt(1).id;
+    const quint64 idC = manager->timerAt(2).id;
+    EXPECT_NE(idB, 0u);
+    EXPECT_NE(idB, idC);
+    EXPECT_EQ(manager->indexOfId(idC), 2);
+
+    manager->removeTimer(0);
+    EXPECT_EQ(manager->indexOfId(idB), 0);
+    EXPECT_EQ(manager->indexOfId(idC), 1);
+    EXPECT_EQ(manager->findByName("C"), 1);
+    EXPECT_EQ(manager->findByName("A"), -1);
+    EXPECT_FALSE(manager->hasTimer("A"));
+
+    manager->addTimer("A", 30);
+    EXPECT_NE(manager->timerAt(2).id, idB);
+    EXPECT_NE(manager->timerAt(2).id, idC);
+    EXPECT_EQ(manager->indicesOfIds({ idC, 999999, idB }), QList<int>({ 1, 0 }));
+
+    manager->editTimer(1, "Renamed", 20, "Normal", "Default");
+    EXPECT_EQ(manager->timerAt(1).id, idC);
+    EXPECT_EQ(manager->findByName("Renamed"), 1);
+    EXPECT_EQ(manager->findByName("C"), -1);
+}
+
+TEST(TimerIdPersistenceTest, IdsSurviveRestartInBothFormats) {
+    QTemporaryDir dir;
+    for (const QString &format : { QString("json"), QString("bin") }) {
+        const QString path = dir.path() + "/timers." + format;
+        auto storage = [&]() -> std::unique_ptr<ITimerStorage> {
+            if (format == "json")
+                return std::make_unique<JsonTimerStorage>(path);
+            return std::make_unique<BinaryTimerStorage>(path);
+        };
+
+        quint64 idB = 0;
+        quint64 idC = 0;
+        {
+            TimerManager m(nullptr, storage());
+            m.addTimer("A", 30);
+            m.addTimer("B", 30);
+            m.addTimer("C", 30);
+            idB = m.timerAt(1).id;
+            idC = m.timerAt(2).id;
+            m.removeTimer(0);
+            ASSERT_TRUE(m.save());
+        }
+        {
+            TimerManager m(nullptr, storage());
+            ASSERT_TRUE(m.load());
+            ASSERT_EQ(m.timerCount(), 2);
+            EXPECT_EQ(m.timerAt(0).id, idB) << format.toStdString();
+            EXPECT_EQ(m.timerAt(1).id, idC) << format.toStdString();
+
+            m.removeTimer(m.indexOfId(idB));
+            m.addTimer("D", 30);
+            EXPECT_GT(m.timerAt(1).id, idC);
+            ASSERT_TRUE(m.save());
+        }
+        TimerManager m(nullptr, storage());
+        ASSERT_TRUE(m.load());
+        EXPECT_EQ(m.indexOfId(idC), 0);
+        EXPECT_EQ(m.indexOfId(idB), -1);
+    }
+}
+
+TEST(TimerIdPersistenceTest, ZeroAndDuplicateIdsAreRenumbered) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/timers.json";
+    QJsonArray arr;
+    for (int id : { 7, 7, 0 }) {
+        QJsonObject o;
+        o["name"] = QString("T%1").arg(arr.size());
+        o["duration"] = 10;
+        o["remaining"] = 10;
+        o["running"] = false;
+        o["id"] = id;
+        arr.append(o);
+    }
+    QFile f(path);
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    f.write(QJsonDocument(QJsonObject{{"timers", arr}}).toJson());
+    f.close();
+
+    TimerManager m(nullptr, std::make_unique<JsonTimerStorage>(path));
+    ASSERT_TRUE(m.load());
+    ASSERT_EQ(m.timerCount(), 3);
+    EXPECT_EQ(m.timerAt(0).id, 7u);
+    EXPECT_GT(m.timerAt(1).id, 7u);
+    EXPECT_GT(m.timerAt(2).id, 7u);
+    EXPECT_NE(m.timerAt(1).id, m.timerAt(2).id);
+}
+
 TEST_F(TimerManagerLogicTest, DeletedTimersAddAndClear) {
     TimerData t;
     t.name = "Old";
@@ -267,3 +558,192 @@ TEST(JsonTimerStorageTest, LoadInvalidJsonReturnsTrueAndClears) {
     EXPECT_TRUE(out.deletedTimers.isEmpty());
     EXPECT_TRUE(out.recommendations.isEmpty());
 }
+
+TEST(BinaryTimerStorageTest, RoundTripKeepsMillisecondTimestamps) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/timers.bin";
+
+    TimerSnapshot in;
+    TimerData t{};
+    t.name = "Tea";
+    t.duration = 180;
+    t.remaining = 42;
+    t.running = true;
+    t.lastUpdated = QDateTime::fromMSecsSinceEpoch(1700000000123);
+    t.type = "Melody";
+    t.groupName = "Kitchen";
+    in.timers.append(t);
+    TimerData gone{};
+    gone.name = "Old";
+    gone.type = "Normal";
+    gone.groupName = "Default";
+    in.deletedTimers.append(gone);
+    in.recommendations.insert("Tea", "Old");
+
+    BinaryTimerStorage storage(path);
+    ASSERT_TRUE(storage.save(in));
+
+    TimerSnapshot out;
+    ASSERT_TRUE(storage.load(out));
+    ASSERT_EQ(out.timers.size(), 1);
+    EXPECT_EQ(out.timers[0].name, "Tea");
+    EXPECT_EQ(out.timers[0].remaining, 42);
+    EXPECT_TRUE(out.timers[0].running);
+    EXPECT_EQ(out.timers[0].lastUpdated.toMSecsSinceEpoch(), 1700000000123);
+    EXPECT_EQ(out.timers[0].groupName, "Kitchen");
+    ASSERT_EQ(out.deletedTimers.size(), 1);
+    EXPECT_FALSE(out.deletedTimers[0].lastUpdated.isValid());
+    EXPECT_EQ(out.recommendations.value("Tea"), "Old");
+}
+
+TEST(BinaryTimerStorageTest, MigratesLegacyJsonOnFirstLoad) {
+    QTemporaryDir dir;
+    const QString jsonPath = dir.path() + "/timers.json";
+    const QString binPath = dir.path() + "/timers.bin";
+
+    TimerManager m(nullptr, std::make_unique<JsonTimerStorage>(jsonPath));
+    m.addTimer("Legacy", 90, "Normal", "Default");
+    ASSERT_TRUE(m.save());
+
+    BinaryTimerStorage storage(binPath, jsonPath);
+    TimerSnapshot out;
+    ASSERT_TRUE(storage.load(out));
+    ASSERT_EQ(out.timers.size(), 1);
+    EXPECT_EQ(out.timers[0].name, "Legacy");
+    EXPECT_TRUE(QFile::exists(binPath));
+
+    QFile bin(binPath);
+    ASSERT_TRUE(bin.open(QIODevice::ReadOnly));
+    TimerSnapshot decoded;
+    EXPECT_TRUE(BinaryTimerStorage::decode(bin.readAll(), decoded));
+    EXPECT_EQ(decoded.timers.size(), 1);
+}
+
+TEST(BinaryTimerStorageTest, RejectsForeignOrTruncatedData) {
+    TimerSnapshot in;
+    TimerData t{};
+    t.name = "X";
+    in.timers.append(t);
+    const QByteArray good = BinaryTimerStorage::encode(in);
+
+    TimerSnapshot out;
+    EXPECT_FALSE(BinaryTimerStorage::decode(QByteArray("{\"timers\":[]}"), out));
+    EXPECT_FALSE(BinaryTimerStorage::decode(good.left(good.size() - 3), out));
+    EXPECT_TRUE(BinaryTimerStorage::decode(good, out));
+}
+
+static TimerData historyTimer(const QString &name, int duration)
+{
+    TimerData t{};
+    t.name = name;
+    t.duration = duration;
+    t.remaining = duration;
+    t.type = "Normal";
+    t.groupName = "Default";
+    return t;
+}
+
+TEST(TimerHistoryJournalTest, ReplaysAddsAndRemoves) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/history.journal";
+
+    QList<TimerData> history;
+    {
+        TimerHistoryJournal journal(path);
+        history = {historyTimer("A", 10), historyTimer("B", 20), historyTimer("C", 30)};
+        journal.recordAdded(history, history);
+        history.removeAt(1);
+        journal.recordRemoved(1, history);
+    }
+
+    TimerHistoryJournal reopened(path);
+    QList<TimerData> out;
+    ASSERT_TRUE(reopened.load(out));
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[0].name, "A");
+    EXPECT_EQ(out[1].name, "C");
+    EXPECT_EQ(out[1].duration, 30);
+}
+
+TEST(TimerHistoryJournalTest, RemovalCostDoesNotGrowWithHistory) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/history.journal";
+    TimerHistoryJournal journal(path);
+    journal.setCompactionThreshold(1024 * 1024 * 1024);
+
+    QList<TimerData> history;
+    for (int i = 0; i < 2000; ++i)
+        history.append(historyTimer(QString("T%1").arg(i), i));
+    journal.recordAdded(history, history);
+    journal.waitForIdle();
+    const qint64 before = journal.journalSize();
+
+    history.removeAt(0);
+    journal.recordRemoved(0, history);
+    journal.waitForIdle();
+    EXPECT_LT(journal.journalSize() - before, 64);
+}
+
+TEST(TimerHistoryJournalTest, CompactsInBackgroundPastThreshold) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/history.journal";
+    TimerHistoryJournal journal(path);
+    journal.setCompactionThreshold(512);
+
+    QList<TimerData> history;
+    for (int i = 0; i < 50; ++i) {
+        QList<TimerData> added{historyTimer(QString("T%1").arg(i), i)};
+        history.append(added);
+        journal.recordAdded(added, history);
+        history.removeFirst();
+        journal.recordRemoved(0, history);
+        journal.waitForIdle();
+    }
+    journal.waitForIdle();
+    EXPECT_LT(journal.journalSize(), 1024);
+
+    TimerHistoryJournal reopened(path);
+    QList<TimerData> out;
+    ASSERT_TRUE(reopened.load(out));
+    EXPECT_TRUE(out.isEmpty());
+}
+
+TEST(TimerHistoryJournalTest, SkipsTornTrailingRecord) {
+    QTemporaryDir dir;
+    const QString path = dir.path() + "/history.journal";
+    QFile f(path);
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    f.write("{\"op\":\"add\",\"name\":\"A\",\"duration\":5}\n{\"op\":\"rem");
+    f.close();
+
+    TimerHistoryJournal journal(path);
+    QList<TimerData> out;
+    ASSERT_TRUE(journal.load(out));
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].name, "A");
+    EXPECT_EQ(out[0].type, "Normal");
+}
+
+TEST(TimerHistoryJournalTest, ImportsLegacyHistoryJson) {
+    QTemporaryDir dir;
+    const QString legacy = dir.path() + "/history.json";
+    const QString path = dir.path() + "/history.journal";
+
+    QJsonArray arr;
+    QJsonObject o;
+    o["name"] = "Old";
+    o["duration"] = 60;
+    arr.append(o);
+    QFile f(legacy);
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    f.write(QJsonDocument(arr).toJson());
+    f.close();
+
+    TimerHistoryJournal journal(path, legacy);
+    QList<TimerData> out;
+    ASSERT_TRUE(journal.load(out));
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].name, "Old");
+    journal.waitForIdle();
+    EXPECT_TRUE(QFile::exists(path));
+}
@@ -16,8 +16,14 @@
 #include <QSystemTrayIcon>
 #include <QTabWidget>
 #include <QSettings>
+#include <QTableView>
+#include <QSignalSpy>
+#include <QTest>
 #include "../mainwindow.h"
 #include "../thememanager.h"
+#include "../activitymanager.h"
+#include "../timer/timerwindow.h"
+#include "../timer/timertablemodel.h"
 
 
 
@@ -184,4 +190,73 @@ TEST(MainWindowTest, UpdateThemeIconSafelyFindsButtons) {
 
     ThemeManager::instance().applyTheme(Theme::Dark);
     QMetaObject::invokeMethod(&w, "updateThemeIcon", Qt::DirectConnection);
-}
\ No newline at end of file
+}
+
+TEST(ActivityManagerTest, NeverShownViewStaysActiveUntilHidden) {
+    QWidget view;
+    ActivityManager &activity = ActivityManager::instance();
+    activity.watch(&view);
+    QSignalSpy changed(&activity, &ActivityManager::activeChanged);
+
+    EXPECT_TRUE(activity.isActive(&view));
+
+    view.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&view));
+    EXPECT_TRUE(activity.isActive(&view));
+
+    view.hide();
+    EXPECT_FALSE(activity.isActive(&view));
+    ASSERT_FALSE(changed.isEmpty());
+    EXPECT_EQ(changed.last().at(0).value<QWidget*>(), &view);
+    EXPECT_FALSE(changed.last().at(1).toBool());
+}
+
+TEST(ActivityManagerTest, OnlyCurrentTabIsActiveAndTrayPausesAll) {
+    qputenv("TEST_MODE", "1");
+    MainWindow w;
+    w.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&w));
+
+    auto *tabs = w.findChild<QTabWidget*>("tabWidget");
+    ASSERT_NE(tabs, nullptr);
+    ActivityManager &activity = ActivityManager::instance();
+
+    EXPECT_TRUE(activity.isActive(tabs->widget(0)));
+    EXPECT_FALSE(activity.isActive(tabs->widget(2)));
+    EXPECT_FALSE(activity.isActive(tabs->widget(3)));
+
+    tabs->setCurrentIndex(3);
+    EXPECT_FALSE(activity.isActive(tabs->widget(0)));
+    EXPECT_TRUE(activity.isActive(tabs->widget(3)));
+
+    QCloseEvent closeEvent;
+    QApplication::sendEvent(&w, &closeEvent);
+    for (int i = 0; i < tabs->count(); ++i)
+        EXPECT_FALSE(activity.isActive(tabs->widget(i)));
+}
+
+TEST(ActivityManagerTest, HiddenTimerTabCatchesUpWhenShown) {
+    qputenv("TEST_MODE", "1");
+    MainWindow w;
+    w.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&w));
+
+    auto *tabs = w.findChild<QTabWidget*>("tabWidget");
+    ASSERT_NE(tabs, nullptr);
+    auto *timerWindow = qobject_cast<TimerWindow*>(tabs->widget(3));
+    ASSERT_NE(timerWindow, nullptr);
+    auto *table = timerWindow->findChild<QTableView*>("tableTimers");
+    ASSERT_NE(table, nullptr);
+    auto *model = qobject_cast<TimerTableModel*>(table->model());
+    ASSERT_NE(model, nullptr);
+    EXPECT_TRUE(model->isPaused());
+
+    const int before = model->rowCount();
+    timerWindow->getManager()->addTimer("Background", 60, "Normal", "Default");
+    EXPECT_EQ(model->rowCount(), before);
+    EXPECT_EQ(timerWindow->getManager()->getTimers().size(), before + 1);
+
+    tabs->setCurrentWidget(timerWindow);
+    EXPECT_FALSE(model->isPaused());
+    EXPECT_EQ(model->rowCount(), before + 1);
+}
@@ -13,6 +13,7 @@
 #include <QTemporaryDir>
 #include <QPushButton>
 #include <QListWidget>
+#include <QListView>
 #include <QLabel>
 #include <QTest>
 #include <QSettings>
@@ -22,10 +23,16 @@
 #include <QPainter>
 #include <QSize>
 #include <QStackedWidget>
+#include <QElapsedTimer>
+#include <QSignalSpy>
 #include <QStyleOptionViewItem>
 #include "../stopwatch/stopwatchwindow.h"
 #include "../stopwatch/analogstopwatchdial.h"
+#include "../stopwatch/jsonstopwatchstorage.h"
+#include "../stopwatch/stopwatchbankmodel.h"
+#include "../stopwatch/stopwatchbankwindow.h"
 #include "../thememanager.h"
+#include "../refreshscheduler.h"
 
 TEST(AnalogStopwatchDialTest, InitialStateIsZero) {
     AnalogStopwatchDial dial;
@@ -70,6 +77,53 @@ TEST(AnalogStopwatchDialTest, PaintEventCoversLightTheme) {
     });
 }
 
+TEST(AnalogStopwatchDialTest, FaceIsCachedAcrossFrames) {
+    AnalogStopwatchDial dial;
+    dial.resize(300, 300);
+    QImage frame(dial.size(), QImage::Format_ARGB32_Premultiplied);
+
+    for (int i = 0; i < 20; ++i) {
+        dial.setElapsed(QTime(0, 0, 0).addMSecs(i * 10));
+        dial.render(&frame);
+    }
+    EXPECT_EQ(dial.faceRenderCount(), 1);
+
+    dial.resize(320, 320);
+    dial.render(&frame);
+    EXPECT_EQ(dial.faceRenderCount(), 2);
+
+    emit ThemeManager::instance().themeChanged(QString());
+    dial.render(&frame);
+    EXPECT_EQ(dial.faceRenderCount(), 3);
+}
+
+TEST(AnalogStopwatchDialTest, PerFrameCostWithAndWithoutFaceCache) {
+    AnalogStopwatchDial dial;
+    dial.resize(400, 400);
+    QImage frame(dial.size(), QImage::Format_ARGB32_Premultiplied);
+    constexpr int kFrames = 200;
+
+    QElapsedTimer clock;
+    clock.start();
+    for (int i = 0; i < kFrames; ++i) {
+        dial.invalidateFace();
+        dial.setElapsed(QTime(0, 0, 0).addMSecs(i * 10));
+        dial.render(&frame);
+    }
+    const qint64 uncachedNs = clock.nsecsElapsed();
+
+    clock.restart();
+    for (int i = 0; i < kFrames; ++i) {
+        dial.setElapsed(QTime(0, 0, 0).addMSecs(i * 10));
+        dial.render(&frame);
+    }
+    const qint64 cachedNs = clock.nsecsElapsed();
+
+    RecordProperty("uncached_us_per_frame", int(uncachedNs / kFrames / 1000));
+    RecordProperty("cached_us_per_frame", int(cachedNs / kFrames / 1000));
+    EXPECT_EQ(dial.faceRenderCount(), kFrames + 1);
+}
+
 TEST(AnalogStopwatchDialTest, MinimumSizeIsSet) {
     AnalogStopwatchDial dial;
     EXPECT_EQ(dial.minimumSize(), QSize(250, 250));
@@ -305,6 +359,170 @@ TEST(StopwatchWindowExtraTest, TimerSafelyStopsWhenNotRunning) {
     btnStartStop->click();
 
     // Запускаємо syncFromModel напряму, щоб покрити гілку,
-    // де timer->isActive() перевіряється перед зупинкою
+    // де планувальник оновлень зупиняється
     EXPECT_TRUE(QMetaObject::invokeMethod(&w, "syncFromModel", Qt::DirectConnection));
-}
\ No newline at end of file
+}
+
+TEST(RefreshSchedulerTest, IdleWhileHiddenOrInactive) {
+    QWidget w;
+    RefreshScheduler scheduler(&w);
+    scheduler.setHiddenInterval(0);
+
+    scheduler.setActive(true);
+    EXPECT_FALSE(scheduler.isOnScreen());
+    EXPECT_EQ(scheduler.currentInterval(), 0);
+
+    w.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&w));
+    scheduler.setActive(false);
+    EXPECT_EQ(scheduler.currentInterval(), 0);
+}
+
+TEST(RefreshSchedulerTest, TicksAtFrameRateWhileVisible) {
+    QWidget w;
+    RefreshScheduler scheduler(&w);
+    QSignalSpy ticks(&scheduler, &RefreshScheduler::tick);
+
+    w.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&w));
+    scheduler.setActive(true);
+
+    EXPECT_TRUE(scheduler.isOnScreen());
+    EXPECT_EQ(scheduler.currentInterval(), scheduler.frameInterval());
+    EXPECT_LE(scheduler.frameInterval(), 1000 / 24);
+    EXPECT_TRUE(ticks.wait(500));
+}
+
+TEST(RefreshSchedulerTest, ThrottlesWhenTabHiddenAndCatchesUpOnShow) {
+    QWidget window;
+    QWidget *page = new QWidget(&window);
+    RefreshScheduler scheduler(page);
+    scheduler.setHiddenInterval(RefreshScheduler::kDefaultHiddenIntervalMs);
+    QSignalSpy ticks(&scheduler, &RefreshScheduler::tick);
+
+    window.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&window));
+    scheduler.setActive(true);
+
+    page->hide();
+    EXPECT_FALSE(scheduler.isOnScreen());
+    EXPECT_EQ(scheduler.currentInterval(), RefreshScheduler::kDefaultHiddenIntervalMs);
+
+    ticks.clear();
+    page->show();
+    EXPECT_TRUE(scheduler.isOnScreen());
+    EXPECT_EQ(ticks.count(), 1);
+    EXPECT_EQ(scheduler.currentInterval(), scheduler.frameInterval());
+
+    scheduler.setHiddenInterval(0);
+    window.hide();
+    EXPECT_EQ(scheduler.currentInterval(), 0);
+}
+
+TEST(RefreshSchedulerTest, StopsWhenWindowMinimized) {
+    QWidget window;
+    QWidget *page = new QWidget(&window);
+    RefreshScheduler scheduler(page);
+    scheduler.setHiddenInterval(0);
+
+    window.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&window));
+    scheduler.setActive(true);
+    ASSERT_GT(scheduler.currentInterval(), 0);
+
+    window.setWindowState(window.windowState() | Qt::WindowMinimized);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(scheduler.currentInterval(), 0);
+
+    window.setWindowState(window.windowState() & ~Qt::WindowMinimized);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(scheduler.currentInterval(), scheduler.frameInterval());
+}
+
+TEST(StopwatchWindowAdvancedTest, LapsAreAppendedWithoutRebuildingTheList) {
+    StopwatchWindow w;
+    QPushButton* start = w.findChild<QPushButton*>("btnStartStop");
+    QPushButton* lap = w.findChild<QPushButton*>("btnLap");
+    QListWidget* list = w.findChild<QListWidget*>("listLaps");
+    ASSERT_TRUE(start && lap && list);
+
+    start->click();
+    lap->click();
+    ASSERT_EQ(list->count(), 1);
+    QListWidgetItem *first = list->item(0);
+
+    for (int i = 0; i < 5; ++i)
+        lap->click();
+
+    ASSERT_EQ(list->count(), 6);
+    EXPECT_EQ(list->item(5), first);
+    EXPECT_TRUE(list->item(0)->text().startsWith("Lap 6: "));
+
+    int best = 0, worst = 0;
+    for (int i = 0; i < list->count(); ++i) {
+        const int flag = list->item(i)->data(Qt::UserRole + 100).toInt();
+        best += flag == 1;
+        worst += flag == 2;
+    }
+    EXPECT_LE(best, 1);
+    EXPECT_EQ(worst, 1);
+}
+
+TEST(StopwatchBankModelTest, RefreshTouchesOnlyRunningRows) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    StopwatchBank bank(nullptr, std::make_unique<JsonStopwatchStorage>(dir.path() + "/stopwatches.json"));
+    for (int i = 0; i < 6; ++i)
+        bank.addStopwatch(QString("S%1").arg(i));
+    StopwatchBankModel model(&bank);
+    ASSERT_EQ(model.rowCount(), 6);
+
+    QSignalSpy spy(&model, &QAbstractItemModel::dataChanged);
+    model.refreshRunning();
+    EXPECT_EQ(spy.count(), 0);
+
+    bank.start({ 1, 2, 4 });
+    spy.clear();
+    model.refreshRunning();
+    ASSERT_EQ(spy.count(), 2);
+    EXPECT_EQ(spy.at(0).at(0).toModelIndex().row(), 1);
+    EXPECT_EQ(spy.at(0).at(1).toModelIndex().row(), 2);
+    EXPECT_EQ(spy.at(1).at(0).toModelIndex().row(), 4);
+    EXPECT_EQ(spy.at(1).at(1).toModelIndex().row(), 4);
+    EXPECT_TRUE(model.rowText(1).startsWith("S1  "));
+}
+
+TEST(StopwatchBankWindowTest, ButtonsDriveSelectedStations) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    StopwatchBank bank(nullptr, std::make_unique<JsonStopwatchStorage>(dir.path() + "/stopwatches.json"));
+    bank.addStopwatch("A");
+    bank.addStopwatch("B");
+    StopwatchBankWindow w(nullptr, &bank);
+
+    QPushButton *startStop = nullptr;
+    QPushButton *startAll = nullptr;
+    for (auto *btn : w.findChildren<QPushButton*>()) {
+        if (btn->text() == "Start")
+            startStop = btn;
+        else if (btn->text() == "Start all")
+            startAll = btn;
+    }
+    ASSERT_TRUE(startStop && startAll);
+    EXPECT_FALSE(startStop->isEnabled());
+
+    QListView *list = w.findChild<QListView*>();
+    ASSERT_TRUE(list);
+    list->selectionModel()->select(w.listModel()->index(1), QItemSelectionModel::Select);
+    ASSERT_TRUE(startStop->isEnabled());
+    startStop->click();
+    EXPECT_FALSE(bank.isRunning(0));
+    EXPECT_TRUE(bank.isRunning(1));
+    EXPECT_EQ(startStop->text(), "Stop");
+
+    startAll->click();
+    EXPECT_EQ(bank.runningCount(), 2);
+    startStop->click();
+    EXPECT_FALSE(bank.isRunning(1));
+    EXPECT_TRUE(bank.isRunning(0));
+}
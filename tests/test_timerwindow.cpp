@@ -9,7 +9,8 @@
  */
 
 #include <gtest/gtest.h>
-#include <QTableWidget>
+#include <QTableView>
+#include <QSignalSpy>
 #include <QComboBox>
 #include <QLabel>
 #include <QApplication>
@@ -20,10 +21,11 @@
 #include <QCloseEvent>
 #include "../timer/timerwindow.h"
 #include "../timer/historytimerwindow.h"
+#include "../timer/timertablemodel.h"
 
 TEST(TimerWindowTest, InitialWidgetsPresent) {
     TimerWindow w;
-    auto *table = w.findChild<QTableWidget*>("tableTimers");
+    auto *table = w.findChild<QTableView*>("tableTimers");
     auto *filter = w.findChild<QComboBox*>("comboBox");
     auto *nextUp = w.findChild<QLabel*>("labelNextUp");
     ASSERT_TRUE(table);
@@ -35,7 +37,7 @@ TEST(TimerWindowTest, InitialWidgetsPresent) {
 
 TEST(TimerWindowTest, AddingTimerUpdatesTable) {
     TimerWindow w;
-    auto *table = w.findChild<QTableWidget*>("tableTimers");
+    auto *table = w.findChild<QTableView*>("tableTimers");
     ASSERT_TRUE(table);
 
     TimerManager *manager = w.getManager();
@@ -44,7 +46,7 @@ TEST(TimerWindowTest, AddingTimerUpdatesTable) {
     manager->addTimer("UI", 10, "Normal", "Default");
     QCoreApplication::processEvents();
 
-    EXPECT_EQ(table->rowCount(), 1);
+    EXPECT_EQ(table->model()->rowCount(), 1);
 }
 
 TEST(TimerWindowTest, UpdateNextUpLabelWhenEmpty) {
@@ -91,12 +93,105 @@ TEST(TimerWindowTest, FilterComboBoxUpdatesTable) {
     manager->addTimer("PausedTimer", 60);
 
     auto *combo = w.findChild<QComboBox*>("comboBox");
-    auto *table = w.findChild<QTableWidget*>("tableTimers");
+    auto *table = w.findChild<QTableView*>("tableTimers");
     ASSERT_TRUE(combo && table);
 
     combo->setCurrentText("Running");
-    EXPECT_EQ(table->rowCount(), 1);
+    EXPECT_EQ(table->model()->rowCount(), 1);
 
     combo->setCurrentText("Paused");
-    EXPECT_EQ(table->rowCount(), 1);
-}
\ No newline at end of file
+    EXPECT_EQ(table->model()->rowCount(), 1);
+}
+
+TEST(TimerWindowTest, GroupListFollowsAddedAndRemovedTimers) {
+    TimerWindow w;
+    TimerManager *manager = w.getManager();
+    auto *groups = w.findChild<QComboBox*>("comboGroups");
+    ASSERT_TRUE(groups);
+
+    manager->addTimer("Tea", 60, "Normal", "Kitchen");
+    EXPECT_NE(groups->findText("Kitchen"), -1);
+
+    manager->startTimer(0);
+    EXPECT_NE(groups->findText("Kitchen"), -1);
+
+    manager->removeTimer(0);
+    EXPECT_EQ(groups->findText("Kitchen"), -1);
+}
+
+TEST(TimerTableModelTest, TickReportsOnlyChangedRows) {
+    TimerManager manager;
+    for (int i = 0; i < 100; ++i)
+        manager.addTimer(QString("T%1").arg(i), 600);
+    TimerTableModel model(&manager);
+    ASSERT_EQ(model.rowCount(), 100);
+
+    QSignalSpy changed(&model, &TimerTableModel::dataChanged);
+    QSignalSpy reset(&model, &TimerTableModel::modelReset);
+
+    manager.startTimer(42);
+    ASSERT_GE(changed.count(), 1);
+    EXPECT_EQ(reset.count(), 0);
+    const auto topLeft = changed.last().at(0).value<QModelIndex>();
+    const auto bottomRight = changed.last().at(1).value<QModelIndex>();
+    EXPECT_EQ(topLeft.row(), 42);
+    EXPECT_EQ(bottomRight.row(), 42);
+    EXPECT_EQ(model.index(42, TimerTableModel::StatusColumn).data().toString(), "Running");
+
+    changed.clear();
+    model.refresh();
+    EXPECT_EQ(changed.count(), 0);
+}
+
+TEST(TimerTableModelTest, ChangedTimersMoveAcrossTheFilter) {
+    TimerManager manager;
+    manager.addTimer("A", 60);
+    manager.addTimer("B", 60);
+    manager.addTimer("C", 60);
+    TimerTableModel model(&manager);
+    model.setStatusFilter("Paused");
+    ASSERT_EQ(model.rowCount(), 3);
+
+    manager.startTimer(1);
+    ASSERT_EQ(model.rowCount(), 2);
+    EXPECT_EQ(model.timerIndex(0), 0);
+    EXPECT_EQ(model.timerIndex(1), 2);
+
+    manager.pauseTimer(1);
+    ASSERT_EQ(model.rowCount(), 3);
+    EXPECT_EQ(model.timerIndex(1), 1);
+    EXPECT_EQ(model.index(1, TimerTableModel::NameColumn).data().toString(), "B");
+}
+
+TEST(TimerTableModelTest, AddingTimerInsertsRowWithoutReset) {
+    TimerManager manager;
+    manager.addTimer("A", 60);
+    TimerTableModel model(&manager);
+
+    QSignalSpy inserted(&model, &TimerTableModel::rowsInserted);
+    QSignalSpy reset(&model, &TimerTableModel::modelReset);
+    manager.addTimer("B", 30);
+
+    EXPECT_EQ(inserted.count(), 1);
+    EXPECT_EQ(reset.count(), 0);
+    ASSERT_EQ(model.rowCount(), 2);
+    EXPECT_EQ(model.index(1, TimerTableModel::NameColumn).data().toString(), "B");
+    EXPECT_EQ(model.index(1, TimerTableModel::RemainingColumn).data().toString(), "00:00:30");
+}
+
+TEST(TimerTableModelTest, FilteredRowsMapToManagerIndices) {
+    TimerManager manager;
+    manager.addTimer("Paused", 60);
+    manager.addTimer("Running", 60);
+    manager.startTimer(1);
+    TimerTableModel model(&manager);
+
+    model.setStatusFilter("Running");
+    ASSERT_EQ(model.rowCount(), 1);
+    EXPECT_EQ(model.timerIndex(0), 1);
+    EXPECT_EQ(model.timerIndex(1), -1);
+
+    manager.removeTimer(0);
+    ASSERT_EQ(model.rowCount(), 1);
+    EXPECT_EQ(model.timerIndex(0), 0);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file binarytimerstorage.cpp
+ * @brief Definitions for binarytimerstorage.
+ * @details Implements logic declared in the corresponding header for binarytimerstorage.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "binarytimerstorage.h"
+#include "../storage/atomicfile.h"
+#include "../storage/binaryformat.h"
+#include "jsontimerstorage.h"
+#include "timermanager.h"
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+
+namespace {
+
+void writeTimers(QDataStream &out, const QList<TimerData> &timers)
+{
+    out << quint32(timers.size());
+    for (const auto &t : timers) {
+        out << t.name << qint32(t.duration) << qint32(t.remaining) << t.running;
+        BinaryFormat::writeTimestamp(out, t.lastUpdated);
+        out << t.type << t.groupName << t.id;
+    }
+}
+
+bool readTimers(QDataStream &in, QList<TimerData> &timers)
+{
+    quint32 count = 0;
+    in >> count;
+    timers.clear();
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        TimerData t;
+        qint32 duration = 0;
+        qint32 remaining = 0;
+        in >> t.name >> duration >> remaining >> t.running;
+        t.duration = duration;
+        t.remaining = remaining;
+        t.lastUpdated = BinaryFormat::readTimestamp(in);
+        in >> t.type >> t.groupName >> t.id;
+        timers.append(t);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+} // namespace
+
+BinaryTimerStorage::BinaryTimerStorage(const QString &path, const QString &legacyJsonPath)
+    : path(path)
+    , legacyJsonPath(legacyJsonPath)
+{
+}
+
+void BinaryTimerStorage::setBackupEnabled(bool enabled)
+{
+    backupEnabled = enabled;
+}
+
+QString BinaryTimerStorage::resolvePath() const
+{
+    if (!path.isEmpty())
+        return path;
+
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(base);
+    return base + "/timers.bin";
+}
+
+QString BinaryTimerStorage::resolveLegacyPath() const
+{
+    if (!legacyJsonPath.isEmpty())
+        return legacyJsonPath;
+    if (!path.isEmpty())
+        return QString();
+
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return base + "/timers.json";
+}
+
+QByteArray BinaryTimerStorage::encode(const TimerSnapshot &in)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    BinaryFormat::writeHeader(out, kMagic, kVersion);
+    writeTimers(out, in.timers);
+    out << in.recommendations;
+    writeTimers(out, in.deletedTimers);
+    return data;
+}
+
+bool BinaryTimerStorage::decode(const QByteArray &data, TimerSnapshot &out)
+{
+    QDataStream in(data);
+    quint16 version = 0;
+    if (!BinaryFormat::readHeader(in, kMagic, kVersion, version))
+        return false;
+
+    TimerSnapshot snap;
+    if (!readTimers(in, snap.timers))
+        return false;
+    in >> snap.recommendations;
+    if (!readTimers(in, snap.deletedTimers))
+        return false;
+
+    out = snap;
+    return true;
+}
+
+bool BinaryTimerStorage::load(TimerSnapshot &out)
+{
+    const QString p = resolvePath();
+    QFile f(p);
+    if (f.exists()) {
+        if (!f.open(QIODevice::ReadOnly))
+            return false;
+        return decode(f.readAll(), out);
+    }
+
+    const QString legacy = resolveLegacyPath();
+    if (legacy.isEmpty() || !QFile::exists(legacy))
+        return false;
+
+    JsonTimerStorage json(legacy);
+    if (!json.load(out))
+        return false;
+    save(out);
+    return true;
+}
+
+bool BinaryTimerStorage::save(const TimerSnapshot &in)
+{
+    return AtomicFile::write(resolvePath(), encode(in), backupEnabled);
+}
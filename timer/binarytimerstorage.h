@@ -0,0 +1,110 @@
+/**
+ * @file binarytimerstorage.h
+ * @brief Declarations for binarytimerstorage.
+ * @details Defines types and functions related to binarytimerstorage.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef BINARYTIMERSTORAGE_H
+#define BINARYTIMERSTORAGE_H
+
+#include "itimerstorage.h"
+#include <QString>
+
+/**
+ * @brief BinaryTimerStorage Storage interface or implementation for persistence.
+ * @details Stores timers in a versioned QDataStream file with epoch-millisecond timestamps.
+ * @note Migrates from the JSON file written by JsonTimerStorage when no binary file exists yet.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+class BinaryTimerStorage : public ITimerStorage
+{
+public:
+    static constexpr quint32 kMagic = 0x53435449; /**< File marker "SCTI". */
+    static constexpr quint16 kVersion = 1; /**< Current format version. */
+
+/**
+ * @brief Create BinaryTimerStorage instance.
+ * @details Initializes instance state.
+ * @param path Filesystem path; defaults to timers.bin in the app data folder.
+ * @param legacyJsonPath JSON file to migrate from; defaults to timers.json next to the default path.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit BinaryTimerStorage(const QString &path = QString(), const QString &legacyJsonPath = QString());
+
+/**
+ * @brief Load snapshot from storage.
+ * @details Reads the binary file, or imports the legacy JSON file and rewrites it as binary.
+ * @param out Output snapshot to populate.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool load(TimerSnapshot &out) override;
+/**
+ * @brief Save snapshot to storage.
+ * @details Writes snapshot data to persistent storage.
+ * @param in Input snapshot.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool save(const TimerSnapshot &in) override;
+
+/**
+ * @brief Set backup enabled.
+ * @details Updates internal state and emits signals as needed.
+ * @param enabled True to keep the previous file as a rolling .bak on every save.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setBackupEnabled(bool enabled);
+
+/**
+ * @brief Encode snapshot.
+ * @details Serializes a snapshot in the current binary format.
+ * @param in Input snapshot.
+ * @return Encoded bytes.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QByteArray encode(const TimerSnapshot &in);
+/**
+ * @brief Decode snapshot.
+ * @details Parses bytes produced by encode().
+ * @param data Encoded bytes.
+ * @param out Output snapshot to populate.
+ * @return True on success; false for foreign, newer or truncated data.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static bool decode(const QByteArray &data, TimerSnapshot &out);
+
+private:
+/**
+ * @brief Resolve path.
+ * @details Performs the operation and updates state as needed.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString resolvePath() const;
+/**
+ * @brief Resolve legacy path.
+ * @details Returns the JSON file used for migration.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString resolveLegacyPath() const;
+
+    QString path; /**< Filesystem path. */
+    QString legacyJsonPath; /**< JSON file migrated on first load. */
+    bool backupEnabled = false; /**< Keep a rolling .bak of the previous file. */
+};
+
+#endif // BINARYTIMERSTORAGE_H
@@ -88,6 +88,7 @@ void HistoryTimerWindow::onRestoreSelected()
     for (int i : indexes) {
         if (i >= 0 && i < deletedTimers->size()) {
             TimerData timer = deletedTimers->takeAt(i);
+            emit historyEntryRemoved(i);
             emit restoreTimer(timer);
         }
     }
@@ -113,8 +114,10 @@ void HistoryTimerWindow::onDeleteSelected()
     std::sort(indexes.begin(), indexes.end(), std::greater<int>());
 
     for (int i : indexes) {
-        if (i >= 0 && i < deletedTimers->size())
+        if (i >= 0 && i < deletedTimers->size()) {
             deletedTimers->removeAt(i);
+            emit historyEntryRemoved(i);
+        }
     }
 
     updateTable();
@@ -155,6 +158,7 @@ void HistoryTimerWindow::updateTable()
             if (!ok || index < 0 || index >= deletedTimers->size()) return;
 
             TimerData timer = deletedTimers->takeAt(index);
+            emit historyEntryRemoved(index);
             emit restoreTimer(timer);
             updateTable();
         });
@@ -170,6 +174,7 @@ void HistoryTimerWindow::updateTable()
                 == QMessageBox::Yes)
             {
                 deletedTimers->removeAt(index);
+                emit historyEntryRemoved(index);
                 updateTable();
                 emit historyChanged();
             }
@@ -70,6 +70,14 @@ signals:
  * @sa SmartClock
  */
     void historyChanged();
+/**
+ * @brief Emitted when a history entry is removed.
+ * @details Sent after each restore or permanent delete, with the position the entry had.
+ * @param index Zero-based index before removal.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void historyEntryRemoved(int index);
 
 private slots:
 /**
@@ -9,6 +9,7 @@
  */
 
 #include "jsontimerstorage.h"
+#include "../storage/atomicfile.h"
 #include "timermanager.h"
 #include <QStandardPaths>
 #include <QDir>
@@ -22,6 +23,11 @@ JsonTimerStorage::JsonTimerStorage(const QString &path)
 {
 }
 
+void JsonTimerStorage::setBackupEnabled(bool enabled)
+{
+    backupEnabled = enabled;
+}
+
 QString JsonTimerStorage::resolvePath() const
 {
     if (!path.isEmpty())
@@ -61,6 +67,7 @@ bool JsonTimerStorage::load(TimerSnapshot &out)
         t.lastUpdated = QDateTime::fromString(o["lastUpdated"].toString(), Qt::ISODate);
         t.type        = o["type"].toString();
         t.groupName   = o["groupName"].toString();
+        t.id          = quint64(o["id"].toInteger());
         out.timers.append(t);
     }
 
@@ -99,6 +106,7 @@ bool JsonTimerStorage::save(const TimerSnapshot &in)
         o["lastUpdated"] = t.lastUpdated.toString(Qt::ISODate);
         o["type"]        = t.type;
         o["groupName"]   = t.groupName;
+        o["id"]          = qint64(t.id);
         arr.append(o);
     }
 
@@ -125,10 +133,5 @@ bool JsonTimerStorage::save(const TimerSnapshot &in)
     root["deletedTimers"] = deletedArr;
 
     QJsonDocument doc(root);
-    QFile f(p);
-    if (!f.open(QIODevice::WriteOnly))
-        return false;
-    f.write(doc.toJson(QJsonDocument::Compact));
-    f.close();
-    return true;
+    return AtomicFile::write(p, doc.toJson(QJsonDocument::Compact), backupEnabled);
 }
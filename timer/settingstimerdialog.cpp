@@ -49,7 +49,7 @@ SettingsTimerDialog::SettingsTimerDialog(TimerManager *manager, QWidget *parent)
     connect(ui->btnRemove, &QPushButton::clicked,
             this, &SettingsTimerDialog::onDeleteRecommendationClicked);
 
-    for (const TimerData &t : m_manager->getTimers()) {
+    for (const TimerData &t : m_manager->timerList()) {
         ui->comboFrom->addItem(t.name);
         ui->comboTo->addItem(t.name);
     }
@@ -0,0 +1,209 @@
+/**
+ * @file timerhistoryjournal.cpp
+ * @brief Definitions for timerhistoryjournal.
+ * @details Implements logic declared in the corresponding header for timerhistoryjournal.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "timerhistoryjournal.h"
+#include "../storage/atomicfile.h"
+#include "timermanager.h"
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+
+TimerData historyEntry(const QJsonObject &o)
+{
+    TimerData t{};
+    t.name = o["name"].toString();
+    t.duration = o["duration"].toInt();
+    t.remaining = t.duration;
+    t.status = TimerStatus::Paused;
+    t.type = o["type"].toString("Normal");
+    t.groupName = o["groupName"].toString("Default");
+    return t;
+}
+
+QByteArray addRecord(const TimerData &t)
+{
+    QJsonObject o;
+    o["op"] = "add";
+    o["name"] = t.name;
+    o["duration"] = t.duration;
+    o["type"] = t.type;
+    o["groupName"] = t.groupName;
+    return QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
+}
+
+QByteArray removeRecord(int index)
+{
+    QJsonObject o;
+    o["op"] = "remove";
+    o["index"] = index;
+    return QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
+}
+
+} // namespace
+
+TimerHistoryJournal::TimerHistoryJournal(const QString &path, const QString &legacyJsonPath)
+    : path(path)
+    , legacyJsonPath(legacyJsonPath)
+{
+}
+
+TimerHistoryJournal::~TimerHistoryJournal()
+{
+    worker.drain();
+}
+
+QString TimerHistoryJournal::resolvePath() const
+{
+    if (!path.isEmpty())
+        return path;
+
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(base);
+    return base + "/history.journal";
+}
+
+QString TimerHistoryJournal::resolveLegacyPath() const
+{
+    if (!legacyJsonPath.isEmpty())
+        return legacyJsonPath;
+    if (!path.isEmpty())
+        return QString();
+
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return base + "/history.json";
+}
+
+bool TimerHistoryJournal::load(QList<TimerData> &out)
+{
+    waitForIdle();
+
+    QFile f(resolvePath());
+    if (f.exists()) {
+        if (!f.open(QIODevice::ReadOnly))
+            return false;
+
+        QList<TimerData> entries;
+        qint64 size = 0;
+        int records = 0;
+        while (!f.atEnd()) {
+            const QByteArray line = f.readLine();
+            size += line.size();
+            ++records;
+            // A torn trailing line from a crash fails to parse and is skipped.
+            const QJsonObject o = QJsonDocument::fromJson(line).object();
+            const QString op = o["op"].toString();
+            if (op == "add") {
+                entries.append(historyEntry(o));
+            } else if (op == "remove") {
+                const int index = o["index"].toInt(-1);
+                if (index >= 0 && index < entries.size())
+                    entries.removeAt(index);
+            }
+        }
+        bytes = size;
+        compactedBytes = records == entries.size() ? size : 0;
+        out = entries;
+        maybeCompact(entries);
+        return true;
+    }
+
+    const QString legacy = resolveLegacyPath();
+    QFile lf(legacy);
+    if (legacy.isEmpty() || !lf.exists() || !lf.open(QIODevice::ReadOnly))
+        return false;
+
+    const auto doc = QJsonDocument::fromJson(lf.readAll());
+    if (!doc.isArray())
+        return false;
+
+    QList<TimerData> entries;
+    for (const auto &v : doc.array())
+        entries.append(historyEntry(v.toObject()));
+    out = entries;
+    compact(entries);
+    return true;
+}
+
+void TimerHistoryJournal::recordAdded(const QList<TimerData> &added, const QList<TimerData> &entries)
+{
+    if (added.isEmpty())
+        return;
+
+    QByteArray records;
+    for (const auto &t : added)
+        records += addRecord(t);
+    append(records);
+    maybeCompact(entries);
+}
+
+void TimerHistoryJournal::recordRemoved(int index, const QList<TimerData> &entries)
+{
+    if (index < 0)
+        return;
+    append(removeRecord(index));
+    maybeCompact(entries);
+}
+
+void TimerHistoryJournal::setCompactionThreshold(qint64 bytes)
+{
+    threshold = qMax<qint64>(0, bytes);
+}
+
+qint64 TimerHistoryJournal::journalSize() const
+{
+    return bytes.load();
+}
+
+void TimerHistoryJournal::waitForIdle()
+{
+    worker.drain();
+}
+
+void TimerHistoryJournal::append(const QByteArray &records)
+{
+    const QString p = resolvePath();
+    worker.submit([this, p, records]() {
+        QFile f(p);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Append))
+            return;
+        if (f.write(records) == records.size())
+            bytes += records.size();
+    });
+}
+
+void TimerHistoryJournal::compact(const QList<TimerData> &entries)
+{
+    compactionQueued = true;
+    const QString p = resolvePath();
+    worker.submit([this, p, entries]() {
+        QByteArray data;
+        for (const auto &t : entries)
+            data += addRecord(t);
+        if (AtomicFile::write(p, data)) {
+            bytes = data.size();
+            compactedBytes = data.size();
+        }
+        compactionQueued = false;
+    });
+}
+
+void TimerHistoryJournal::maybeCompact(const QList<TimerData> &entries)
+{
+    if (compactionQueued)
+        return;
+    const qint64 size = bytes.load();
+    if (size > threshold && size > 2 * compactedBytes.load())
+        compact(entries);
+}
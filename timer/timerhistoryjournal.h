@@ -0,0 +1,159 @@
+/**
+ * @file timerhistoryjournal.h
+ * @brief Declarations for timerhistoryjournal.
+ * @details Defines types and functions related to timerhistoryjournal.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef TIMERHISTORYJOURNAL_H
+#define TIMERHISTORYJOURNAL_H
+
+#include <QList>
+#include <QString>
+#include <atomic>
+#include "../storage/storageworker.h"
+
+/**
+ * @brief TimerData timer component.
+ * @details Implements timer-related behavior.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+struct TimerData; /**< Timer-related state. */
+
+/**
+ * @brief TimerHistoryJournal append-only store for deleted timers.
+ * @details Records each history change as one JSON line, so a change costs one small append; the file is rewritten on a worker thread once it grows past the compaction threshold.
+ * @note The caller owns the history list and passes its state after each change.
+ * @warning Call the record methods from one thread only.
+ * @sa SmartClock
+ */
+class TimerHistoryJournal
+{
+public:
+    static constexpr qint64 kDefaultCompactionThreshold = 64 * 1024; /**< Journal size in bytes that allows compaction. */
+
+/**
+ * @brief Create TimerHistoryJournal instance.
+ * @details Initializes instance state.
+ * @param path Filesystem path; defaults to history.journal in the app data folder.
+ * @param legacyJsonPath history.json to import when no journal exists; defaults next to the default path.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit TimerHistoryJournal(const QString &path = QString(), const QString &legacyJsonPath = QString());
+/**
+ * @brief Destroy TimerHistoryJournal instance.
+ * @details Waits for queued journal writes, which reference this object.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    ~TimerHistoryJournal();
+
+/**
+ * @brief Load history.
+ * @details Replays the journal; imports the legacy JSON file when no journal exists yet.
+ * @param out Output history list.
+ * @return True on success; false on failure.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool load(QList<TimerData> &out);
+/**
+ * @brief Record added timers.
+ * @details Appends one record per timer on the worker thread.
+ * @param added Timers appended to the end of the history.
+ * @param entries History after the change; used for compaction.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void recordAdded(const QList<TimerData> &added, const QList<TimerData> &entries);
+/**
+ * @brief Record removed timer.
+ * @details Appends a removal record for the given position on the worker thread.
+ * @param index Zero-based index the timer had before removal.
+ * @param entries History after the change; used for compaction.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void recordRemoved(int index, const QList<TimerData> &entries);
+
+/**
+ * @brief Set compaction threshold.
+ * @details Compaction runs once the journal exceeds this size and twice its compacted size.
+ * @param bytes Threshold in bytes.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setCompactionThreshold(qint64 bytes);
+/**
+ * @brief Journal size.
+ * @details Returns the size of the journal file after all finished writes.
+ * @return Size in bytes.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    qint64 journalSize() const;
+/**
+ * @brief Wait for idle.
+ * @details Blocks until queued appends and compactions have finished.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void waitForIdle();
+
+private:
+/**
+ * @brief Resolve path.
+ * @details Performs the operation and updates state as needed.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString resolvePath() const;
+/**
+ * @brief Resolve legacy path.
+ * @details Returns the JSON file used for migration.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString resolveLegacyPath() const;
+/**
+ * @brief Append.
+ * @details Queues raw records for the end of the journal.
+ * @param records Encoded records.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void append(const QByteArray &records);
+/**
+ * @brief Compact.
+ * @details Queues a rewrite of the journal holding only the given entries.
+ * @param entries Current history.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void compact(const QList<TimerData> &entries);
+/**
+ * @brief Maybe compact.
+ * @details Queues compaction when the journal has grown past the threshold.
+ * @param entries Current history.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void maybeCompact(const QList<TimerData> &entries);
+
+    QString path; /**< Filesystem path. */
+    QString legacyJsonPath; /**< JSON file imported on first load. */
+    qint64 threshold = kDefaultCompactionThreshold; /**< Minimum journal size before compaction. */
+    std::atomic<qint64> bytes{0}; /**< Journal size; written by the worker. */
+    std::atomic<qint64> compactedBytes{0}; /**< Size right after the last compaction. */
+    std::atomic<bool> compactionQueued{false}; /**< True until the queued compaction has run. */
+    StorageWorker &worker = StorageWorker::shared(); /**< Shared storage thread performing the journal writes, in order. */
+};
+
+#endif // TIMERHISTORYJOURNAL_H
@@ -10,16 +10,20 @@
 
 #include "timermanager.h"
 #include "jsontimerstorage.h"
+#include "binarytimerstorage.h"
 #include "itimerstorage.h"
+#include "../storage/asyncstorage.h"
+#include <QPair>
+#include <algorithm>
 #include <utility>
 
 TimerManager::TimerManager(QObject *parent, std::unique_ptr<ITimerStorage> storage)
     : QObject(parent)
-    , storage(storage ? std::move(storage) : std::make_unique<JsonTimerStorage>())
+    , storage(storage ? std::move(storage) : std::make_unique<AsyncStorage<ITimerStorage, TimerSnapshot>>(std::make_unique<BinaryTimerStorage>()))
 {
     tickTimer = new QTimer(this);
+    tickTimer->setInterval(1000);
     connect(tickTimer, &QTimer::timeout, this, &TimerManager::updateTimers);
-    tickTimer->start(1000);
 }
 
 void TimerManager::addTimer(const QString &name, int durationSeconds, const QString &type, const QString &group)
@@ -33,57 +37,107 @@ void TimerManager::addTimer(const QString &name, int durationSeconds, const QStr
     t.status = TimerStatus::Paused;
     t.type = type;
     t.groupName = group.isEmpty() ? "Default" : group;
+    t.id = nextId++;
     timers.append(t);
-    emit timersUpdated();
+    idSlots.insert(t.id, timers.size() - 1);
+    if (!nameSlots.contains(t.name))
+        nameSlots.insert(t.name, timers.size() - 1);
+    notifyChanged({});
 }
 
 void TimerManager::removeTimer(int index)
 {
-    if (index >= 0 && index < timers.size()) {
-        timers.removeAt(index);
-        emit timersUpdated();
-    }
+    removeTimers({index});
 }
 
 void TimerManager::startTimer(int index)
 {
-    if (index >= 0 && index < timers.size()) {
-        TimerData &t = timers[index];
+    startTimers({index});
+}
 
-        if (t.status == TimerStatus::Finished) {
-            t.remaining = t.duration;
-        }
+void TimerManager::pauseTimer(int index)
+{
+    pauseTimers({index});
+}
 
-        t.running = true;
-        t.status = TimerStatus::Running;
-        t.lastUpdated = QDateTime::currentDateTime();
-        emit timersUpdated();
+void TimerManager::startTimers(const QList<int> &indices)
+{
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QList<int> changed;
+    changed.reserve(indices.size());
+    for (int index : indices) {
+        if (index >= 0 && index < timers.size() && startAt(index, nowMs))
+            changed.append(index);
     }
+    if (!changed.isEmpty())
+        notifyChanged(changed);
 }
 
-void TimerManager::pauseTimer(int index)
+void TimerManager::pauseTimers(const QList<int> &indices)
 {
-    if (index >= 0 && index < timers.size()) {
-        TimerData &t = timers[index];
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QList<int> changed;
+    for (int index : indices) {
+        if (index >= 0 && index < timers.size() && pauseAt(index, nowMs))
+            changed.append(index);
+    }
+    if (changed.isEmpty())
+        return;
+    pruneSchedule();
+    notifyChanged(changed);
+}
 
-        if (!t.running || t.status == TimerStatus::Finished)
-            return;
+void TimerManager::removeTimers(const QList<int> &indices)
+{
+    QList<int> sorted;
+    sorted.reserve(indices.size());
+    for (int index : indices) {
+        if (index >= 0 && index < timers.size())
+            sorted.append(index);
+    }
+    if (sorted.isEmpty())
+        return;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // Compact in place so each survivor moves once instead of once per removal.
+    int write = sorted.first();
+    int next = 0;
+    for (int read = write; read < timers.size(); ++read) {
+        if (next < sorted.size() && sorted[next] == read) {
+            ++next;
+            continue;
+        }
+        timers[write++] = std::move(timers[read]);
+    }
+    timers.resize(write);
 
-        int elapsed = t.lastUpdated.secsTo(QDateTime::currentDateTime());
-        if (elapsed > 0)
-            t.remaining = qMax(0, t.remaining - elapsed);
+    reindex();
+    rebuildSchedule();
+    notifyChanged({});
+}
 
-        t.running = false;
-        t.status = TimerStatus::Paused;
-        t.lastUpdated = QDateTime::currentDateTime();
-        emit timersUpdated();
-    }
+void TimerManager::beginUpdate()
+{
+    ++updateDepth;
+}
+
+void TimerManager::endUpdate()
+{
+    if (updateDepth == 0 || --updateDepth > 0 || !pendingNotify)
+        return;
+    QList<int> indices = pendingStructural ? QList<int>() : pendingIndices;
+    pendingNotify = false;
+    pendingStructural = false;
+    pendingIndices.clear();
+    notifyChanged(std::move(indices));
 }
 
 void TimerManager::editTimer(int index, const QString &name, int durationSeconds, const QString &type, const QString &group)
 {
     if (index >= 0 && index < timers.size()) {
         TimerData &t = timers[index];
+        const bool renamed = t.name != name;
         t.name = name;
         t.duration = durationSeconds;
         t.remaining = durationSeconds;
@@ -91,7 +145,10 @@ void TimerManager::editTimer(int index, const QString &name, int durationSeconds
         t.running = false;
         t.status = TimerStatus::Paused;
         t.groupName = group.isEmpty() ? "Default" : group;
-        emit timersUpdated();
+        if (renamed)
+            reindex();
+        pruneSchedule();
+        notifyChanged({index});
     }
 }
 
@@ -199,54 +256,269 @@ void TimerManager::applySnapshot(const TimerSnapshot &snapshot)
         deletedTimers.append(t);
     }
 
-    emit timersUpdated();
+    reindex();
+    rebuildSchedule();
+    notifyChanged({});
 }
 
 void TimerManager::updateTimers()
 {
-    bool changed = false;
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QList<int> changed;
+    QList<QPair<quint64, QString>> finished;
+
+    while (!deadlines.empty() && deadlines.front().atMs <= nowMs) {
+        const Deadline due = deadlines.front();
+        std::pop_heap(deadlines.begin(), deadlines.end(), &TimerManager::laterDeadline);
+        deadlines.pop_back();
+        if (isStale(due))
+            continue;
+
+        TimerData &t = timers[due.index];
+        t.remaining = 0;
+        t.running = false;
+        t.status = TimerStatus::Finished;
+        t.lastUpdated = QDateTime::fromMSecsSinceEpoch(nowMs);
+        changed.append(due.index);
+        finished.append({t.id, t.name});
+    }
+
+    pruneSchedule();
+
+    // Running timers count down on every tick even when none of them is due.
+    for (const Deadline &d : deadlines) {
+        if (!isStale(d))
+            changed.append(d.index);
+    }
+    if (!changed.isEmpty())
+        notifyChanged(changed);
+
+    // Listeners may run a nested event loop (a message box) in which timers
+    // are removed, so the indices above must be published before this point.
+    for (const QPair<quint64, QString> &done : std::as_const(finished)) {
+        emit timerFinished(done.second);
+        emit timerCompleted(done.first);
+
+        const QString next = getRecommendation(done.second);
+        if (!next.isEmpty())
+            emit recommendationAvailable(next);
+    }
+}
+
+bool TimerManager::startAt(int index, qint64 nowMs)
+{
+    TimerData &t = timers[index];
+    // Restarting would round remaining up to whole seconds and push the deadline back.
+    if (t.status == TimerStatus::Running)
+        return false;
+    if (t.status == TimerStatus::Finished)
+        t.remaining = t.duration;
+
+    t.running = true;
+    t.status = TimerStatus::Running;
+    t.lastUpdated = QDateTime::fromMSecsSinceEpoch(nowMs);
+    scheduleTimer(index);
+    return true;
+}
+
+bool TimerManager::pauseAt(int index, qint64 nowMs)
+{
+    TimerData &t = timers[index];
+    if (!t.running || t.status == TimerStatus::Finished)
+        return false;
+
+    t.remaining = remainingAt(t, nowMs);
+    t.running = false;
+    t.status = TimerStatus::Paused;
+    t.lastUpdated = QDateTime::fromMSecsSinceEpoch(nowMs);
+    return true;
+}
+
+void TimerManager::notifyChanged(QList<int> indices)
+{
+    if (updateDepth > 0) {
+        pendingNotify = true;
+        if (indices.isEmpty())
+            pendingStructural = true;
+        else if (!pendingStructural)
+            pendingIndices += indices;
+        return;
+    }
 
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    emit timersChanged(indices);
+    emit timersUpdated();
+}
+
+void TimerManager::reindex()
+{
+    for (const TimerData &t : timers)
+        nextId = qMax(nextId, t.id + 1);
+
+    idSlots.clear();
+    nameSlots.clear();
+    idSlots.reserve(timers.size());
+    nameSlots.reserve(timers.size());
     for (int i = 0; i < timers.size(); ++i) {
         TimerData &t = timers[i];
+        if (t.id == 0 || idSlots.contains(t.id))
+            t.id = nextId++;
+        idSlots.insert(t.id, i);
+        if (!nameSlots.contains(t.name))
+            nameSlots.insert(t.name, i);
+    }
+}
 
-        if (t.running && t.status == TimerStatus::Running) {
-            int elapsed = t.lastUpdated.secsTo(QDateTime::currentDateTime());
-            if (elapsed > 0) {
-                t.remaining = qMax(0, t.remaining - elapsed);
-                t.lastUpdated = QDateTime::currentDateTime();
-                changed = true;
-            }
+qint64 TimerManager::deadlineOf(const TimerData &t)
+{
+    return t.lastUpdated.toMSecsSinceEpoch() + qint64(t.remaining) * 1000;
+}
 
-            if (t.remaining <= 0) {
-                t.remaining = 0;
-                t.running = false;
-                t.status = TimerStatus::Finished;
-                emit timerFinished(t.name);
+int TimerManager::remainingAt(const TimerData &t, qint64 nowMs)
+{
+    if (!t.running || t.status != TimerStatus::Running)
+        return t.remaining;
+    const qint64 leftMs = deadlineOf(t) - nowMs;
+    if (leftMs <= 0)
+        return 0;
+    return int((leftMs + 999) / 1000);
+}
+
+bool TimerManager::laterDeadline(const Deadline &a, const Deadline &b)
+{
+    if (a.atMs != b.atMs)
+        return a.atMs > b.atMs;
+    return a.index > b.index;
+}
 
-                QString next = getRecommendation(t.name);
-                if (!next.isEmpty())
-                    emit recommendationAvailable(next);
+bool TimerManager::isStale(const Deadline &d) const
+{
+    if (d.index < 0 || d.index >= timers.size())
+        return true;
+    const TimerData &t = timers[d.index];
+    return !t.running || t.status != TimerStatus::Running || deadlineOf(t) != d.atMs;
+}
 
-                changed = true;
-            }
-        }
+void TimerManager::scheduleTimer(int index)
+{
+    deadlines.push_back(Deadline{deadlineOf(timers[index]), index});
+    std::push_heap(deadlines.begin(), deadlines.end(), &TimerManager::laterDeadline);
+    pruneSchedule();
+    if (!deadlines.empty() && !tickTimer->isActive())
+        tickTimer->start();
+}
+
+void TimerManager::rebuildSchedule()
+{
+    deadlines.clear();
+    for (int i = 0; i < timers.size(); ++i) {
+        const TimerData &t = timers[i];
+        if (t.running && t.status == TimerStatus::Running)
+            deadlines.push_back(Deadline{deadlineOf(t), i});
+    }
+    std::make_heap(deadlines.begin(), deadlines.end(), &TimerManager::laterDeadline);
+
+    if (deadlines.empty())
+        tickTimer->stop();
+    else if (!tickTimer->isActive())
+        tickTimer->start();
+}
+
+void TimerManager::pruneSchedule()
+{
+    // Paused and restarted timers leave dead entries behind; compact once they dominate.
+    if (deadlines.size() > size_t(2 * timers.size() + 16)) {
+        rebuildSchedule();
+        return;
+    }
+
+    while (!deadlines.empty() && isStale(deadlines.front())) {
+        std::pop_heap(deadlines.begin(), deadlines.end(), &TimerManager::laterDeadline);
+        deadlines.pop_back();
     }
 
-    if (changed)
-        emit timersUpdated();
+    if (deadlines.empty())
+        tickTimer->stop();
+}
+
+TimerData TimerManager::withRemaining(const TimerData &t, qint64 nowMs)
+{
+    TimerData copy = t;
+    copy.remaining = remainingAt(t, nowMs);
+    return copy;
 }
 
 QList<TimerData> TimerManager::getTimers() const
+{
+    if (deadlines.empty())
+        return timers;
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QList<TimerData> result;
+    result.reserve(timers.size());
+    for (const TimerData &t : timers)
+        result.append(withRemaining(t, nowMs));
+    return result;
+}
+
+const QList<TimerData> &TimerManager::timerList() const
 {
     return timers;
 }
 
+int TimerManager::timerCount() const
+{
+    return timers.size();
+}
+
+const TimerData &TimerManager::timerAt(int index) const
+{
+    return timers[index];
+}
+
+int TimerManager::remainingSeconds(int index, qint64 nowMs) const
+{
+    if (index < 0 || index >= timers.size())
+        return 0;
+    return remainingAt(timers[index], nowMs);
+}
+
+int TimerManager::countByStatus(TimerStatus status) const
+{
+    return int(std::count_if(timers.cbegin(), timers.cend(),
+                             [status](const TimerData &t) { return t.status == status; }));
+}
+
+int TimerManager::indexOfId(quint64 id) const
+{
+    return idSlots.value(id, -1);
+}
+
+QList<int> TimerManager::indicesOfIds(const QList<quint64> &ids) const
+{
+    QList<int> indices;
+    indices.reserve(ids.size());
+    for (quint64 id : ids) {
+        const int index = indexOfId(id);
+        if (index >= 0)
+            indices.append(index);
+    }
+    return indices;
+}
+
+int TimerManager::findByName(const QString &name) const
+{
+    return nameSlots.value(name, -1);
+}
+
 QList<TimerData> TimerManager::getFilteredTimers(const QString &filterType) const
 {
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
     QList<TimerData> result;
     for (const TimerData &t : timers) {
-        if (filterType == "All timers") result.append(t);
-        else if (filterType == "Running" && t.status == TimerStatus::Running) result.append(t);
+        if (filterType == "All timers") result.append(withRemaining(t, nowMs));
+        else if (filterType == "Running" && t.status == TimerStatus::Running) result.append(withRemaining(t, nowMs));
         else if (filterType == "Paused" && t.status == TimerStatus::Paused) result.append(t);
         else if (filterType == "Finished" && t.status == TimerStatus::Finished) result.append(t);
     }
@@ -255,53 +527,40 @@ QList<TimerData> TimerManager::getFilteredTimers(const QString &filterType) cons
 
 QList<TimerData> TimerManager::getGroupTimers(const QString &groupName) const
 {
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
     QList<TimerData> result;
     for (const TimerData &t : timers) {
         if (t.groupName == groupName)
-            result.append(t);
+            result.append(withRemaining(t, nowMs));
     }
     return result;
 }
 
 void TimerManager::startGroup(const QString &groupName)
 {
+    QList<int> indices;
     for (int i = 0; i < timers.size(); ++i) {
-        if (timers[i].groupName == groupName) {
-            startTimer(i);
-        }
+        if (timers[i].groupName == groupName)
+            indices.append(i);
     }
+    startTimers(indices);
 }
 
 TimerData TimerManager::getNextTimer() const
 {
-    TimerData nextTimer;
-    int minRemaining = INT_MAX;
-    bool found = false;
-
-    for (const auto &timer : timers) {
-        if (timer.running && timer.remaining > 0) {
-            if (timer.remaining < minRemaining) {
-                minRemaining = timer.remaining;
-                nextTimer = timer;
-                found = true;
-            }
-        }
-    }
-
-    if (!found) {
+    if (deadlines.empty()) {
+        TimerData nextTimer;
         nextTimer.name = "";
         nextTimer.remaining = 0;
+        return nextTimer;
     }
 
-    return nextTimer;
+    return withRemaining(timers[deadlines.front().index], QDateTime::currentMSecsSinceEpoch());
 }
 
 bool TimerManager::hasTimer(const QString &name) const
 {
-    for (const auto &t : timers)
-        if (t.name == name)
-            return true;
-    return false;
+    return findByName(name) >= 0;
 }
 
 void TimerManager::addDeletedTimer(const TimerData &t)
@@ -16,7 +16,9 @@
 #include <QList>
 #include <QDateTime>
 #include <QMap>
+#include <QHash>
 #include <memory>
+#include <vector>
 #include "itimerstorage.h"
 
 /**
@@ -42,12 +44,13 @@ enum class TimerStatus {
 struct TimerData {
     QString name; /**< Internal state value. */
     int duration; /**< Internal state value. */
-    int remaining; /**< Internal state value. */
+    int remaining; /**< Seconds left as of lastUpdated. */
     bool running; /**< Current state flag. */
     QDateTime lastUpdated; /**< Internal state value. */
     TimerStatus status; /**< Internal state value. */
     QString type; /**< Internal state value. */
     QString groupName; /**< Internal state value. */
+    quint64 id = 0; /**< Stable identifier assigned by TimerManager and persisted with the timer; 0 until added. */
 };
 
 /**
@@ -107,6 +110,77 @@ public:
  * @sa SmartClock
  */
     void pauseTimer(int index);
+/**
+ * @brief Start timers.
+ * @details Starts every listed timer against one clock reading and emits a single change notification.
+ * @param indices Zero-based indices; invalid ones are skipped.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void startTimers(const QList<int> &indices);
+/**
+ * @brief Pause timers.
+ * @details Pauses every listed running timer and emits a single change notification.
+ * @param indices Zero-based indices; invalid, paused and finished ones are skipped.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void pauseTimers(const QList<int> &indices);
+/**
+ * @brief Remove timers.
+ * @details Removes every listed timer in one pass, rebuilds the schedule once and emits a single change notification.
+ * @param indices Zero-based indices in current numbering; invalid and duplicate ones are skipped.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void removeTimers(const QList<int> &indices);
+/**
+ * @brief Begin update.
+ * @details Opens a batch; change notifications are held until the matching endUpdate(). Batches nest.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void beginUpdate();
+/**
+ * @brief End update.
+ * @details Closes a batch; the outermost call emits one coalesced notification if anything changed.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void endUpdate();
+
+/**
+ * @brief UpdateScope RAII batch guard.
+ * @details Calls beginUpdate() on construction and endUpdate() on destruction.
+ * @note Public API is documented per member.
+ * @warning The manager must outlive the scope.
+ * @sa SmartClock
+ */
+    class UpdateScope
+    {
+    public:
+/**
+ * @brief Create UpdateScope instance.
+ * @details Opens a batch on the manager.
+ * @param manager Manager to batch.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+        explicit UpdateScope(TimerManager *manager) : manager(manager) { manager->beginUpdate(); }
+/**
+ * @brief Destroy UpdateScope instance.
+ * @details Closes the batch.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+        ~UpdateScope() { manager->endUpdate(); }
+        UpdateScope(const UpdateScope&) = delete;
+        UpdateScope& operator=(const UpdateScope&) = delete;
+
+    private:
+        TimerManager *manager; /**< Batched manager. */
+    };
+
 /**
  * @brief Edit timer.
  * @details Performs the operation and updates state as needed.
@@ -127,6 +201,77 @@ public:
  * @sa SmartClock
  */
     QList<TimerData> getTimers() const;
+/**
+ * @brief Timer list.
+ * @details Returns the stored timers without copying; for running timers remaining is as of lastUpdated, see remainingSeconds().
+ * @return Const reference valid until the next modification.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    const QList<TimerData> &timerList() const;
+/**
+ * @brief Timer count.
+ * @details Returns the number of timers.
+ * @return Count value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int timerCount() const;
+/**
+ * @brief Timer at.
+ * @details Returns one stored timer without copying.
+ * @param index Zero-based index; must be valid.
+ * @return Const reference valid until the next modification.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    const TimerData &timerAt(int index) const;
+/**
+ * @brief Remaining seconds.
+ * @details Returns the live remaining time of one timer at the given moment.
+ * @param index Zero-based index.
+ * @param nowMs Current time in milliseconds since epoch.
+ * @return Seconds left, or 0 when out of range.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int remainingSeconds(int index, qint64 nowMs) const;
+/**
+ * @brief Count by status.
+ * @details Counts timers in the given status without allocating.
+ * @param status Timer status.
+ * @return Count value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int countByStatus(TimerStatus status) const;
+/**
+ * @brief Index of id.
+ * @details Maps a stable timer id to its current slot through a hash index.
+ * @param id Timer id.
+ * @return Zero-based index, or -1 if no timer has this id.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int indexOfId(quint64 id) const;
+/**
+ * @brief Indices of ids.
+ * @details Maps stable ids to current slots, dropping unknown ids.
+ * @param ids Timer ids.
+ * @return List of values.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QList<int> indicesOfIds(const QList<quint64> &ids) const;
+/**
+ * @brief Find by name.
+ * @details Returns the index of the first timer with the given name through a hash index.
+ * @param name Name string.
+ * @return Zero-based index, or -1 if none matches.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int findByName(const QString &name) const;
 /**
  * @brief Save to file.
  * @details Writes current state to persistent storage.
@@ -243,7 +388,7 @@ public:
 
 /**
  * @brief Get next timer.
- * @details Returns the current value derived from internal state.
+ * @details Returns the running timer with the earliest deadline in O(1).
  * @return Return value of the operation.
  * @note Validate inputs where applicable.
  * @sa SmartClock
@@ -301,6 +446,14 @@ signals:
  * @sa SmartClock
  */
     void timersUpdated();
+/**
+ * @brief Timers changed.
+ * @details Emitted once per operation or batch, right before timersUpdated().
+ * @param indices Sorted indices of timers whose state changed; empty when timers were added, removed or replaced.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void timersChanged(const QList<int> &indices);
 /**
  * @brief Timer finished.
  * @details Performs the operation and updates state as needed.
@@ -309,6 +462,14 @@ signals:
  * @sa SmartClock
  */
     void timerFinished(const QString &name);
+/**
+ * @brief Timer completed.
+ * @details Emitted right after timerFinished() with the stable id of the same timer, so listeners can tell timers with equal names apart.
+ * @param id Stable timer id.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void timerCompleted(quint64 id);
 /**
  * @brief Recommendation available.
  * @details Performs the operation and updates state as needed.
@@ -321,7 +482,7 @@ signals:
 private slots:
 /**
  * @brief Update timers.
- * @details Performs the operation and updates state as needed.
+ * @details Finishes due timers and notifies timersChanged before emitting timerFinished, timerCompleted and recommendationAvailable, whose listeners may re-enter the manager.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
@@ -337,14 +498,143 @@ private:
  */
     void applySnapshot(const struct TimerSnapshot &snapshot);
 
+/**
+ * @brief Start at.
+ * @details Starts one paused or finished timer without notifying listeners; a running timer keeps its deadline.
+ * @param index Zero-based index; must be valid.
+ * @param nowMs Current time in milliseconds since epoch.
+ * @return True if the timer was not already running.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool startAt(int index, qint64 nowMs);
+/**
+ * @brief Pause at.
+ * @details Pauses one timer without notifying listeners.
+ * @param index Zero-based index; must be valid.
+ * @param nowMs Current time in milliseconds since epoch.
+ * @return True if the timer was running.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool pauseAt(int index, qint64 nowMs);
+/**
+ * @brief Notify changed.
+ * @details Emits timersChanged and timersUpdated, or folds the indices into the open batch.
+ * @param indices Changed indices; empty means a structural change.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void notifyChanged(QList<int> indices);
+
+/**
+ * @brief Reindex.
+ * @details Assigns ids to timers that have none and rebuilds the id and name indexes after slots shift.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void reindex();
+
+/**
+ * @brief Deadline heap entry.
+ * @details Absolute expiry of a running timer and its slot in the timers list.
+ * @note Entries are invalidated lazily; see isStale().
+ * @sa SmartClock
+ */
+    struct Deadline {
+        qint64 atMs; /**< Expiry time (milliseconds since epoch). */
+        int index; /**< Zero-based index into timers. */
+    };
+
+/**
+ * @brief Deadline of.
+ * @details Computes the absolute expiry of a running timer from its last update stamp.
+ * @param t t value.
+ * @return Expiry time in milliseconds since epoch.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static qint64 deadlineOf(const TimerData &t);
+/**
+ * @brief Remaining at.
+ * @details Returns whole seconds left at the given moment; paused timers return their stored value.
+ * @param t t value.
+ * @param nowMs Current time in milliseconds since epoch.
+ * @return Integer value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static int remainingAt(const TimerData &t, qint64 nowMs);
+/**
+ * @brief Later deadline.
+ * @details Heap comparator that keeps the earliest deadline on top.
+ * @param a a value.
+ * @param b b value.
+ * @return True if a expires after b.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static bool laterDeadline(const Deadline &a, const Deadline &b);
+/**
+ * @brief Check whether stale.
+ * @details A heap entry is stale once its timer was paused, edited, finished or rescheduled.
+ * @param d d value.
+ * @return True if the condition holds; false otherwise.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isStale(const Deadline &d) const;
+/**
+ * @brief Schedule timer.
+ * @details Pushes the running timer's deadline onto the heap and arms the tick.
+ * @param index Zero-based index.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void scheduleTimer(int index);
+/**
+ * @brief Rebuild schedule.
+ * @details Recreates the deadline heap from running timers after indices shift.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void rebuildSchedule();
+/**
+ * @brief Prune schedule.
+ * @details Drops stale entries from the top of the heap and stops the tick when idle.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void pruneSchedule();
+/**
+ * @brief With remaining.
+ * @details Returns a copy of the timer with remaining refreshed for the given moment.
+ * @param t t value.
+ * @param nowMs Current time in milliseconds since epoch.
+ * @return Return value of the operation.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static TimerData withRemaining(const TimerData &t, qint64 nowMs);
+
     QList<TimerData> timers; /**< Timer-related state. */
     QTimer *tickTimer;
+    std::vector<Deadline> deadlines; /**< Min-heap of running timer deadlines. */
 
     QMap<QString, QString> recommendations;
 
     QList<TimerData> deletedTimers; /**< Timer-related state. */
     std::unique_ptr<ITimerStorage> storage; /**< Owned storage backend. */
 
+    quint64 nextId = 1; /**< Next id handed out to a new timer. */
+    QHash<quint64, int> idSlots; /**< Timer id to index in timers. */
+    QHash<QString, int> nameSlots; /**< Timer name to index of its first occurrence. */
+
+    int updateDepth = 0; /**< Nesting level of open batches. */
+    bool pendingNotify = false; /**< True if a batch holds an unsent notification. */
+    bool pendingStructural = false; /**< True if the held notification covers all timers. */
+    QList<int> pendingIndices; /**< Indices changed inside the open batch. */
+
 };
 
 #endif // TIMERMANAGER_H
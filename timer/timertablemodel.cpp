@@ -0,0 +1,273 @@
+/**
+ * @file timertablemodel.cpp
+ * @brief Definitions for timertablemodel.
+ * @details Implements logic declared in the corresponding header for timertablemodel.
+ * @note Keep implementation and header documentation consistent.
+ * @warning Update documentation when behavior changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+
+#include "timertablemodel.h"
+#include <QBrush>
+#include <QColor>
+
+TimerTableModel::TimerTableModel(TimerManager *manager, QObject *parent)
+    : QAbstractTableModel(parent)
+    , manager(manager)
+{
+    rows = buildRows();
+    reindexRows();
+    connect(manager, &TimerManager::timersChanged, this, &TimerTableModel::onTimersChanged);
+}
+
+int TimerTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+int TimerTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant TimerTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size())
+        return {};
+
+    const Row &r = rows[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case NameColumn:
+            return r.name;
+        case RemainingColumn:
+            return QString("%1:%2:%3")
+                .arg(r.remaining / 3600, 2, 10, QChar('0'))
+                .arg((r.remaining % 3600) / 60, 2, 10, QChar('0'))
+                .arg(r.remaining % 60, 2, 10, QChar('0'));
+        case StatusColumn:
+            return statusText(r.status);
+        case TypeColumn:
+            return r.type;
+        }
+        break;
+    case Qt::BackgroundRole:
+        if (r.status == TimerStatus::Finished && index.column() != TypeColumn)
+            return QBrush(QColor(220, 220, 220));
+        break;
+    case Qt::ForegroundRole:
+        if (r.status == TimerStatus::Finished && index.column() != TypeColumn)
+            return QBrush(Qt::darkGray);
+        break;
+    }
+    return {};
+}
+
+QVariant TimerTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+    case NameColumn:
+        return QString("Name");
+    case RemainingColumn:
+        return QString("Remaining");
+    case StatusColumn:
+        return QString("Status");
+    case TypeColumn:
+        return QString("Type");
+    }
+    return {};
+}
+
+void TimerTableModel::setStatusFilter(const QString &filter)
+{
+    const QString value = filter.isEmpty() ? QString("All timers") : filter;
+    if (value == this->filter)
+        return;
+
+    beginResetModel();
+    this->filter = value;
+    rows = buildRows();
+    reindexRows();
+    endResetModel();
+}
+
+QString TimerTableModel::statusFilter() const
+{
+    return filter;
+}
+
+int TimerTableModel::timerIndex(int row) const
+{
+    return row >= 0 && row < rows.size() ? manager->indexOfId(rows[row].timerId) : -1;
+}
+
+void TimerTableModel::setPaused(bool value)
+{
+    paused = value;
+    if (!paused && stale)
+        refresh();
+}
+
+bool TimerTableModel::isPaused() const
+{
+    return paused;
+}
+
+void TimerTableModel::onTimersChanged(const QList<int> &indices)
+{
+    if (paused) {
+        stale = true;
+        return;
+    }
+    if (indices.isEmpty())
+        refresh();
+    else
+        updateRows(indices);
+}
+
+void TimerTableModel::updateRows(const QList<int> &indices)
+{
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const bool all = filter == "All timers";
+
+    int first = -1;
+    int last = -1;
+    auto flush = [&]() {
+        if (first >= 0)
+            emit dataChanged(index(first, 0), index(last, ColumnCount - 1));
+        first = last = -1;
+    };
+
+    for (int i : indices) {
+        if (i < 0 || i >= manager->timerCount())
+            continue;
+        const TimerData &t = manager->timerAt(i);
+        const int row = rowSlots.value(t.id, -1);
+        if ((row >= 0) != (all || statusText(t.status) == filter)) {
+            // The timer entered or left the filter; let refresh() move the rows.
+            flush();
+            refresh();
+            return;
+        }
+        if (row < 0)
+            continue;
+
+        const Row next = rowFor(i, nowMs);
+        Row &r = rows[row];
+        if (r.remaining == next.remaining && r.status == next.status && r.name == next.name && r.type == next.type)
+            continue;
+        r = next;
+        if (first >= 0 && row == last + 1) {
+            last = row;
+        } else {
+            flush();
+            first = last = row;
+        }
+    }
+    flush();
+}
+
+void TimerTableModel::refresh()
+{
+    stale = false;
+    QList<Row> next = buildRows();
+
+    // Rows keep their identity as long as the existing ones map to the same timers;
+    // anything else (removal, filter change of a row) falls back to a reset.
+    const int common = qMin(rows.size(), next.size());
+    bool sameRows = next.size() >= rows.size();
+    for (int i = 0; sameRows && i < common; ++i)
+        sameRows = rows[i].timerId == next[i].timerId;
+
+    if (!sameRows) {
+        beginResetModel();
+        rows = next;
+        reindexRows();
+        endResetModel();
+        return;
+    }
+
+    int first = -1;
+    int last = -1;
+    auto flush = [&]() {
+        if (first >= 0)
+            emit dataChanged(index(first, 0), index(last, ColumnCount - 1));
+        first = last = -1;
+    };
+
+    for (int i = 0; i < common; ++i) {
+        const Row &a = rows[i];
+        const Row &b = next[i];
+        const bool changed = a.remaining != b.remaining || a.status != b.status
+                             || a.name != b.name || a.type != b.type;
+        if (changed) {
+            rows[i] = b;
+            if (first < 0)
+                first = i;
+            last = i;
+        } else {
+            flush();
+        }
+    }
+    flush();
+
+    if (next.size() > common) {
+        beginInsertRows(QModelIndex(), common, next.size() - 1);
+        rows.append(next.mid(common));
+        reindexRows();
+        endInsertRows();
+    }
+}
+
+QList<TimerTableModel::Row> TimerTableModel::buildRows() const
+{
+    const QList<TimerData> &timers = manager->timerList();
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const bool all = filter == "All timers";
+
+    QList<Row> out;
+    out.reserve(timers.size());
+    for (int i = 0; i < timers.size(); ++i) {
+        if (all || statusText(timers[i].status) == filter)
+            out.append(rowFor(i, nowMs));
+    }
+    return out;
+}
+
+TimerTableModel::Row TimerTableModel::rowFor(int index, qint64 nowMs) const
+{
+    const TimerData &t = manager->timerAt(index);
+    Row r;
+    r.timerId = t.id;
+    r.name = t.name;
+    r.remaining = manager->remainingSeconds(index, nowMs);
+    r.status = t.status;
+    r.type = t.type;
+    return r;
+}
+
+void TimerTableModel::reindexRows()
+{
+    rowSlots.clear();
+    rowSlots.reserve(rows.size());
+    for (int i = 0; i < rows.size(); ++i)
+        rowSlots.insert(rows[i].timerId, i);
+}
+
+QString TimerTableModel::statusText(TimerStatus status)
+{
+    switch (status) {
+    case TimerStatus::Running:
+        return "Running";
+    case TimerStatus::Paused:
+        return "Paused";
+    case TimerStatus::Finished:
+        return "Finished";
+    }
+    return QString();
+}
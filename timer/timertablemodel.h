@@ -0,0 +1,222 @@
+/**
+ * @file timertablemodel.h
+ * @brief Declarations for timertablemodel.
+ * @details Defines types and functions related to timertablemodel.
+ * @note Keep this file in sync with related declarations/definitions.
+ * @warning Update documentation when API changes.
+ * @sa SmartClock
+ * @date 2026-02-26
+ */
+#ifndef TIMERTABLEMODEL_H
+#define TIMERTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QList>
+#include "timermanager.h"
+
+/**
+ * @brief TimerTableModel table model over TimerManager.
+ * @details Presents timers as rows (name, remaining, status, type) and reports only the cells that changed between refreshes.
+ * @note Public API is documented per member.
+ * @warning The manager must outlive the model.
+ * @sa SmartClock
+ */
+class TimerTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+/**
+ * @brief Column type.
+ * @details Holds data and behavior specific to Column.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+    enum Column {
+        NameColumn, ///< Enum value: timer name.
+        RemainingColumn, ///< Enum value: remaining time.
+        StatusColumn, ///< Enum value: status text.
+        TypeColumn, ///< Enum value: timer type.
+        ColumnCount ///< Number of columns.
+    };
+
+/**
+ * @brief Create TimerTableModel instance.
+ * @details Initializes instance state and follows TimerManager::timersChanged.
+ * @param manager Timer manager to present.
+ * @param parent Parent QObject.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    explicit TimerTableModel(TimerManager *manager, QObject *parent = nullptr);
+
+/**
+ * @brief Row count.
+ * @details Returns the number of visible timers.
+ * @param parent Parent index.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+/**
+ * @brief Column count.
+ * @details Returns the number of columns.
+ * @param parent Parent index.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+/**
+ * @brief Data.
+ * @details Returns display text and finished-row colors.
+ * @param index Cell index.
+ * @param role Data role.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+/**
+ * @brief Header data.
+ * @details Returns column titles.
+ * @param section Column or row number.
+ * @param orientation Header orientation.
+ * @param role Data role.
+ * @return Result value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+/**
+ * @brief Set status filter.
+ * @details Shows only timers with the given status text; "All timers" shows everything.
+ * @param filter Status text.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setStatusFilter(const QString &filter);
+/**
+ * @brief Status filter.
+ * @details Returns the active status filter.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QString statusFilter() const;
+/**
+ * @brief Timer index.
+ * @details Maps a visible row to the timer's current index in TimerManager through its stable id, so the answer stays right while the rows are stale.
+ * @param row Zero-based row.
+ * @return Timer index, or -1 when out of range or the timer is gone.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    int timerIndex(int row) const;
+/**
+ * @brief Set paused.
+ * @details While paused, timersChanged only marks the rows stale; unpausing refreshes once if anything changed.
+ * @param paused True to stop following the manager.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void setPaused(bool paused);
+/**
+ * @brief Is paused.
+ * @details Returns the current value derived from internal state.
+ * @return True if automatic refreshes are paused.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    bool isPaused() const;
+
+public slots:
+/**
+ * @brief Refresh.
+ * @details Re-reads the manager; emits dataChanged for changed rows only and resets only when rows were removed or reordered.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void refresh();
+
+private slots:
+/**
+ * @brief On timers changed.
+ * @details Updates only the rows of the given timers; an empty list (timers added, removed or replaced) re-reads every row through refresh(). Marks the rows stale while paused.
+ * @param indices Sorted indices of the timers that changed.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void onTimersChanged(const QList<int> &indices);
+
+private:
+/**
+ * @brief Row type.
+ * @details Cached display state of one visible timer.
+ * @note Public API is documented per member.
+ * @warning Respect ownership and lifetime rules.
+ * @sa SmartClock
+ */
+    struct Row {
+        quint64 timerId = 0; /**< Stable id in TimerManager. */
+        QString name; /**< Timer name. */
+        int remaining = 0; /**< Seconds left. */
+        TimerStatus status = TimerStatus::Paused; /**< Timer status. */
+        QString type; /**< Timer type. */
+    };
+
+/**
+ * @brief Build rows.
+ * @details Reads the manager and applies the status filter.
+ * @return Visible rows.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    QList<Row> buildRows() const;
+/**
+ * @brief Row for.
+ * @details Reads one timer into a row.
+ * @param index Timer index in the manager; must be valid.
+ * @param nowMs Current time in milliseconds since epoch.
+ * @return Row for the timer.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    Row rowFor(int index, qint64 nowMs) const;
+/**
+ * @brief Update rows.
+ * @details Re-reads the given timers and emits dataChanged for the rows that differ; falls back to refresh() when a timer enters or leaves the filter.
+ * @param indices Sorted timer indices.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void updateRows(const QList<int> &indices);
+/**
+ * @brief Reindex rows.
+ * @details Rebuilds the timer id to row lookup after rows were replaced, inserted or removed.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void reindexRows();
+/**
+ * @brief Status text.
+ * @details Formats a status for display and filtering.
+ * @param status Timer status.
+ * @return Formatted string value.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    static QString statusText(TimerStatus status);
+
+    TimerManager *manager; /**< Source of timer data. */
+    QList<Row> rows; /**< Rows currently shown. */
+    QHash<quint64, int> rowSlots; /**< Timer id to row in rows. */
+    QString filter = "All timers"; /**< Active status filter. */
+    bool paused = false; /**< True while automatic refreshes are paused. */
+    bool stale = false; /**< True if the manager changed while paused. */
+};
+
+#endif // TIMERTABLEMODEL_H
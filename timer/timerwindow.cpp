@@ -14,6 +14,7 @@
 #include "settingstimerdialog.h"
 #include "historytimerwindow.h"
 #include "../mainwindow.h"
+#include "../activitymanager.h"
 
 #include <QMessageBox>
 #include <QInputDialog>
@@ -23,16 +24,12 @@
 #include <QFileDialog>
 #include <QDesktopServices>
 #include <QUrl>
-#include <QDir>
-#include <QStandardPaths>
 #include <QCoreApplication>
 #include <algorithm>
 #include <QCloseEvent>
-#include <QJsonDocument>
-#include <QJsonArray>
-#include <QJsonObject>
 #include <QSettings>
 #include <QShortcut>
+#include <QHeaderView>
 
 #ifdef Q_OS_WIN
 #define NOMINMAX
@@ -67,15 +64,15 @@ TimerWindow::TimerWindow(QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::TimerWindow)
     , manager(new TimerManager(this))
+    , tableModel(new TimerTableModel(manager, this))
 {
     ui->setupUi(this);
 
     setWindowTitle("Timer");
 
-    ui->tableTimers->setColumnCount(4);
+    ui->tableTimers->setModel(tableModel);
+    ui->tableTimers->verticalHeader()->setVisible(false);
     ui->tableTimers->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-
-    ui->tableTimers->setHorizontalHeaderLabels({"Name", "Remaining", "Status", "Type"});
     ui->tableTimers->setShowGrid(false);
 
     ui->tableTimers->horizontalHeader()->setStretchLastSection(true);
@@ -89,8 +86,9 @@ TimerWindow::TimerWindow(QWidget *parent)
     connect(ui->btnHistory, &QPushButton::clicked, this, &TimerWindow::onHistory);
     connect(ui->btnStartPause, &QPushButton::clicked, this, &TimerWindow::onStartPauseTimer);
     connect(ui->btnDelete, &QPushButton::clicked, this, &TimerWindow::onDeleteTimer);
-    connect(manager, &TimerManager::timersUpdated, this, &TimerWindow::updateTable);
-    connect(ui->tableTimers, &QTableWidget::itemDoubleClicked, this, &TimerWindow::onEditTimer);
+    connect(manager, &TimerManager::timersUpdated, this, &TimerWindow::onTimersUpdated);
+    connect(manager, &TimerManager::timersChanged, this, &TimerWindow::onTimersChanged);
+    connect(ui->tableTimers, &QTableView::doubleClicked, this, &TimerWindow::onEditTimer);
 
     auto delShortcut = new QShortcut(QKeySequence(Qt::Key_Delete), this);
     connect(delShortcut, &QShortcut::activated, this, &TimerWindow::onDeleteTimer);
@@ -105,13 +103,8 @@ TimerWindow::TimerWindow(QWidget *parent)
         QString melody = settings.value("melodySoundPath").toString();
         QString reminder = settings.value("reminderSoundPath").toString();
 
-        QString type = "Normal";
-        for (const auto &t : manager->getTimers()) {
-            if (t.name == name) {
-                type = t.type;
-                break;
-            }
-        }
+        const int index = manager->findByName(name);
+        const QString type = index >= 0 ? manager->timerAt(index).type : QString("Normal");
 
         if (soundEnabled) {
             QString soundPath = "qrc:/s/resources/sounds/soundtimer.wav";
@@ -154,19 +147,16 @@ TimerWindow::TimerWindow(QWidget *parent)
         msgBox.exec();
 
         if (msgBox.clickedButton() == startBtn) {
-            auto timers = manager->getTimers();
-            for (int i = 0; i < timers.size(); ++i) {
-                if (timers[i].name == nextName) {
-                    manager->startTimer(i);
-                    QMessageBox::information(this, "Started", QString("Timer '%1' started.").arg(nextName));
-                    break;
-                }
+            const int index = manager->findByName(nextName);
+            if (index >= 0) {
+                manager->startTimer(index);
+                QMessageBox::information(this, "Started", QString("Timer '%1' started.").arg(nextName));
             }
         }
     });
 
     controller = new TimerController(manager, this, this);
-    loadHistoryJson();
+    historyJournal.load(deletedTimers);
 
     QSettings settings("SmartTimerApp", "SmartTimer");
 
@@ -186,8 +176,10 @@ TimerWindow::TimerWindow(QWidget *parent)
         }
     });
 
-    connect(manager, &TimerManager::timersUpdated, this, &TimerWindow::updateNextUpLabel);
-
+    ActivityManager &activity = ActivityManager::instance();
+    activity.watch(this);
+    connect(&activity, &ActivityManager::activeChanged, this, &TimerWindow::onActiveChanged);
+    tableModel->setPaused(!activity.isActive(this));
 }
 
 TimerWindow::~TimerWindow()
@@ -239,16 +231,15 @@ void TimerWindow::onHistory()
 {
     HistoryTimerWindow dialog(&deletedTimers, this);
 
+    connect(&dialog, &HistoryTimerWindow::historyEntryRemoved, this, [this](int index) {
+        historyJournal.recordRemoved(index, deletedTimers);
+    });
+
     connect(&dialog, &HistoryTimerWindow::restoreTimer, this, [this](const TimerData &t) {
         emit addTimerRequested(t.name, t.duration, t.type, t.groupName);
-        saveHistoryJson();
         updateTable();
     });
 
-    connect(&dialog, &HistoryTimerWindow::historyChanged, this, [this]() {
-        saveHistoryJson();
-    });
-
     dialog.exec();
 }
 
@@ -262,7 +253,7 @@ void TimerWindow::onStartPauseTimer()
 
     QList<int> rows;
     for (const auto &item : selectedItems)
-        rows << item.row();
+        rows << tableModel->timerIndex(item.row());
     emit startPauseRequested(rows);
 }
 
@@ -280,18 +271,22 @@ void TimerWindow::onDeleteTimer()
         return;
 
     QList<int> rows;
-    for (auto &i : selected) rows << i.row();
+    for (auto &i : selected) rows << tableModel->timerIndex(i.row());
     std::sort(rows.begin(), rows.end(), std::greater<int>());
 
-    auto timers = manager->getTimers();
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QList<TimerData> moved;
     for (int r : rows) {
-        if (r >= 0 && r < timers.size()) {
-            deletedTimers.append(timers[r]);
+        if (r >= 0 && r < manager->timerCount()) {
+            TimerData t = manager->timerAt(r);
+            t.remaining = manager->remainingSeconds(r, nowMs);
+            moved.append(t);
         }
     }
+    deletedTimers.append(moved);
     emit deleteTimersRequested(rows);
 
-    saveHistoryJson();
+    historyJournal.recordAdded(moved, deletedTimers);
     updateTable();
 
     QMessageBox::information(this, "Deleted",
@@ -300,17 +295,16 @@ void TimerWindow::onDeleteTimer()
 
 void TimerWindow::onEditTimer()
 {
-    int row = ui->tableTimers->currentRow();
+    int row = tableModel->timerIndex(ui->tableTimers->currentIndex().row());
     if (row < 0) {
         QMessageBox::warning(this, "No selection", "Select a timer to edit.");
         return;
     }
 
-    QList<TimerData> timers = manager->getTimers();
-    if (row >= timers.size())
+    if (row >= manager->timerCount())
         return;
 
-    const TimerData &t = timers[row];
+    const TimerData t = manager->timerAt(row);
     TimerEditDialog dialog(this);
 
     dialog.findChild<QLineEdit*>("nameEdit")->setText(t.name);
@@ -342,101 +336,60 @@ void TimerWindow::onEditTimer()
 
 void TimerWindow::updateTable()
 {
-    QString filter = ui->comboBox ? ui->comboBox->currentText() : "All timers";
-
-    QList<TimerData> timers;
-    if (filter != "All timers")
-        timers = manager->getFilteredTimers(filter);
-    else
-        timers = manager->getTimers();
-
-    ui->tableTimers->setRowCount(timers.size());
-
-    for (int i = 0; i < timers.size(); ++i) {
-        const TimerData &t = timers[i];
-
-        int hours = t.remaining / 3600;
-        int minutes = (t.remaining % 3600) / 60;
-        int seconds = t.remaining % 60;
-        QString remainingStr = QString("%1:%2:%3")
-                                   .arg(hours, 2, 10, QChar('0'))
-                                   .arg(minutes, 2, 10, QChar('0'))
-                                   .arg(seconds, 2, 10, QChar('0'));
-
-        QString statusText;
-        switch (t.status) {
-        case TimerStatus::Running:
-            statusText = "Running";
-            break;
-        case TimerStatus::Paused:
-            statusText = "Paused";
-            break;
-        case TimerStatus::Finished:
-            statusText = "Finished";
-            break;
-        }
-
-        ui->tableTimers->setItem(i, 0, new QTableWidgetItem(t.name));
-        ui->tableTimers->setItem(i, 1, new QTableWidgetItem(remainingStr));
-        ui->tableTimers->setItem(i, 2, new QTableWidgetItem(statusText));
-        ui->tableTimers->setItem(i, 3, new QTableWidgetItem(t.type));
+    tableModel->setStatusFilter(ui->comboBox ? ui->comboBox->currentText() : "All timers");
+    tableModel->refresh();
+    updateGroups();
+}
 
-        if (t.status == TimerStatus::Finished) {
-            for (int col = 0; col < 3; ++col) {
-                ui->tableTimers->item(i, col)->setBackground(QColor(220, 220, 220));
-                ui->tableTimers->item(i, col)->setForeground(QBrush(Qt::darkGray));
-            }
-        }
-    }
-    ui->comboGroups->clear();
+void TimerWindow::updateGroups()
+{
     QStringList groups;
-    for (const auto &t : manager->getTimers()) {
+    for (const auto &t : manager->timerList()) {
         if (!groups.contains(t.groupName))
             groups << t.groupName;
     }
+    QStringList shown;
+    for (int i = 0; i < ui->comboGroups->count(); ++i)
+        shown << ui->comboGroups->itemText(i);
+    if (shown == groups)
+        return;
+
+    ui->comboGroups->clear();
     ui->comboGroups->addItems(groups);
 }
 
-QString TimerWindow::historyFilePath() const
+void TimerWindow::onTimersUpdated()
 {
-    const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir().mkpath(base);
-    return base + "/history.json";
+    if (!ActivityManager::instance().isActive(this)) {
+        viewStale = true;
+        return;
+    }
+    updateNextUpLabel();
 }
 
-void TimerWindow::saveHistoryJson() const
+void TimerWindow::onTimersChanged(const QList<int> &indices)
 {
-    QJsonArray arr;
-    for (const auto &t : deletedTimers) {
-        QJsonObject o;
-        o["name"] = t.name;
-        o["duration"] = t.duration;
-        arr.append(o);
-    }
-    QFile f(historyFilePath());
-    if (f.open(QIODevice::WriteOnly)) {
-        f.write(QJsonDocument(arr).toJson(QJsonDocument::Compact));
-        f.close();
+    if (!indices.isEmpty())
+        return;
+    if (!ActivityManager::instance().isActive(this)) {
+        groupsStale = true;
+        return;
     }
+    updateGroups();
 }
 
-void TimerWindow::loadHistoryJson()
+void TimerWindow::onActiveChanged(QWidget *view, bool active)
 {
-    QFile f(historyFilePath());
-    if (!f.exists() || !f.open(QIODevice::ReadOnly)) return;
-
-    const auto doc = QJsonDocument::fromJson(f.readAll());
-    f.close();
-    if (!doc.isArray()) return;
-
-    deletedTimers.clear();
-    for (const auto &v : doc.array()) {
-        QJsonObject o = v.toObject();
-        TimerData t;
-        t.name = o["name"].toString();
-        t.duration = o["duration"].toInt();
-        t.remaining = t.duration;
-        deletedTimers.append(t);
+    if (view != this)
+        return;
+    tableModel->setPaused(!active);
+    if (active && groupsStale) {
+        groupsStale = false;
+        updateGroups();
+    }
+    if (active && viewStale) {
+        viewStale = false;
+        updateNextUpLabel();
     }
 }
 
@@ -449,13 +402,14 @@ void TimerWindow::closeEvent(QCloseEvent *event)
     settings.setValue("actionPath", actionPath);
 
     if (!continueAfterExit) {
-        QList<TimerData> timers = manager->getTimers();
-        for (int i = 0; i < timers.size(); ++i) {
-            manager->pauseTimer(i);
-        }
+        QList<int> all;
+        all.reserve(manager->timerCount());
+        for (int i = 0; i < manager->timerCount(); ++i)
+            all.append(i);
+        manager->pauseTimers(all);
     }
     emit saveRequested();
-    saveHistoryJson();
+    historyJournal.waitForIdle();
     event->accept();
 }
 
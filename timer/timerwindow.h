@@ -12,6 +12,8 @@
 #define TIMERWINDOW_H
 
 #include "timermanager.h"
+#include "timerhistoryjournal.h"
+#include "timertablemodel.h"
 #include "settingstimerdialog.h"
 #include "../controllers/timercontroller.h"
 #include <QWidget>
@@ -172,6 +174,13 @@ private slots:
  * @sa SmartClock
  */
     void updateTable();
+/**
+ * @brief Update groups.
+ * @details Refills the group combo box only when the set of groups changed.
+ * @note Validate inputs where applicable.
+ * @sa SmartClock
+ */
+    void updateGroups();
 /**
  * @brief Update next up label.
  * @details Performs the operation and updates state as needed.
@@ -179,47 +188,51 @@ private slots:
  * @sa SmartClock
  */
     void updateNextUpLabel();
-
-private:
-    Ui::TimerWindow *ui;
-    TimerManager *manager;
-    TimerController *controller;
-    bool playSound = true; /**< Internal state value. */
-    bool runAction = false; /**< Internal state value. */
-    QString actionPath; /**< Filesystem path. */
 /**
- * @brief Populate history table.
- * @details Performs the operation and updates state as needed.
+ * @brief On timers updated.
+ * @details Refreshes the next-up label, or marks it stale while the view is inactive.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    void populateHistoryTable();
+    void onTimersUpdated();
 /**
- * @brief Save history json.
- * @details Writes current state to persistent storage.
- * @return True on success; false on failure.
+ * @brief On timers changed.
+ * @details Refreshes the group list after structural changes only; ticks cannot change group membership.
+ * @param indices Changed timer indices; empty for added, removed or replaced timers.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    void saveHistoryJson() const;
+    void onTimersChanged(const QList<int> &indices);
 /**
- * @brief Load history json.
- * @details Reads persisted state into the object.
- * @return True on success; false on failure.
+ * @brief On active changed.
+ * @details Pauses view refreshes while the tab is hidden and catches up when it is shown again.
+ * @param view View whose state changed.
+ * @param active True if the view is on screen.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    void loadHistoryJson();
+    void onActiveChanged(QWidget *view, bool active);
+
+private:
+    Ui::TimerWindow *ui;
+    TimerManager *manager;
+    TimerTableModel *tableModel; /**< Model behind tableTimers. */
+    TimerController *controller;
+    bool playSound = true; /**< Internal state value. */
+    bool runAction = false; /**< Internal state value. */
+    QString actionPath; /**< Filesystem path. */
 /**
- * @brief History file path.
+ * @brief Populate history table.
  * @details Performs the operation and updates state as needed.
- * @return Formatted string value.
  * @note Validate inputs where applicable.
  * @sa SmartClock
  */
-    QString historyFilePath() const;
+    void populateHistoryTable();
     QList<TimerData> deletedTimers; /**< Timer-related state. */
+    TimerHistoryJournal historyJournal; /**< Append-only persistence for deletedTimers. */
     bool continueAfterExit = false; /**< Internal state value. */
+    bool viewStale = false; /**< True if timers changed while the view was inactive. */
+    bool groupsStale = false; /**< True if timers were added or removed while the view was inactive. */
 };
 
 #endif // TIMERWINDOW_H